@@ -22,8 +22,8 @@ int main(int argc, char **argv) {
         for (int i = 1; i < argc; i++) {
             if (strcmp(argv[i], "-h") == 0) {
                 // Show help message
-                std::cout << "./benchmark [-h] [-c <perspective/orthographic>] [-a <cdt/ts/wn/sdf>] [-f path_to_font] "
-                             "[-t] [-m]"
+                std::cout << "./benchmark [-h] [-c <perspective/orthographic>] [-a <cdt/ts/wn/lb/sdf>] "
+                             "[-f path_to_font] [-t] [-m]"
                           << std::endl;
                 std::cout << "-h: Show help message" << std::endl;
                 std::cout << "-c: Select the type of camera used" << std::endl;
@@ -32,6 +32,8 @@ int main(int argc, char **argv) {
                 std::cout << "  ts - Outer triangles processed by tessellation shaders, inner triangulated on the cpu"
                           << std::endl;
                 std::cout << "  wn - Winding number calculated in fragment shader" << std::endl;
+                std::cout << "  lb - Curve triangles filled in fragment shader, inner triangulated on the cpu"
+                          << std::endl;
                 std::cout << "  sdf - Signed distance field" << std::endl;
                 std::cout << "-f: Path to .ttf font file" << std::endl;
                 std::cout << "-t: Measure the gpu draw time" << std::endl;
@@ -57,12 +59,14 @@ int main(int argc, char **argv) {
                     tessellationAlgorithm = vft::TessellationStrategy::TRIANGULATION;
                 } else if (type == "wn") {
                     tessellationAlgorithm = vft::TessellationStrategy::WINDING_NUMBER;
+                } else if (type == "lb") {
+                    tessellationAlgorithm = vft::TessellationStrategy::LOOP_BLINN;
                 } else if (type == "ts") {
                     tessellationAlgorithm = vft::TessellationStrategy::TESSELLATION_SHADERS;
                 } else if (type == "sdf") {
                     tessellationAlgorithm = vft::TessellationStrategy::SDF;
                 } else {
-                    std::cerr << "Tessellation algorithm must be cdt, ts, wn or sdf" << std::endl;
+                    std::cerr << "Tessellation algorithm must be cdt, ts, wn, lb or sdf" << std::endl;
                     return EXIT_FAILURE;
                 }
             } else if (strcmp(argv[i], "-f") == 0) {
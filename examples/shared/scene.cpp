@@ -65,6 +65,10 @@ Scene::Scene(CameraType cameraType, vft::TessellationStrategy tessellationAlgori
             renderer = new vft::VulkanWindingNumberTextRenderer(
                 this->_physicalDevice, this->_logicalDevice, this->_graphicsQueue, this->_commandPool,
                 this->_renderPass, this->_msaaSampleCount, this->_commandBuffer);
+        } else if (tessellationAlgorithm == vft::TessellationStrategy::LOOP_BLINN) {
+            renderer = new vft::VulkanLoopBlinnTextRenderer(
+                this->_physicalDevice, this->_logicalDevice, this->_graphicsQueue, this->_commandPool,
+                this->_renderPass, this->_msaaSampleCount, this->_commandBuffer);
         } else {
             renderer = new vft::VulkanSdfTextRenderer(this->_physicalDevice, this->_logicalDevice, this->_graphicsQueue,
                                                       this->_commandPool, this->_renderPass, this->_msaaSampleCount,
@@ -85,6 +89,10 @@ Scene::Scene(CameraType cameraType, vft::TessellationStrategy tessellationAlgori
             this->_renderer = std::make_shared<vft::VulkanWindingNumberTextRenderer>(
                 this->_physicalDevice, this->_logicalDevice, this->_graphicsQueue, this->_commandPool,
                 this->_renderPass, this->_msaaSampleCount, this->_commandBuffer);
+        } else if (tessellationAlgorithm == vft::TessellationStrategy::LOOP_BLINN) {
+            this->_renderer = std::make_shared<vft::VulkanLoopBlinnTextRenderer>(
+                this->_physicalDevice, this->_logicalDevice, this->_graphicsQueue, this->_commandPool,
+                this->_renderPass, this->_msaaSampleCount, this->_commandBuffer);
         } else {
             this->_renderer = std::make_shared<vft::VulkanSdfTextRenderer>(
                 this->_physicalDevice, this->_logicalDevice, this->_graphicsQueue, this->_commandPool,
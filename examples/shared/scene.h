@@ -28,6 +28,7 @@
 #include <VFONT/i_vulkan_text_renderer.h>
 #include <VFONT/text_block.h>
 #include <VFONT/text_renderer.h>
+#include <VFONT/vulkan_loop_blinn_text_renderer.h>
 #include <VFONT/vulkan_sdf_text_renderer.h>
 #include <VFONT/vulkan_tessellation_shaders_text_renderer.h>
 #include <VFONT/vulkan_text_renderer.h>
@@ -0,0 +1,65 @@
+/**
+ * @file edge_broad_phase.h
+ * @author Christian Saloň
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "edge.h"
+#include "edge_pool.h"
+
+namespace vft {
+
+/**
+ * @brief Sweep-line broad phase of edge intersection tests
+ *
+ * Bounding boxes of edges are sorted by their left side, so edges whose bounding boxes overlap a given box are found
+ * by a binary search and a scan of the slab that can contain them. Exact intersection tests are then performed only
+ * for these candidates. Candidates store positions of edges in loops, so the broad phase must be built again whenever
+ * edges of loops are inserted or deleted
+ */
+class EdgeBroadPhase {
+public:
+    /**
+     * @brief Edge whose bounding box overlaps the queried box
+     */
+    struct Candidate {
+        unsigned int loopIndex; /**< Index of loop containing edge in the list of queried loops */
+        unsigned int edgeIndex; /**< Position of edge in loop */
+        uint32_t edge;          /**< Index of edge in edge pool */
+
+        bool operator<(const Candidate &other) const;
+    };
+
+protected:
+    /**
+     * @brief Bounding box of one edge
+     */
+    struct Bounds {
+        glm::vec2 min;       /**< Bottom left corner */
+        glm::vec2 max;       /**< Top right corner */
+        Candidate candidate; /**< Edge */
+    };
+
+    double _tolerance{0};          /**< Distance by which bounding boxes can be apart and still overlap */
+    std::vector<Bounds> _bounds{}; /**< Bounding boxes of all edges sorted by their left side */
+    float _maxWidth{0};            /**< Width of the widest bounding box */
+
+public:
+    EdgeBroadPhase(double tolerance = 0);
+    ~EdgeBroadPhase() = default;
+
+    void build(const std::vector<glm::vec2> &vertices, const EdgePool &edges, const std::vector<uint32_t> &loops);
+    std::vector<Candidate> query(const glm::vec2 &start, const glm::vec2 &end) const;
+    std::vector<std::pair<Candidate, Candidate>> getOverlappingPairs() const;
+};
+
+}  // namespace vft
@@ -0,0 +1,87 @@
+/**
+ * @file edge_pool.h
+ * @author Christian Saloň
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include "edge.h"
+#include "outline.h"
+
+namespace vft {
+
+/**
+ * @brief Closed loops of edges stored in one contiguous arena
+ *
+ * Edges of a loop form a circular doubly linked list whose links are indices into the arena, so edges are inserted
+ * and deleted without allocating nodes and all loops are released at once. Edges starting at each vertex are linked
+ * together as well, so outgoing edges of a vertex are found without scanning loops. Start vertex of an edge must not be
+ * changed after the edge is inserted
+ */
+class EdgePool {
+public:
+    /** Index of missing edge or loop */
+    static constexpr uint32_t NONE = std::numeric_limits<uint32_t>::max();
+
+    /**
+     * @brief Edge of a loop
+     */
+    struct Node {
+        Edge value;            /**< Edge */
+        uint32_t previous;     /**< Index of previous edge in loop */
+        uint32_t next;         /**< Index of next edge in loop */
+        uint32_t loop;         /**< Index of loop containing edge, NONE if edge was deleted */
+        uint32_t nextOutgoing; /**< Index of next edge starting at the same vertex */
+    };
+
+protected:
+    /**
+     * @brief Circular list of edges
+     */
+    struct Loop {
+        uint32_t first{NONE}; /**< Index of first edge */
+        unsigned int size{0}; /**< Number of edges */
+    };
+
+    std::vector<Node> _nodes{};        /**< Edges of all loops */
+    std::vector<Loop> _loops{};        /**< All loops */
+    std::vector<uint32_t> _outgoing{}; /**< Index of one edge starting at each vertex */
+
+public:
+    EdgePool() = default;
+    ~EdgePool() = default;
+
+    void clear();
+
+    uint32_t addLoop();
+    uint32_t addLoop(const Outline &outline);
+    void clearLoop(uint32_t loop);
+
+    uint32_t insertLast(uint32_t loop, const Edge &value);
+    uint32_t insertAfter(uint32_t node, const Edge &value);
+    void erase(uint32_t node);
+
+    Node &operator[](uint32_t node);
+    const Node &operator[](uint32_t node) const;
+
+    uint32_t getFirst(uint32_t loop) const;
+    unsigned int getSize(uint32_t loop) const;
+    unsigned int getLoopCount() const;
+    unsigned int getPosition(uint32_t node) const;
+    Outline getOutline(uint32_t loop, Outline::Orientation orientation) const;
+
+    std::vector<uint32_t> getEdgesStartingAt(uint32_t vertex) const;
+    unsigned int getEdgeCountStartingAt(uint32_t vertex, uint32_t loop) const;
+
+protected:
+    uint32_t _createNode(const Edge &value, uint32_t loop);
+    void _linkOutgoing(uint32_t node);
+    void _unlinkOutgoing(uint32_t node);
+};
+
+}  // namespace vft
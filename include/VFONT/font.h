@@ -6,8 +6,15 @@
 #pragma once
 
 #include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
 #include <stdexcept>
 #include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
 
 #include <ft2build.h>
 #include FT_FREETYPE_H
@@ -17,17 +24,61 @@ namespace vft {
 
 /**
  * @brief Represents a freetype font
+ *
+ * Freetype faces are not thread safe. The face returned by getFace() is only read after construction (metrics, family
+ * name), every operation that changes the state of a face (loading glyphs, setting pixel sizes, rasterizing) must be
+ * done on the face returned by getThreadFace(), which is owned by the calling thread and released when it exits.
  */
 class Font {
 protected:
+    /**
+     * @brief Freetype library and font face owned by one thread
+     */
+    struct ThreadFace {
+        FT_Library library{nullptr}; /**< Freetype library of thread */
+        FT_Face face{nullptr};       /**< Freetype font face of thread */
+    };
+
+    /**
+     * @brief Faces created for threads using a font. Shared with the threads, so a thread can release its face on exit
+     * even if the font was destroyed in the meantime
+     */
+    struct ThreadFaces {
+        std::shared_mutex mutex{};                               /**< Guards hash map of faces */
+        std::unordered_map<std::thread::id, ThreadFace> faces{}; /**< Faces of threads (key: thread id) */
+    };
+
+    /**
+     * @brief Thread local owner of faces of one thread, releases them in all fonts used by the thread when it exits
+     */
+    struct ThreadFaceOwner {
+        std::vector<std::weak_ptr<ThreadFaces>> fonts{}; /**< Faces of fonts in which the thread created a face */
+
+        ~ThreadFaceOwner();
+    };
+
     FT_Library _ft{nullptr}; /**< Freetype library */
     FT_Face _face{nullptr};  /**< Freetype font face */
 
+    std::string _fontFile{};   /**< Path to font file, empty if font was loaded from memory */
+    uint8_t *_buffer{nullptr}; /**< Memory where the font is stored, nullptr if font was loaded from file */
+    long _bufferSize{0};       /**< Size of memory where the font is stored */
+
     unsigned int _pixelSize{64}; /**< Font size in pixels */
 
+    mutable std::once_flag _contentHashFlag{}; /**< Ensures the content hash is computed only once */
+    mutable uint64_t _contentHash{0};          /**< Hash of font file contents */
+
+    /** Faces created for threads using this font */
+    std::shared_ptr<ThreadFaces> _threadFaces{std::make_shared<ThreadFaces>()};
+
 public:
     Font(std::string fontFile);
     Font(uint8_t *buffer, long size);
+    ~Font();
+
+    Font(const Font &) = delete;
+    Font &operator=(const Font &) = delete;
 
     void setPixelSize(unsigned int pixelSize);
 
@@ -35,6 +86,12 @@ public:
     unsigned int getPixelSize() const;
     std::string getFontFamily() const;
     FT_Face getFace() const;
+    FT_Face getThreadFace() const;
+    uint64_t getContentHash() const;
+
+protected:
+    void _createFace(FT_Library &library, FT_Face &face) const;
+    static void _releaseFace(ThreadFace &threadFace);
 };
 
 }  // namespace vft
@@ -5,16 +5,29 @@
 
 #pragma once
 
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cmath>
 #include <cstdint>
+#include <exception>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <stdexcept>
+#include <thread>
 #include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
 
 #include <glm/vec2.hpp>
 
 #include "font.h"
 #include "glyph.h"
 #include "glyph_mesh.h"
+#include "msdf_generator.h"
+#include "skyline_packer.h"
 
 namespace vft {
 
@@ -23,6 +36,24 @@ namespace vft {
  */
 class FontAtlas {
 public:
+    /** Size in pixels of em square used when rasterizing glyphs using the freetype sdf rasterizer */
+    static constexpr unsigned int SDF_GLYPH_SIZE = 64;
+    /** Distance in pixels of SDF_GLYPH_SIZE encoded by freetype sdfs, it is also the padding around glyphs */
+    static constexpr unsigned int SDF_SPREAD = 8;
+    /**
+     * Min number of glyphs rasterized by one thread, small batches (e.g. glyphs added on demand) are rasterized by the
+     * calling thread, so no thread has to load its own freetype face
+     */
+    static constexpr unsigned int MIN_GLYPHS_PER_THREAD = 32;
+
+    /**
+     * @brief Type of distance field stored in font atlas
+     */
+    enum class Type {
+        SDF, /**< Single-channel signed distance field rasterized by freetype */
+        MSDF /**< Multi-channel signed distance field preserving sharp corners at lower resolutions */
+    };
+
     /**
      * @brief Range of unicode characters
      */
@@ -44,6 +75,22 @@ public:
         glm::vec2 uvBottomRight; /**< UV of bottom right corner of glyph */
     };
 
+    /**
+     * @brief Rectangle of texture
+     */
+    struct Region {
+        glm::uvec2 position; /**< Position of top left corner in pixels */
+        glm::uvec2 size;     /**< Size in pixels */
+    };
+
+    /**
+     * @brief Glyph bitmap added after the texture was released, it waits until it is uploaded to the gpu
+     */
+    struct Upload {
+        Region region;               /**< Rectangle of texture containing the bitmap */
+        std::vector<uint8_t> pixels; /**< Bytes of bitmap including all channels */
+    };
+
     struct BitmapInfo {
         uint32_t glyphId;
         unsigned int width;
@@ -62,31 +109,80 @@ public:
     };
 
 protected:
-    std::string _fontFamily{};  /**< Font family of font atlas */
-    unsigned int _width{1024};  /**< Width of font atlas */
-    unsigned int _height{1024}; /**< Height of font atlas */
-
-    std::vector<uint8_t> _texture{}; /**< Texture containing sdfs of selected glyphs */
+    std::string _fontFamily{};    /**< Font family of font atlas */
+    Type _type{Type::SDF};        /**< Type of distance field stored in font atlas */
+    unsigned int _fontSize{0};    /**< Size in pixels of em square of msdfs */
+    unsigned int _threadCount{0}; /**< Number of threads rasterizing glyphs, 0 uses all hardware threads */
+    unsigned int _padding{0};     /**< Number of empty pixels around each glyph bitmap */
+    unsigned int _width{1024};    /**< Width of font atlas */
+    unsigned int _height{1024};   /**< Height of font atlas */
+    uint64_t _usedArea{0};        /**< Area of texture covered by glyph bitmaps */
+    SkylinePacker _packer{0};     /**< Packer of glyph bitmaps, it is kept to pack glyphs added later */
+
+    std::vector<uint8_t> _texture{};       /**< Texture containing sdfs of selected glyphs */
+    bool _isTextureReleased{false};        /**< Indicates that texture was released after upload to the gpu */
+    std::vector<Upload> _pendingUploads{}; /**< Glyph bitmaps added after the texture was released */
     /**
-     * Hash map containing UVs of selected glyphs stored in texture (key: glyphId, value: UV).
+     * Hash map containing rectangles of selected glyphs stored in texture (key: glyphId, value: rectangle).
      * Because new lines have glyphId 0, we need to make sure we insert a default record with glyphId 0
      */
-    std::unordered_map<uint32_t, GlyphInfo> _glyphs{{0, GlyphInfo{glm::vec2{0, 0}, glm::vec2{0, 0}}}};
+    std::unordered_map<uint32_t, Region> _glyphs{{0, Region{glm::uvec2{0, 0}, glm::uvec2{0, 0}}}};
 
 public:
-    FontAtlas(std::shared_ptr<Font> font, unsigned int fontSize, std::vector<uint32_t> glyphIds);
-    FontAtlas(std::shared_ptr<Font> font, unsigned int fontSize, std::vector<CharacterRange> characterRanges);
-    FontAtlas(std::shared_ptr<Font> font, unsigned int fontSize, std::u32string characters);
-    FontAtlas(std::shared_ptr<Font> font, unsigned int fontSize);
+    FontAtlas(std::shared_ptr<Font> font,
+              unsigned int fontSize,
+              std::vector<uint32_t> glyphIds,
+              Type type = Type::SDF,
+              unsigned int threadCount = 0,
+              unsigned int padding = 0);
+    FontAtlas(std::shared_ptr<Font> font,
+              unsigned int fontSize,
+              std::vector<CharacterRange> characterRanges,
+              Type type = Type::SDF,
+              unsigned int threadCount = 0,
+              unsigned int padding = 0);
+    FontAtlas(std::shared_ptr<Font> font,
+              unsigned int fontSize,
+              std::u32string characters,
+              Type type = Type::SDF,
+              unsigned int threadCount = 0,
+              unsigned int padding = 0);
+    FontAtlas(std::shared_ptr<Font> font,
+              unsigned int fontSize,
+              Type type = Type::SDF,
+              unsigned int threadCount = 0,
+              unsigned int padding = 0);
     ~FontAtlas() = default;
 
+    void addGlyphs(std::shared_ptr<Font> font, std::vector<uint32_t> glyphIds);
+    bool contains(uint32_t glyphId) const;
     GlyphInfo getGlyph(uint32_t glyphId) const;
 
     std::string getFontFamily() const;
+    Type getType() const;
+    unsigned int getChannelCount() const;
     glm::uvec2 getSize() const;
+    double getOccupancy() const;
     const std::vector<uint8_t> &getTexture() const;
 
+    void releaseTexture();
+    bool isTextureReleased() const;
+    const std::vector<Upload> &getPendingUploads() const;
+    void clearPendingUploads();
+
 protected:
+    std::vector<std::pair<BitmapInfo, std::vector<uint8_t>>> _rasterizeGlyphs(std::shared_ptr<Font> font,
+                                                                              unsigned int fontSize,
+                                                                              const std::vector<uint32_t> &glyphIds,
+                                                                              unsigned int threadCount) const;
+    std::vector<glm::uvec2> _packBitmaps(const std::vector<std::pair<BitmapInfo, std::vector<uint8_t>>> &bitmaps);
+    static std::vector<std::size_t> _getPackingOrder(
+        const std::vector<std::pair<BitmapInfo, std::vector<uint8_t>>> &bitmaps);
+    void _storeBitmap(const BitmapInfo &info, std::vector<uint8_t> &bitmap, const glm::uvec2 &position);
+    void _resize(unsigned int width, unsigned int height);
+    BitmapInfo _rasterizeSdf(FT_Face face, uint32_t glyphId, std::vector<uint8_t> &bitmap) const;
+    BitmapInfo _rasterizeMsdf(FT_Face face, uint32_t glyphId, unsigned int size, std::vector<uint8_t> &bitmap) const;
+
     std::vector<uint32_t> _getAllGlyphIds(std::shared_ptr<Font> font) const;
     std::vector<uint32_t> _getRangesGlyphIds(std::shared_ptr<Font> font,
                                              std::vector<CharacterRange> characterRanges) const;
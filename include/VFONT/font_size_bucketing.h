@@ -0,0 +1,39 @@
+/**
+ * @file font_size_bucketing.h
+ * @author Christian Saloň
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace vft {
+
+/**
+ * @brief Groups font sizes into buckets whose sizes grow geometrically, so glyphs composed for the upper bound of a
+ * bucket can be reused for all font sizes in the bucket
+ *
+ * Glyph meshes are stored in font units and curves are flattened within a fixed pixel tolerance at the font size they
+ * were composed for. A mesh composed for the upper bound of a bucket is therefore rendered with at most that flattening
+ * error (scaled down by fontSize / bucketSize) for every font size in the bucket, at the cost of at most sqrt(ratio)
+ * times more curve vertices than needed
+ */
+class FontSizeBucketing {
+public:
+    /** Ratio of power-of-square-root-of-two buckets (e.g. 8, 12, 16, 23, 32, 46, 64) */
+    static constexpr double SQRT_2_RATIO = 1.4142135623730951;
+
+protected:
+    double _ratio{1}; /**< Ratio between upper bounds of neighbouring buckets, 1 disables bucketing */
+
+public:
+    FontSizeBucketing(double ratio = 1);
+    ~FontSizeBucketing() = default;
+
+    unsigned int getBucketFontSize(unsigned int fontSize) const;
+    double getRatio() const;
+};
+
+}  // namespace vft
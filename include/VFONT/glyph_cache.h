@@ -6,15 +6,29 @@
 #pragma once
 
 #include <algorithm>
+#include <atomic>
 #include <climits>
+#include <cstddef>
 #include <cstdint>
 #include <functional>
+#include <future>
 #include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
 #include <stdexcept>
 #include <string>
+#include <thread>
 #include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
+#include "font.h"
 #include "glyph.h"
+#include "glyph_disk_cache.h"
+#include "tessellator.h"
+#include "thread_pool.h"
 
 namespace vft {
 
@@ -45,31 +59,120 @@ struct GlyphKeyHash {
 };
 
 /**
- * @brief LRU cache for glyphs
+ * @brief Thread safe LRU cache for glyphs
+ *
+ * Glyphs are distributed into shards by their key, each shard has its own lock. Lookups take only a shared lock and
+ * mark the glyph as referenced, the LRU order is updated lazily during eviction (referenced glyphs get a second
+ * chance). Glyphs are evicted when the number of glyphs or the memory used by glyphs in the whole cache exceeds the
+ * limits set by setMaxSize() and setMaxBytes(). The shard of an inserted glyph evicts its own glyphs first, then
+ * glyphs of other shards. Optionally, glyphs missing in memory are looked up in a persistent disk cache before they are
+ * composed
  */
 class GlyphCache {
-private:
-    unsigned long _maxSize{ULONG_MAX}; /**< Maximum size of cache */
+public:
+    /** Number of shards used when not specified */
+    static constexpr unsigned int DEFAULT_SHARD_COUNT = 16;
+
+    /**
+     * @brief Statistics of cache usage, counters are updated only when enabled by setStatsEnabled()
+     */
+    struct Stats {
+        uint64_t hits{0};         /**< Number of lookups that found the glyph in memory */
+        uint64_t misses{0};       /**< Number of lookups that did not find the glyph in memory */
+        uint64_t diskLoads{0};    /**< Number of missing glyphs loaded from disk cache */
+        uint64_t evictions{0};    /**< Number of glyphs evicted because the cache exceeded its limits */
+        unsigned long size{0};    /**< Number of glyphs in cache */
+        std::size_t byteSize{0};  /**< Memory used by glyphs in cache in bytes */
+        unsigned long maxSize{0}; /**< Maximum number of glyphs in cache */
+        std::size_t maxBytes{0};  /**< Maximum memory used by glyphs in cache in bytes */
+    };
+
+protected:
+    /**
+     * @brief Glyph stored in cache with its position in the LRU list
+     */
+    struct CacheEntry {
+        std::shared_ptr<const Glyph> glyph;          /**< Cached glyph */
+        std::size_t byteSize;                        /**< Memory used by glyph in bytes */
+        std::list<const GlyphKey *>::iterator usage; /**< Position of glyph in the list of used glyphs */
+        mutable std::atomic<bool> referenced{true};  /**< True if glyph was read since last eviction pass */
+
+        CacheEntry(std::shared_ptr<const Glyph> glyph, std::size_t byteSize)
+            : glyph{std::move(glyph)}, byteSize{byteSize} {}
+    };
+
+    /**
+     * @brief Part of cache guarded by its own lock
+     */
+    struct Shard {
+        mutable std::shared_mutex mutex{}; /**< Guards all members of shard */
+        std::size_t byteSize{0};           /**< Memory used by glyphs in shard in bytes */
 
-    std::unordered_map<GlyphKey, Glyph, GlyphKeyHash> _cache{}; /**< Hash map used to store glyphs */
-    std::list<GlyphKey> _used{}; /**< Linked list of glyphs in cache ordered by most recently used glyph */
+        std::unordered_map<GlyphKey, CacheEntry, GlyphKeyHash> glyphs{}; /**< Hash map used to store glyphs */
+        /**
+         * Linked list of glyphs in shard ordered by most recently used glyph. Points to keys stored in hash map, which
+         * stay valid until the glyph is erased
+         */
+        std::list<const GlyphKey *> used{};
+        /** Glyphs that are being composed by some thread (key: glyph key, value: future composed glyph) */
+        std::unordered_map<GlyphKey, std::shared_future<std::shared_ptr<const Glyph>>, GlyphKeyHash> pending{};
+    };
+
+    std::atomic<unsigned long> _maxSize{ULONG_MAX}; /**< Maximum number of glyphs in cache */
+    std::atomic<std::size_t> _maxBytes{SIZE_MAX};   /**< Maximum memory used by glyphs in cache in bytes */
+    std::atomic<unsigned long> _size{0};            /**< Number of glyphs in all shards */
+    std::atomic<std::size_t> _byteSize{0};          /**< Memory used by glyphs in all shards in bytes */
+
+    std::vector<std::unique_ptr<Shard>> _shards{};       /**< Shards of cache */
+    std::shared_ptr<GlyphDiskCache> _diskCache{nullptr}; /**< Persistent cache consulted on a miss, can be nullptr */
+
+    std::atomic<bool> _statsEnabled{false};      /**< Indicates whether statistics are collected */
+    mutable std::atomic<uint64_t> _hits{0};      /**< Number of lookups that found the glyph in memory */
+    mutable std::atomic<uint64_t> _misses{0};    /**< Number of lookups that did not find the glyph in memory */
+    mutable std::atomic<uint64_t> _diskLoads{0}; /**< Number of missing glyphs loaded from disk cache */
+    mutable std::atomic<uint64_t> _evictions{0}; /**< Number of evicted glyphs */
 
 public:
-    GlyphCache(unsigned long maxSize);
+    GlyphCache(unsigned long maxSize, unsigned int shardCount = DEFAULT_SHARD_COUNT);
     GlyphCache();
     ~GlyphCache() = default;
 
     void setGlyph(GlyphKey key, Glyph glyph);
-    const Glyph &getGlyph(GlyphKey key);
+    std::shared_ptr<const Glyph> getGlyph(GlyphKey key) const;
+    std::shared_ptr<const Glyph> findGlyph(GlyphKey key) const;
+    std::shared_ptr<const Glyph> getOrComposeGlyph(GlyphKey key,
+                                                   const std::function<Glyph()> &compose,
+                                                   std::optional<GlyphDiskCache::Key> diskKey = std::nullopt);
+    unsigned int prewarm(std::shared_ptr<Font> font,
+                         std::vector<GlyphKey> keys,
+                         const Tessellator &tessellator,
+                         unsigned int threadCount = 0,
+                         std::function<void(unsigned int, unsigned int)> onProgress = nullptr);
     bool exists(GlyphKey key) const;
+    bool isPending(GlyphKey key) const;
 
     void clearGlyph(GlyphKey key);
     void clearAll();
     void setMaxSize(unsigned long maxSize);
+    void setMaxBytes(std::size_t maxBytes);
+    void setDiskCache(std::shared_ptr<GlyphDiskCache> diskCache);
+
+    unsigned long getSize() const;
+    std::size_t getByteSize() const;
+    std::shared_ptr<GlyphDiskCache> getDiskCache() const;
+
+    void setStatsEnabled(bool enabled);
+    Stats getStats() const;
+    void resetStats();
 
 protected:
-    void _eraseLRU();
-    void _updateToMRU(GlyphKey key);
+    Shard &_getShard(const GlyphKey &key) const;
+    void _insert(Shard &shard, const GlyphKey &key, std::shared_ptr<const Glyph> glyph);
+    void _eraseLRU(Shard &shard);
+    void _eraseOverBudget(Shard &shard);
+    void _eraseOverBudget(Shard &shard, std::size_t minSize);
+    bool _isOverBudget() const;
+    void _count(std::atomic<uint64_t> &counter) const;
 };
 
 }  // namespace vft
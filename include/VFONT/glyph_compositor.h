@@ -5,12 +5,14 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cstdint>
 #include <vector>
 
 #include <glm/vec2.hpp>
 
 #include "edge.h"
+#include "outline.h"
 
 namespace vft {
 
@@ -18,8 +20,32 @@ namespace vft {
  * @brief Composes a triangulated glyph from glyph outlines
  */
 class GlyphCompositor {
+protected:
+    /**
+     * @brief Working storage of ear clipping, one context is reused by all triangulations performed on one thread
+     */
+    struct EarClippingContext {
+        std::vector<uint32_t> previous{}; /**< Position of previous remaining vertex of contour */
+        std::vector<uint32_t> next{};     /**< Position of next remaining vertex of contour */
+        std::vector<uint32_t> visits{};   /**< Last contour visiting each vertex, finds contours touching themselves */
+        std::vector<uint32_t> contour{};  /**< Vertices of contour in order */
+        uint32_t contourId{0};            /**< Index of clipped contour, increases across all triangulations */
+    };
+
 public:
+    /** Max number of edges of contour triangulated by ear clipping, longer contours use constrained delaunay */
+    static constexpr std::size_t MAX_EAR_CLIPPING_EDGES = 64;
+
+    static std::vector<uint32_t> triangulate(std::vector<glm::vec2> &vertices, const std::vector<Outline> &polygon);
     static std::vector<uint32_t> triangulate(std::vector<glm::vec2> &vertices, std::vector<Edge> &edges);
+
+protected:
+    static bool _clipEars(const std::vector<glm::vec2> &vertices,
+                          const Outline &outline,
+                          EarClippingContext &context,
+                          std::vector<uint32_t> &indices);
+    static bool _isInTriangle(const glm::vec2 &point, const glm::vec2 &a, const glm::vec2 &b, const glm::vec2 &c);
+    static double _getSignedArea(const glm::vec2 &a, const glm::vec2 &b, const glm::vec2 &c);
 };
 
 }  // namespace vft
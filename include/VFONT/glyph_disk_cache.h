@@ -0,0 +1,107 @@
+/**
+ * @file glyph_disk_cache.h
+ * @author Christian Saloň
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include <glm/vec2.hpp>
+
+#include "curve.h"
+#include "edge.h"
+#include "glyph.h"
+#include "glyph_mesh.h"
+#include "tessellator.h"
+
+namespace vft {
+
+/**
+ * @brief Persistent cache of composed glyphs stored in a directory on disk
+ *
+ * Every glyph is stored in its own binary file. The file starts with a fixed size header followed by the index buffer
+ * sizes, the vertex buffer and index buffers, all in native byte order and aligned to four bytes, so the file can be
+ * loaded with a single read (or memory mapped) without any parsing. Files with a different format version or key are
+ * ignored. Glyphs are written to a temporary file that is renamed afterwards, so several threads or processes can
+ * share the same directory.
+ */
+class GlyphDiskCache {
+public:
+    /** Version of the file format, files with a different version are treated as missing */
+    static constexpr uint32_t FORMAT_VERSION = 4;
+
+    /**
+     * @brief Identifies a glyph stored on disk
+     */
+    struct Key {
+        uint64_t fontHash;             /**< Hash of font contents */
+        uint32_t glyphId;              /**< Glyph id */
+        unsigned int fontSize;         /**< Font size of glyph, zero if glyph does not depend on font size */
+        TessellationStrategy strategy; /**< Algorithm used to compose glyph */
+        uint32_t variant{0};           /**< Tessellator settings used to compose glyph, see Tessellator::getVariant() */
+    };
+
+protected:
+    /**
+     * @brief Header at the start of every glyph file
+     */
+    struct FileHeader {
+        char magic[4];        /**< File signature, always "VFGM" */
+        uint32_t version;     /**< Format version */
+        uint64_t fontHash;    /**< Hash of font contents */
+        uint32_t glyphId;     /**< Glyph id */
+        uint32_t fontSize;    /**< Font size of glyph */
+        uint32_t strategy;    /**< Algorithm used to compose glyph */
+        uint32_t vertexCount; /**< Number of vertices */
+        int64_t width;        /**< Width of glyph */
+        int64_t height;       /**< Height of glyph */
+        int64_t bearingX;     /**< Bearing in the direction of x axis */
+        int64_t bearingY;     /**< Bearing in the direction of y axis */
+        int64_t advanceX;     /**< Advance in the direction of x axis */
+        int64_t advanceY;     /**< Advance in the direction of y axis */
+        uint32_t drawCount;   /**< Number of index buffers */
+        uint32_t variant;     /**< Tessellator settings used to compose glyph */
+    };
+
+    static_assert(std::is_trivially_copyable_v<FileHeader> && sizeof(FileHeader) % 8 == 0);
+    static_assert(std::is_trivially_copyable_v<glm::vec2> && sizeof(glm::vec2) == 2 * sizeof(float));
+    static_assert(std::is_trivially_copyable_v<Edge> && sizeof(Edge) == 2 * sizeof(uint32_t));
+    static_assert(std::is_trivially_copyable_v<Curve> && sizeof(Curve) == 3 * sizeof(uint32_t));
+
+    std::filesystem::path _directory{};             /**< Directory where glyph files are stored */
+    std::atomic<unsigned long> _tempFileCounter{0}; /**< Used to create unique names of temporary files */
+
+public:
+    GlyphDiskCache(std::filesystem::path directory);
+    ~GlyphDiskCache() = default;
+
+    std::optional<Glyph> load(const Key &key) const;
+    bool store(const Key &key, const Glyph &glyph);
+    void clear();
+
+    static std::vector<char> serialize(const Key &key, const Glyph &glyph);
+    static std::optional<Glyph> deserialize(const Key &key, const char *data, std::size_t size);
+
+    const std::filesystem::path &getDirectory() const;
+
+protected:
+    std::filesystem::path _getFilePath(const Key &key) const;
+};
+
+}  // namespace vft
@@ -5,8 +5,16 @@
 
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
 #include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
 #include <stdexcept>
+#include <string>
 #include <vector>
 
 #include <glm/vec2.hpp>
@@ -15,28 +23,58 @@ namespace vft {
 
 /**
  * @brief Stores vertex and index buffers used for rendering expressed in font units
+ *
+ * All buffers are stored in one allocation. Vertices are stored as 16-bit fixed-point numbers if all of them fit into
+ * the 16-bit range, otherwise as floats. The finest fraction of font unit in which all vertices fit is used, so the
+ * rounding error is below 1/32768 of the largest vertex coordinate. Indices are stored as 16-bit integers if all of
+ * them fit into the 16-bit range. Buffers are expanded to floats and 32-bit indices when they are read
  */
 class GlyphMesh {
+public:
+    /** Maximum number of index buffers in mesh */
+    static constexpr unsigned int MAX_DRAW_COUNT = 4;
+    /** Quantized vertices are stored in at most 1/2^MAX_VERTEX_SCALE_EXPONENT of font unit */
+    static constexpr unsigned int MAX_VERTEX_SCALE_EXPONENT = 8;
+
 protected:
-    std::vector<glm::vec2> _vertices{};            /**< Vertex buffer */
-    std::vector<std::vector<uint32_t>> _indices{}; /**< Index buffers */
+    std::unique_ptr<std::byte[]> _data{nullptr};              /**< Vertex buffer followed by all index buffers */
+    std::array<uint32_t, MAX_DRAW_COUNT + 1> _indexOffsets{}; /**< Offset of the first index of each index buffer */
+    uint32_t _vertexCount{0};                                 /**< Number of vertices */
+    uint8_t _drawCount{0};                                    /**< Number of index buffers */
+    bool _quantizedVertices{false};                           /**< True if vertices are stored as 16-bit integers */
+    uint8_t _vertexScaleExponent{0};                          /**< Vertices are stored in 1/2^exponent font units */
+    bool _shortIndices{false};                                /**< True if indices are stored as 16-bit integers */
 
 public:
-    GlyphMesh(std::vector<glm::vec2> vertices, std::vector<std::vector<uint32_t>> indices);
+    GlyphMesh(const std::vector<glm::vec2> &vertices, const std::vector<std::vector<uint32_t>> &indices);
     GlyphMesh();
+    GlyphMesh(const GlyphMesh &other);
+    GlyphMesh(GlyphMesh &&other) noexcept = default;
     ~GlyphMesh() = default;
 
-    void addVertex(glm::vec2 vertex);
-
-    void setVertices(std::vector<glm::vec2> vertices);
-    void setIndices(unsigned int drawIndex, std::vector<uint32_t> indices);
+    GlyphMesh &operator=(const GlyphMesh &other);
+    GlyphMesh &operator=(GlyphMesh &&other) noexcept = default;
 
-    const std::vector<glm::vec2> &getVertices() const;
-    const std::vector<uint32_t> &getIndices(unsigned int drawIndex) const;
+    glm::vec2 getVertex(uint32_t vertexIndex) const;
+    std::vector<glm::vec2> getVertices() const;
+    std::vector<uint32_t> getIndices(unsigned int drawIndex) const;
+    void appendVertices(std::vector<glm::vec2> &vertices) const;
+    void appendIndices(unsigned int drawIndex, std::vector<uint32_t> &indices, uint32_t offset = 0) const;
 
     uint32_t getVertexCount() const;
     uint32_t getIndexCount(unsigned int drawIndex) const;
     unsigned int getDrawCount() const;
+    bool hasQuantizedVertices() const;
+    float getVertexScale() const;
+    bool hasShortIndices() const;
+    std::size_t getMemorySize() const;
+
+protected:
+    std::size_t _getVertexSize() const;
+    std::size_t _getIndexSize() const;
+    std::size_t _getIndicesStart() const;
+    std::size_t _getDataSize() const;
+    uint32_t _getIndex(uint32_t index) const;
 };
 
 }  // namespace vft
@@ -0,0 +1,96 @@
+﻿/**
+ * @file glyph_pack.h
+ * @author Christian Saloň
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "font.h"
+#include "glyph.h"
+#include "glyph_cache.h"
+#include "glyph_disk_cache.h"
+#include "tessellator.h"
+
+namespace vft {
+
+/**
+ * @brief Precomposed glyphs of one font and tessellation strategy stored in a single file
+ *
+ * Packs are created offline (see the vfont-bake tool) and used to prefill the glyph cache at startup, so glyphs do not
+ * have to be composed before the first frame. The file contains a header, a table of glyphs sorted by font size and
+ * glyph id, and the glyph data in the format used by GlyphDiskCache, each glyph aligned to eight bytes.
+ */
+class GlyphPack {
+public:
+    /** Version of the file format, packs with a different version can not be loaded */
+    static constexpr uint32_t FORMAT_VERSION = 3;
+
+protected:
+    /**
+     * @brief Header at the start of pack file
+     */
+    struct PackHeader {
+        char magic[4];       /**< File signature, always "VFGP" */
+        uint32_t version;    /**< Format version */
+        uint64_t fontHash;   /**< Hash of font contents */
+        uint32_t strategy;   /**< Algorithm used to compose glyphs */
+        uint32_t glyphCount; /**< Number of glyphs in pack */
+        uint32_t variant;    /**< Tessellator settings used to compose glyphs */
+        uint32_t reserved;   /**< Padding, always zero */
+    };
+
+    /**
+     * @brief Position of glyph in pack
+     */
+    struct PackEntry {
+        uint32_t glyphId;  /**< Glyph id */
+        uint32_t fontSize; /**< Font size of glyph, zero if glyph does not depend on font size */
+        uint64_t offset;   /**< Offset of glyph data from the start of data section */
+        uint64_t size;     /**< Size of glyph data in bytes */
+    };
+
+    static_assert(std::is_trivially_copyable_v<PackHeader> && sizeof(PackHeader) % 8 == 0);
+    static_assert(std::is_trivially_copyable_v<PackEntry> && sizeof(PackEntry) % 8 == 0);
+
+    uint64_t _fontHash{0};                                               /**< Hash of font contents */
+    TessellationStrategy _strategy{TessellationStrategy::TRIANGULATION}; /**< Algorithm used to compose glyphs */
+    uint32_t _variant{0};                                                /**< Tessellator settings of glyphs */
+
+    mutable std::mutex _mutex{};       /**< Guards entries and data while glyphs are added */
+    std::vector<PackEntry> _entries{}; /**< Table of glyphs in pack */
+    std::vector<uint64_t> _data{};     /**< Glyph data, stored as 64-bit words to keep glyphs aligned */
+
+public:
+    GlyphPack(uint64_t fontHash, TessellationStrategy strategy, uint32_t variant = 0);
+    GlyphPack(const std::filesystem::path &path);
+    ~GlyphPack() = default;
+
+    void addGlyph(uint32_t glyphId, unsigned int fontSize, const Glyph &glyph);
+    void save(const std::filesystem::path &path) const;
+    unsigned int prefill(GlyphCache &cache,
+                         std::shared_ptr<Font> font,
+                         TessellationStrategy strategy,
+                         uint32_t variant = 0) const;
+
+    uint64_t getFontHash() const;
+    TessellationStrategy getStrategy() const;
+    uint32_t getVariant() const;
+    unsigned int getGlyphCount() const;
+};
+
+}  // namespace vft
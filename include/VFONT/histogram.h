@@ -0,0 +1,60 @@
+/**
+ * @file histogram.h
+ * @author Christian Saloň
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+
+namespace vft {
+
+/**
+ * @brief Thread safe histogram of non-negative integer values with power of two buckets
+ *
+ * Bucket 0 counts zeros, bucket i counts values from 2^(i-1) to 2^i - 1. Values that do not fit into the last bucket
+ * are counted in it
+ */
+class Histogram {
+public:
+    /** Number of buckets */
+    static constexpr unsigned int BUCKET_COUNT = 32;
+
+    /**
+     * @brief Copy of histogram data at one point in time
+     */
+    struct Snapshot {
+        std::array<uint64_t, BUCKET_COUNT> buckets{}; /**< Number of values in each bucket */
+        uint64_t count{0};                            /**< Number of recorded values */
+        uint64_t sum{0};                              /**< Sum of recorded values */
+        uint64_t min{0};                              /**< Smallest recorded value, zero if histogram is empty */
+        uint64_t max{0};                              /**< Largest recorded value */
+
+        double getMean() const;
+        uint64_t getPercentile(double percentile) const;
+    };
+
+protected:
+    std::array<std::atomic<uint64_t>, BUCKET_COUNT> _buckets{}; /**< Number of values in each bucket */
+    std::atomic<uint64_t> _count{0};                            /**< Number of recorded values */
+    std::atomic<uint64_t> _sum{0};                              /**< Sum of recorded values */
+    std::atomic<uint64_t> _min{UINT64_MAX};                     /**< Smallest recorded value */
+    std::atomic<uint64_t> _max{0};                              /**< Largest recorded value */
+
+public:
+    Histogram() = default;
+    ~Histogram() = default;
+
+    void record(uint64_t value);
+    void reset();
+
+    Snapshot getSnapshot() const;
+
+    static uint64_t getBucketUpperBound(unsigned int bucket);
+};
+
+}  // namespace vft
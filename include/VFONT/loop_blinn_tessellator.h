@@ -0,0 +1,53 @@
+/**
+ * @file loop_blinn_tessellator.h
+ * @author Christian Saloň
+ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <glm/vec2.hpp>
+
+#include "curve.h"
+#include "font.h"
+#include "glyph.h"
+#include "glyph_cache.h"
+#include "glyph_compositor.h"
+#include "glyph_mesh.h"
+#include "outline.h"
+#include "polygon_operator.h"
+#include "tessellation_shaders_tessellator.h"
+
+namespace vft {
+
+/**
+ * @brief Composes glyphs where the inner triangles are triangulated on the cpu and every curve segment is one triangle
+ * filled in the fragment shader by the sign of implicit function u^2 - v (C. Loop, J. Blinn, Resolution independent
+ * curve rendering using programmable graphics hardware)
+ *
+ * Inner outline is the same as in TessellationShadersTessellator. Every curve triangle has its own three vertices,
+ * start, control and end point, which get texture coordinates (0, 0), (0.5, 0) and (1, 1) from their order
+ */
+class LoopBlinnTessellator : public TessellationShadersTessellator {
+public:
+    /** Index of index buffer containing inner triangles in glyph's vector of index buffers */
+    static constexpr unsigned int GLYPH_MESH_TRIANGLE_BUFFER_INDEX = 0;
+    /** Index of index buffer containing curve triangles in glyph's vector of index buffers */
+    static constexpr unsigned int GLYPH_MESH_CURVE_BUFFER_INDEX = 1;
+
+    LoopBlinnTessellator() = default;
+    ~LoopBlinnTessellator() = default;
+
+    Glyph composeGlyph(uint32_t glyphId, std::shared_ptr<vft::Font> font, unsigned int fontSize = 0) const override;
+    TessellationStrategy getStrategy() const override;
+    std::unique_ptr<Tessellator> clone() const override;
+
+    static std::array<glm::vec2, 3> getCurveTextureCoordinates();
+    static float getCurveOrientation(const glm::vec2 &start, const glm::vec2 &control, const glm::vec2 &end);
+};
+
+}  // namespace vft
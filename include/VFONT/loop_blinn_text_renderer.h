@@ -0,0 +1,63 @@
+/**
+ * @file loop_blinn_text_renderer.h
+ * @author Christian Saloň
+ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+#include <glm/vec2.hpp>
+
+#include "glyph_cache.h"
+#include "loop_blinn_tessellator.h"
+#include "text_renderer.h"
+
+namespace vft {
+
+/**
+ * @brief Creates vertex and index buffers for all characters in text block to be rendered as inner triangles and curve
+ * triangles filled in the fragment shader, every glyph is drawn by one draw call
+ */
+class LoopBlinnTextRenderer : public virtual TextRenderer {
+public:
+    /**
+     * @brief Index count and offset of glyph indices in index buffer
+     */
+    struct GlyphInfo {
+        uint32_t indicesOffset; /**< Offset in the glyph's index buffer */
+        uint32_t indicesCount;  /**< Count of the glyph's inner and curve triangle indices */
+    };
+
+    /**
+     * @brief Vertex structure used for rendering text using Loop-Blinn curve triangles
+     */
+    struct Vertex {
+        glm::vec2 position; /**< Vertex position */
+        glm::vec2 uv;       /**< Texture coordinates of implicit function u^2 - v */
+        float orientation;  /**< Sign of u^2 - v of filled fragments negated, inner triangles are always filled */
+    };
+
+protected:
+    /**
+     * Hash map containing glyph info about the index buffers (key: glyph key, value: index count and offset in index
+     * buffer)
+     */
+    std::unordered_map<GlyphKey, GlyphInfo, GlyphKeyHash> _offsets{};
+
+    std::vector<Vertex> _vertices{};  /**< Vertex buffer */
+    std::vector<uint32_t> _indices{}; /**< Index buffer containing inner triangles followed by curve triangles */
+
+public:
+    LoopBlinnTextRenderer();
+    virtual ~LoopBlinnTextRenderer() = default;
+
+    virtual void update() override;
+};
+
+}  // namespace vft
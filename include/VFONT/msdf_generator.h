@@ -0,0 +1,122 @@
+/**
+ * @file msdf_generator.h
+ * @author Christian Saloň
+ *
+ * Adapted from msdfgen (https://github.com/Chlumsky/msdfgen), Copyright (c) 2014 - 2024 Viktor Chlumsky, MIT License,
+ * see msdf_generator.cpp for the full license notice
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <numbers>
+#include <stdexcept>
+#include <vector>
+
+#include <ft2build.h>
+#include FT_FREETYPE_H
+#include FT_OUTLINE_H
+#include <glm/glm.hpp>
+
+namespace vft {
+
+/**
+ * @brief Generates multi-channel signed distance fields from glyph outlines (V. Chlumsky, Shape decomposition for
+ * multi-channel distance fields)
+ *
+ * Segments of every contour are colored so that the two segments meeting at a sharp corner never share two color
+ * channels. Every channel stores the signed pseudo-distance to the nearest segment of its color and the median of the
+ * three channels reconstructs the outline including its corners. Pixels where the median has a different sign than
+ * the winding number of the outline get the true signed distance in all channels
+ */
+class MsdfGenerator {
+public:
+    /** Angle in radians whose sine bounds cross product of segment directions, turns over ~8 degrees are corners */
+    static constexpr double CORNER_ANGLE_THRESHOLD = 3.0;
+    /** Number of bytes of one pixel of the generated bitmap, red, green, blue and unused alpha channel */
+    static constexpr unsigned int CHANNEL_COUNT = 4;
+
+protected:
+    /** Color channels in which a segment is stored */
+    static constexpr uint8_t RED = 1;
+    static constexpr uint8_t GREEN = 2;
+    static constexpr uint8_t BLUE = 4;
+    static constexpr uint8_t WHITE = RED | GREEN | BLUE;
+
+    /**
+     * @brief Line or quadratic bezier curve of outline
+     */
+    struct Segment {
+        std::array<glm::dvec2, 3> points; /**< Start, control and end point, the control point of a line is unused */
+        bool isCurve;                     /**< True if segment is a quadratic bezier curve, false if it is a line */
+        uint8_t color;                    /**< Color channels in which the segment is stored */
+    };
+
+    /**
+     * @brief Signed distance from a segment, distances of equal size are ordered by the dot product of the segment's
+     * direction and the direction to the point, so the segment more orthogonal to the point is nearer
+     */
+    struct SignedDistance {
+        double distance{-std::numeric_limits<double>::max()}; /**< Signed distance */
+        double dot{1};                                         /**< Dot product of the directions */
+
+        bool operator<(const SignedDistance &other) const;
+    };
+
+    /**
+     * @brief Nearest segment found for one channel
+     */
+    struct NearestSegment {
+        SignedDistance distance{};       /**< Signed distance from the segment */
+        const Segment *segment{nullptr}; /**< Nearest segment */
+        double parameter{0};             /**< Parameter of the nearest point of the segment */
+    };
+
+    /**
+     * @brief Data used while decomposing outline
+     */
+    struct Context {
+        std::vector<std::vector<Segment>> contours{}; /**< Contours of outline */
+        glm::dvec2 lastPoint{0, 0};                    /**< End point of the last segment */
+    };
+
+    std::vector<std::vector<Segment>> _contours{}; /**< Contours of outline */
+    double _orientation{1}; /**< 1 if the outline is filled on the right side of contours, -1 if on the left side */
+
+public:
+    MsdfGenerator(const FT_Outline &outline);
+    ~MsdfGenerator() = default;
+
+    void generate(const glm::dvec2 &origin,
+                  const glm::dvec2 &pixelSize,
+                  double range,
+                  unsigned int width,
+                  unsigned int height,
+                  std::vector<uint8_t> &bitmap) const;
+
+protected:
+    void _colorSegments();
+    static void _switchColor(uint8_t &color, unsigned int &seed, uint8_t bannedColor = 0);
+    static bool _isCorner(const glm::dvec2 &previousDirection, const glm::dvec2 &nextDirection, double threshold);
+    static std::vector<Segment> _splitIntoThirds(const std::vector<Segment> &contour);
+
+    static glm::dvec2 _getPoint(const Segment &segment, double parameter);
+    static glm::dvec2 _getDirection(const Segment &segment, double parameter);
+    static SignedDistance _getSignedDistance(const Segment &segment, const glm::dvec2 &point, double &parameter);
+    static void _convertToPseudoDistance(const Segment &segment,
+                                         const glm::dvec2 &point,
+                                         double parameter,
+                                         SignedDistance &distance);
+    int _getWindingNumber(const glm::dvec2 &point) const;
+
+    static unsigned int _solveQuadratic(std::array<double, 3> &roots, double a, double b, double c);
+    static unsigned int _solveCubic(std::array<double, 3> &roots, double a, double b, double c, double d);
+    static double _cross(const glm::dvec2 &first, const glm::dvec2 &second);
+    static uint8_t _encodeDistance(double distance, double range);
+};
+
+}  // namespace vft
@@ -5,7 +5,8 @@
 
 #pragma once
 
-#include "circular_dll.h"
+#include <vector>
+
 #include "edge.h"
 
 namespace vft {
@@ -24,7 +25,7 @@ public:
     };
 
 public:
-    CircularDLL<Edge> edges{};                /**< Egdes of outline */
+    std::vector<Edge> edges{};                /**< Egdes of outline in the order they are connected */
     Orientation orientation{Orientation::CW}; /**< Orientation of outline */
 
 public:
@@ -8,14 +8,17 @@
 #include <algorithm>
 #include <cmath>
 #include <cstdint>
-#include <list>
+#include <numeric>
 #include <stdexcept>
+#include <tuple>
+#include <utility>
 #include <vector>
 
 #include <glm/glm.hpp>
 
-#include "circular_dll.h"
 #include "edge.h"
+#include "edge_broad_phase.h"
+#include "edge_pool.h"
 #include "outline.h"
 
 namespace vft {
@@ -25,14 +28,16 @@ namespace vft {
  */
 class Contour {
 public:
-    bool visited;    /**< True if contour was processed, else false */
-    Outline outline; /**< Outline that represents the contour */
+    bool visited;                     /**< True if contour was processed, else false */
+    uint32_t loop;                    /**< Index of loop of contour's edges in edge pool */
+    Outline::Orientation orientation; /**< Orientation of contour */
 
-    Contour(bool visited, Outline outline) : visited{visited}, outline{outline} {}
+    Contour(bool visited, uint32_t loop, Outline::Orientation orientation)
+        : visited{visited}, loop{loop}, orientation{orientation} {}
 };
 
 /**
- * @brief Performs boolean operations on two polygons which can have holes and self intersections
+ * @brief Performs union of polygons which can have holes and self intersections
  */
 class PolygonOperator {
 public:
@@ -40,49 +45,69 @@ public:
     ~PolygonOperator() = default;
 
 protected:
+    /**
+     * @brief Edge of polygon split at intersections, overlapping edges are merged into one segment
+     */
+    struct Segment {
+        uint32_t start;   /**< First vertex, merged segments start at the vertex with lower index */
+        uint32_t end;     /**< Second vertex */
+        int multiplicity; /**< Number of merged edges going from start to end minus edges going from end to start */
+    };
+
+    /**
+     * @brief Segments grouped into bands perpendicular to the direction of rays cast from points
+     */
+    struct SegmentBands {
+        unsigned int axis{0};                       /**< Axis along which rays are cast, 0 for x and 1 for y */
+        double start{0};                            /**< Coordinate where the first band starts */
+        double size{1};                             /**< Size of one band */
+        std::vector<std::vector<uint32_t>> bands{}; /**< Indices of segments overlapping each band */
+    };
+
     double _epsilon{1e-6}; /**< Max error */
 
-    std::vector<glm::vec2> _vertices{}; /**< Vertices of both polygons */
-    std::vector<Contour> _first{};      /**< First polygon */
-    std::vector<Contour> _second{};     /**< Second polygon */
-    std::vector<Outline> _output{};     /**< Output polygon */
+    std::vector<glm::vec2> _vertices{}; /**< Vertices of polygon */
+    EdgePool _edges{};                  /**< Edges of all contours created during one operation */
+    std::vector<Contour> _output{};     /**< Output polygon */
 
-    std::list<uint32_t> _intersections{}; /**< Linked list of intersections between first and second polyogon */
+    bool _hasOverlappingContours{false}; /**< Indicates whether contours of the last united polygon overlapped */
 
 public:
     void join(const std::vector<glm::vec2> &vertices,
               const std::vector<Outline> &first,
               const std::vector<Outline> &second);
+    void unite(const std::vector<glm::vec2> &vertices, const std::vector<Outline> &polygon);
 
     void setEpsilon(double epsilon);
 
     std::vector<glm::vec2> getVertices();
+    bool hasOverlappingContours() const;
     std::vector<Outline> getPolygon();
 
 protected:
-    void _initializeContours(const std::vector<glm::vec2> &vertices,
-                             const std::vector<Outline> &first,
-                             const std::vector<Outline> &second);
+    bool _hasOverlappingEdges(const std::vector<Outline> &polygon);
+    bool _doEdgesOverlap(const Edge &first, const Edge &second);
+    void _selectNonzeroContours(const std::vector<Outline> &polygon);
+
+    std::vector<uint32_t> _weldVertices();
+    std::vector<Edge> _splitAtIntersections(const std::vector<Outline> &polygon);
+    void _splitEdges(uint32_t first,
+                     uint32_t second,
+                     std::vector<std::pair<double, uint32_t>> &firstSplits,
+                     std::vector<std::pair<double, uint32_t>> &secondSplits);
+    bool _splitEdgeAtVertex(const Edge &edge, uint32_t vertex, std::vector<std::pair<double, uint32_t>> &splits);
+    void _addSplit(const Edge &edge, uint32_t vertex, std::vector<std::pair<double, uint32_t>> &splits);
+    std::vector<Edge> _selectNonzeroBoundary(const std::vector<Edge> &edges);
+    SegmentBands _createSegmentBands(const std::vector<Segment> &segments, unsigned int axis);
+    int _getWindingNumber(const glm::dvec2 &point,
+                          const std::vector<Segment> &segments,
+                          const SegmentBands &bands,
+                          uint32_t skippedSegment);
+    void _linkBoundary(const std::vector<Edge> &edges);
 
-    std::vector<Outline> _resolveSelfIntersections(Outline outline);
-    void _resolveOverlappingEdges();
-    void _resolveIntersectingEdges();
     bool _intersect(Edge first, Edge second, glm::vec2 &intersection);
-
-    void _walkContours();
-    uint32_t _walkUntilIntersectionOrStart(CircularDLL<Edge>::Node *start, unsigned int contourIndex);
-    void _markContourAsVisited(CircularDLL<Edge>::Node *edge);
-
-    void _addIntersectionIfNeeded(std::list<uint32_t> &intersections, uint32_t intersection);
-    void _removeUnwantedIntersections(std::list<uint32_t> &intersections, const std::vector<Contour> &contours);
-
-    std::vector<CircularDLL<Edge>::Node *> _getEdgesStartingAt(uint32_t vertex);
-    const Contour &_getContourOfEdge(CircularDLL<Edge>::Node *edge);
-    Outline::Orientation _getOrientationOfSubcontour(const Outline &outline, CircularDLL<Edge>::Node *start);
-    double _signedAreaOfContour(const Outline &outline);
-    bool _isOnLeftSide(glm::vec2 lineStartingPoint, glm::vec2 lineEndingPoint, glm::vec2 point);
+    double _signedAreaOfContour(const Contour &contour);
     double _determinant(double a, double b, double c, double d);
-    bool _isEdgeOnEdge(Edge first, Edge second);
     bool _isPointOnEdge(glm::vec2 point, Edge edge);
 };
 
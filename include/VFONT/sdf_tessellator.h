@@ -28,7 +28,9 @@ public:
     SdfTessellator();
     ~SdfTessellator() = default;
 
-    Glyph composeGlyph(uint32_t glyphId, std::shared_ptr<vft::Font> font, unsigned int fontSize = 0) override;
+    Glyph composeGlyph(uint32_t glyphId, std::shared_ptr<vft::Font> font, unsigned int fontSize = 0) const override;
+    TessellationStrategy getStrategy() const override;
+    std::unique_ptr<Tessellator> clone() const override;
 };
 
 }  // namespace vft
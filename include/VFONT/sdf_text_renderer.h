@@ -8,7 +8,9 @@
 #include <cstdint>
 #include <memory>
 #include <stdexcept>
+#include <string>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include <glm/mat4x4.hpp>
@@ -44,7 +46,8 @@ public:
 
 protected:
     /**
-     * Hash map of font atlases containng info about glyphs (key: font family, value: FontTexture object)
+     * Hash map of font atlases containng info about glyphs (key: font family, value: FontTexture object). Atlases of
+     * fonts without an added atlas are created on demand and glyphs missing in atlases are added during update
      */
     std::unordered_map<std::string, FontAtlas> _fontAtlases{};
 
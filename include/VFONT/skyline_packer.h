@@ -0,0 +1,57 @@
+/**
+ * @file skyline_packer.h
+ * @author Christian Saloň
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <optional>
+#include <stdexcept>
+#include <vector>
+
+#include <glm/vec2.hpp>
+
+namespace vft {
+
+/**
+ * @brief Packs rectangles into an area of fixed width and unbounded height using the skyline bottom-left heuristic
+ *
+ * The packer keeps the skyline, the top edge of the packed rectangles, as a list of horizontal segments. Every
+ * rectangle is placed on the skyline where its bottom edge is the lowest, the leftmost position is used if there are
+ * more of them. Rectangles sorted by decreasing height leave the least amount of space under the skyline
+ */
+class SkylinePacker {
+protected:
+    /**
+     * @brief Horizontal segment of skyline
+     */
+    struct Node {
+        unsigned int x;     /**< X coordinate of left end of segment */
+        unsigned int y;     /**< Y coordinate of segment, y axis points down */
+        unsigned int width; /**< Width of segment */
+    };
+
+    unsigned int _width{0};       /**< Width of packing area */
+    unsigned int _height{0};      /**< Height of packed rectangles */
+    std::vector<Node> _skyline{}; /**< Segments of skyline ordered from left to right */
+
+public:
+    SkylinePacker(unsigned int width);
+    ~SkylinePacker() = default;
+
+    std::optional<glm::uvec2> findPosition(unsigned int width) const;
+    std::optional<glm::uvec2> insert(unsigned int width, unsigned int height);
+
+    void setWidth(unsigned int width);
+    unsigned int getWidth() const;
+    unsigned int getHeight() const;
+
+protected:
+    std::optional<std::size_t> _findNode(unsigned int width, glm::uvec2 &position) const;
+    std::optional<unsigned int> _fit(std::size_t nodeIndex, unsigned int width) const;
+    void _addNode(std::size_t nodeIndex, const glm::uvec2 &position, unsigned int width, unsigned int height);
+};
+
+}  // namespace vft
@@ -9,7 +9,6 @@
 #include <memory>
 #include <vector>
 
-#include "circular_dll.h"
 #include "curve.h"
 #include "edge.h"
 #include "font.h"
@@ -35,19 +34,25 @@ public:
     static constexpr unsigned int GLYPH_MESH_CURVE_BUFFER_INDEX = 1;
 
 protected:
-    std::vector<Outline> _firstPolygon{};  /**< Polygon containing processed glyph contours */
-    std::vector<Outline> _secondPolygon{}; /**< Polygon containing current contour */
-
-    double area{0}; /**< Signed area of current contour */
+    /**
+     * @brief State of one glyph composition extended by polygons joined into the glyph's inner outline
+     */
+    struct Context : Tessellator::Context {
+        std::vector<Outline> contours{}; /**< Contours of composed glyph, joined once all of them are processed */
+    };
 
 public:
     TessellationShadersTessellator();
     ~TessellationShadersTessellator() = default;
 
-    Glyph composeGlyph(uint32_t glyphId, std::shared_ptr<vft::Font> font, unsigned int fontSize = 0) override;
+    Glyph composeGlyph(uint32_t glyphId, std::shared_ptr<vft::Font> font, unsigned int fontSize = 0) const override;
+    TessellationStrategy getStrategy() const override;
+    std::unique_ptr<Tessellator> clone() const override;
 
 protected:
-    bool _isOnLeftSide(const glm::vec2 &lineStartingPoint, const glm::vec2 &lineEndingPoint, const glm::vec2 &point);
+    static bool _isOnLeftSide(const glm::vec2 &lineStartingPoint,
+                              const glm::vec2 &lineEndingPoint,
+                              const glm::vec2 &point);
 };
 
 }  // namespace vft
@@ -5,9 +5,17 @@
 
 #pragma once
 
+#include <atomic>
+#include <chrono>
+#include <cstddef>
 #include <cstdint>
+#include <exception>
+#include <latch>
 #include <memory>
+#include <mutex>
+#include <span>
 #include <stdexcept>
+#include <unordered_map>
 #include <vector>
 
 #include <ft2build.h>
@@ -19,36 +27,109 @@
 #include "edge.h"
 #include "font.h"
 #include "glyph.h"
+#include "histogram.h"
+#include "thread_pool.h"
 
 namespace vft {
 
+/**
+ * @brief Lists all available algorithms for rendering text
+ */
+enum class TessellationStrategy { SDF, TRIANGULATION, TESSELLATION_SHADERS, WINDING_NUMBER, LOOP_BLINN };
+
+/**
+ * @brief Request to compose one glyph
+ */
+struct GlyphRequest {
+    uint32_t glyphId;           /**< Id of glyph to compose */
+    std::shared_ptr<Font> font; /**< Font of glyph */
+    unsigned int fontSize{0};   /**< Font size of glyph, zero if glyph does not depend on font size */
+};
+
 /**
  * @brief Base class for all tessellators. Composes a glyph based on rendering method
  */
 class Tessellator {
+public:
+    /**
+     * @brief Statistics of composed glyphs, collected only when enabled by setStatsEnabled()
+     */
+    struct Stats {
+        TessellationStrategy strategy;    /**< Algorithm used by tessellator */
+        Histogram::Snapshot composeTime;  /**< Time spent in composeGlyph() in microseconds */
+        Histogram::Snapshot vertexCount;  /**< Number of vertices of composed glyphs */
+        Histogram::Snapshot indexCount;   /**< Number of indices in all index buffers of composed glyphs */
+        Histogram::Snapshot segmentCount; /**< Number of line and curve segments of composed glyphs */
+        uint64_t skippedUnionCount;       /**< Number of glyphs whose contours did not overlap, so union was skipped */
+    };
+
 protected:
+    /**
+     * @brief State of one glyph composition passed to freetype outline decompose functions. Every call of
+     * composeGlyph() uses its own context, so one tessellator can compose glyphs on several threads at once
+     */
+    struct Context {
+        uint32_t vertexIndex{0};             /**< Index of next unique vertex */
+        uint32_t contourStartVertexIndex{0}; /**< Index of vertex that starts current contour */
+        glm::vec2 lastVertex{0, 0};          /**< Last processed vertex */
+        uint32_t lastVertexIndex{0};         /**< Index of last processed vertex */
+        unsigned int contourCount{0};        /**< Number of processed contours */
+
+        Glyph glyph{};                      /**< Metrics of composed glyph */
+        std::vector<glm::vec2> vertices{};  /**< Vertices of composed glyph */
+        std::vector<Edge> lineSegments{};   /**< Line segments of composed glyph */
+        std::vector<Curve> curveSegments{}; /**< Curve segments of composed glyph */
+
+        /**
+         * Grid with cells of the size of the weld tolerance used to find vertices close to a new vertex (key: packed
+         * cell coordinates, value: last vertex added to cell)
+         */
+        std::unordered_map<uint64_t, uint32_t> vertexGrid{};
+        std::vector<uint32_t> vertexGridNext{}; /**< Previous vertex in the same grid cell for every vertex in grid */
+
+        virtual ~Context() = default;
+
+        uint32_t getVertexIndex(const glm::vec2 &vertex);
+    };
+
     FT_Outline_MoveToFunc _moveToFunc{nullptr};   /**< Freetype moveTo function */
     FT_Outline_LineToFunc _lineToFunc{nullptr};   /**< Freetype lineTo function */
     FT_Outline_ConicToFunc _conicToFunc{nullptr}; /**< Freetype conicTo function */
     FT_Outline_CubicToFunc _cubicToFunc{nullptr}; /**< Freetype cubicTo function */
 
-    uint32_t vertexIndex{0};             /**< Index of next unique vertex */
-    uint32_t contourStartVertexIndex{0}; /**< Index of vertex that starts current contour */
-    glm::vec2 lastVertex{0, 0};          /**< Last processed vertex */
-    uint32_t lastVertexIndex{0};         /**< Index of last processed vertex */
-    unsigned int contourCount{0};        /**< Number of processed contours */
+    /**
+     * @brief Histograms of composed glyphs, shared with copies of the tessellator
+     */
+    struct StatsRecorder {
+        std::atomic<bool> enabled{false};           /**< Indicates whether statistics are collected */
+        Histogram composeTime{};                    /**< Time spent in composeGlyph() in microseconds */
+        Histogram vertexCount{};                    /**< Number of vertices of composed glyphs */
+        Histogram indexCount{};                     /**< Number of indices of composed glyphs */
+        Histogram segmentCount{};                   /**< Number of segments of composed glyphs */
+        std::atomic<uint64_t> skippedUnionCount{0}; /**< Number of glyphs whose union of contours was skipped */
+    };
 
-    Glyph _currentGlyph{}; /**< Glyph that is currently being composed */
+    std::shared_ptr<StatsRecorder> _stats{std::make_shared<StatsRecorder>()}; /**< Statistics of composed glyphs */
 
 public:
     Tessellator();
-    ~Tessellator() = default;
+    virtual ~Tessellator() = default;
+
+    virtual Glyph composeGlyph(uint32_t glyphId, std::shared_ptr<vft::Font> font, unsigned int fontSize = 0) const = 0;
+    std::vector<Glyph> composeGlyphs(std::span<const GlyphRequest> requests, ThreadPool &threadPool) const;
+    virtual TessellationStrategy getStrategy() const = 0;
+    virtual uint32_t getVariant() const;
+    virtual std::unique_ptr<Tessellator> clone() const = 0;
 
-    virtual Glyph composeGlyph(uint32_t glyphId, std::shared_ptr<vft::Font> font, unsigned int fontSize = 0) = 0;
+    void setStatsEnabled(bool enabled);
+    Stats getStats() const;
+    void resetStats();
 
 protected:
-    Glyph _composeGlyph(uint32_t glyphId, std::shared_ptr<vft::Font> font);
-    uint32_t _getVertexIndex(const glm::vec2 &vertex);
+    Glyph _composeGlyph(uint32_t glyphId, std::shared_ptr<vft::Font> font, Context &context) const;
+    void _shareStats(Tessellator &tessellator) const;
+    void _recordStats(std::chrono::steady_clock::time_point start, const Glyph &glyph, std::size_t segmentCount) const;
+    void _recordSkippedUnion() const;
 };
 
 }  // namespace vft
@@ -5,25 +5,31 @@
 
 #pragma once
 
+#include <atomic>
+#include <chrono>
 #include <cstdint>
+#include <functional>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <stdexcept>
+#include <string>
+#include <unordered_set>
 #include <vector>
 
 #include <glm/mat4x4.hpp>
 
+#include "character.h"
 #include "font_atlas.h"
+#include "glyph.h"
 #include "glyph_cache.h"
+#include "glyph_disk_cache.h"
 #include "tessellator.h"
 #include "text_block.h"
+#include "thread_pool.h"
 
 namespace vft {
 
-/**
- * @brief Lists all available algorithms for rendering text
- */
-enum class TessellationStrategy { SDF, TRIANGULATION, TESSELLATION_SHADERS, WINDING_NUMBER };
-
 /**
  * @brief Uniform buffer object
  */
@@ -38,16 +44,40 @@ public:
 
 /**
  * @brief Base class for text renderers
+ *
+ * Glyphs missing in the glyph cache are composed synchronously by default. With asynchronous composition enabled,
+ * missing glyphs are composed synchronously only until the composition budget of the current update is spent, the
+ * remaining glyphs are composed by worker threads and rendered as empty glyphs until they are ready
  */
 class TextRenderer {
+public:
+    /** Default time each update can spend composing glyphs synchronously when asynchronous composition is enabled */
+    static constexpr std::chrono::microseconds DEFAULT_SYNC_COMPOSITION_BUDGET{4000};
+
 protected:
+    /**
+     * @brief State shared by renderer and worker threads, outlives the renderer while workers use it
+     */
+    struct AsyncCompositionState {
+        std::mutex mutex{};                                  /**< Guards queued glyphs and callback */
+        std::unordered_set<GlyphKey, GlyphKeyHash> queued{}; /**< Glyphs that are queued or being composed */
+        std::function<void()> onGlyphsComposed{};            /**< Called by worker thread after a glyph is composed */
+        std::atomic<bool> composed{false}; /**< True if a glyph was composed since the last updateComposedGlyphs() */
+    };
+
     UniformBufferObject _ubo{glm::mat4{1.f}, glm::mat4{1.f}}; /**< Unifomr buffer object */
     unsigned int _viewportWidth{0};                           /**< Viewport width */
     unsigned int _viewportHeight{0};                          /**< Viewport height */
 
     std::vector<std::shared_ptr<TextBlock>> _textBlocks{}; /**< All text blocks to be rendered */
     std::shared_ptr<GlyphCache> _cache{nullptr}; /**< Glyph cache stores glyphs and reads them before rendering */
-    std::unique_ptr<Tessellator> _tessellator{nullptr}; /**< Tessellator to compose glyphs for rendering */
+    std::shared_ptr<Tessellator> _tessellator{nullptr}; /**< Tessellator to compose glyphs for rendering */
+
+    /** Time each update can spend composing glyphs synchronously when asynchronous composition is enabled */
+    std::chrono::microseconds _syncCompositionBudget{DEFAULT_SYNC_COMPOSITION_BUDGET};
+    std::chrono::microseconds _syncCompositionTime{0}; /**< Time spent composing glyphs in the current update */
+    std::shared_ptr<AsyncCompositionState> _asyncState{std::make_shared<AsyncCompositionState>()}; /**< Async state */
+    std::unique_ptr<ThreadPool> _threadPool{nullptr}; /**< Workers composing glyphs, nullptr if composition is sync */
 
 public:
     TextRenderer();
@@ -61,6 +91,40 @@ public:
     virtual void setUniformBuffers(UniformBufferObject ubo);
     virtual void setViewportSize(unsigned int width, unsigned int height);
     virtual void setCache(std::shared_ptr<GlyphCache> cache);
+
+    virtual void setStatsEnabled(bool enabled);
+    virtual GlyphCache::Stats getCacheStats() const;
+    virtual Tessellator::Stats getTessellatorStats() const;
+    virtual void resetStats();
+
+    virtual void setAsyncComposition(bool enabled, unsigned int threadCount = 0);
+    virtual void setSyncCompositionBudget(std::chrono::microseconds budget);
+    virtual void setOnGlyphsComposed(std::function<void()> callback);
+    virtual bool updateComposedGlyphs();
+
+    virtual unsigned int prewarm(std::shared_ptr<Font> font,
+                                 std::vector<unsigned int> fontSizes,
+                                 std::vector<uint32_t> glyphIds,
+                                 unsigned int threadCount = 0,
+                                 std::function<void(unsigned int, unsigned int)> onProgress = nullptr);
+    unsigned int prewarm(std::shared_ptr<Font> font,
+                         std::vector<unsigned int> fontSizes,
+                         std::vector<FontAtlas::CharacterRange> characterRanges,
+                         unsigned int threadCount = 0,
+                         std::function<void(unsigned int, unsigned int)> onProgress = nullptr);
+    unsigned int prewarm(std::shared_ptr<Font> font,
+                         std::vector<unsigned int> fontSizes,
+                         std::u32string characters,
+                         unsigned int threadCount = 0,
+                         std::function<void(unsigned int, unsigned int)> onProgress = nullptr);
+
+protected:
+    virtual GlyphKey _getGlyphKey(const Character &character) const;
+    std::shared_ptr<const Glyph> _getGlyph(const GlyphKey &key, const Character &character);
+    void _composeGlyphAsync(const GlyphKey &key,
+                            const Character &character,
+                            const std::optional<GlyphDiskCache::Key> &diskKey);
+    void _resetCompositionBudget();
 };
 
 }  // namespace vft
@@ -0,0 +1,48 @@
+/**
+ * @file thread_pool.h
+ * @author Christian Saloň
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+namespace vft {
+
+/**
+ * @brief Fixed number of worker threads executing submitted tasks in the order they were submitted
+ */
+class ThreadPool {
+protected:
+    std::vector<std::thread> _threads{};        /**< Worker threads */
+    std::queue<std::function<void()>> _tasks{}; /**< Tasks waiting for a free worker */
+    unsigned int _activeTaskCount{0};           /**< Number of tasks that are being executed */
+    bool _stopping{false};                      /**< Indicates that workers should exit */
+    mutable std::mutex _mutex{};                /**< Guards task queue and counters */
+    std::condition_variable _taskAvailable{};   /**< Signalled when a task is submitted or pool stops */
+    std::condition_variable _tasksFinished{};   /**< Signalled when the pool becomes idle */
+
+public:
+    ThreadPool(unsigned int threadCount = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    void submit(std::function<void()> task);
+    void wait();
+
+    unsigned int getThreadCount() const;
+    unsigned int getPendingTaskCount() const;
+
+protected:
+    void _work();
+};
+
+}  // namespace vft
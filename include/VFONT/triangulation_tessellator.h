@@ -5,16 +5,19 @@
 
 #pragma once
 
+#include <algorithm>
 #include <array>
+#include <atomic>
+#include <bit>
+#include <cmath>
 #include <cstdint>
 #include <memory>
-#include <set>
+#include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
 #include <glm/glm.hpp>
 
-#include "circular_dll.h"
 #include "curve.h"
 #include "edge.h"
 #include "font.h"
@@ -33,27 +36,74 @@ namespace vft {
  */
 class TriangulationTessellator : public Tessellator {
 public:
-    /** Index of index buffer containing trinagles in glyph's vector of index buffers */
+    /**
+     * Index of index buffer containing trinagles in glyph's vector of index buffers. Glyphs composed with levels of
+     * detail store level i in index buffer GLYPH_MESH_TRIANGLE_BUFFER_INDEX + i, an empty index buffer of level i > 0
+     * means that the level is the same as level i - 1. Other glyphs store only NOMINAL_LEVEL_OF_DETAIL
+     */
     static constexpr unsigned int GLYPH_MESH_TRIANGLE_BUFFER_INDEX = 0;
 
+    /** Max distance in pixels between a quadratic bezier curve and line segments approximating it */
+    static constexpr double FLATTENING_TOLERANCE = 0.05;
+
+    /** Number of levels of detail of glyph's mesh if enabled, all levels share one vertex buffer */
+    static constexpr unsigned int LEVEL_OF_DETAIL_COUNT = GlyphMesh::MAX_DRAW_COUNT;
+    /** Level of detail flattened with FLATTENING_TOLERANCE, more detailed levels are used when zooming in */
+    static constexpr unsigned int NOMINAL_LEVEL_OF_DETAIL = 1;
+    /** Ratio between flattening tolerances of neighbouring levels of detail, each level halves curve segments */
+    static constexpr double LEVEL_OF_DETAIL_TOLERANCE_RATIO = 4;
+    /** Max number of line segments approximating one quadratic bezier curve */
+    static constexpr unsigned int MAX_CURVE_SEGMENT_COUNT = 1024;
+    /** Variant of glyphs composed with levels of detail, glyphs with only the nominal level have variant 0 */
+    static constexpr uint32_t LEVELS_OF_DETAIL_VARIANT = 1;
+
 protected:
-    std::shared_ptr<Font> _font{nullptr}; /**< Font of current glyph */
-    unsigned int _fontSize{0};            /**< Font size of current glyph */
+    /**
+     * @brief Line or quadratic bezier curve segment of a contour before curves are flattened
+     */
+    struct Segment {
+        Curve curve;  /**< Vertex indices of segment, the control point of a line is unused */
+        bool isCurve; /**< True if segment is a quadratic bezier curve, false if it is a line */
+    };
+
+    /**
+     * @brief State of one glyph composition extended by polygons joined into the glyph's outline
+     */
+    struct Context : Tessellator::Context {
+        const TriangulationTessellator *tessellator{nullptr}; /**< Tessellator composing the glyph */
+        std::shared_ptr<Font> font{nullptr};                  /**< Font of composed glyph */
+        unsigned int fontSize{0};                             /**< Font size of composed glyph */
 
-    std::vector<Outline> _firstPolygon{};  /**< Polygon containing processed glyph contours */
-    std::vector<Outline> _secondPolygon{}; /**< Polygon containing current contour */
+        std::vector<std::vector<Segment>> outline{}; /**< Contours of composed glyph before curves are flattened */
+        std::vector<Outline> contours{};             /**< Flattened contours of composed glyph, joined by union */
 
-    double area{0}; /**< Signed area of current contour */
+        std::vector<float> curveParameters{}; /**< Parameters of points of currently flattened curve */
+        std::vector<glm::vec2> curvePoints{}; /**< Points of currently flattened curve */
+    };
+
+    std::atomic<bool> _useLevelsOfDetail{false}; /**< Indicates whether glyphs are composed with levels of detail */
 
 public:
     TriangulationTessellator();
     ~TriangulationTessellator() = default;
 
-    Glyph composeGlyph(uint32_t glyphId, std::shared_ptr<vft::Font> font, unsigned int fontSize = 0) override;
+    Glyph composeGlyph(uint32_t glyphId, std::shared_ptr<vft::Font> font, unsigned int fontSize = 0) const override;
+    TessellationStrategy getStrategy() const override;
+    uint32_t getVariant() const override;
+    std::unique_ptr<Tessellator> clone() const override;
+
+    void setLevelsOfDetailEnabled(bool enabled);
+    bool isLevelsOfDetailEnabled() const;
+    static double getLevelOfDetailTolerance(unsigned int levelOfDetail);
 
 protected:
-    std::set<float> _subdivideQuadraticBezier(const std::array<glm::vec2, 3> curve);
-    void _subdivide(const std::array<glm::vec2, 3> curve, float t, float delta, std::set<float> &newVertices);
+    static std::vector<unsigned int> _flattenOutline(Context &context, double tolerance);
+    static void _flattenQuadraticBezier(const std::array<glm::vec2, 3> &curve,
+                                        double tolerance,
+                                        std::vector<float> &parameters);
+    static void _evaluateQuadraticBezier(const std::array<glm::vec2, 3> &curve,
+                                         const std::vector<float> &parameters,
+                                         std::vector<glm::vec2> &points);
 };
 
 }  // namespace vft
@@ -5,14 +5,20 @@
 
 #pragma once
 
+#include <algorithm>
+#include <array>
 #include <cstdint>
 #include <memory>
 #include <stdexcept>
 #include <unordered_map>
 #include <vector>
 
+#include <glm/mat4x4.hpp>
 #include <glm/vec2.hpp>
+#include <glm/vec4.hpp>
 
+#include "character.h"
+#include "font_size_bucketing.h"
 #include "glyph_cache.h"
 #include "text_renderer.h"
 #include "triangulation_tessellator.h"
@@ -28,11 +34,13 @@ public:
     static constexpr unsigned int TRIANGLE_OFFSET_BUFFER_INDEX = 0;
 
     /**
-     * @brief Index count and offset of glyph indices in index buffers
+     * @brief Index count and offset of glyph indices in index buffers for every level of detail
      */
     struct GlyphInfo {
-        uint32_t indicesOffset; /**< Offset in the glyph's triangle index buffer */
-        uint32_t indicesCount;  /**< Count of the glyph's triangle indices */
+        /** Offset in the glyph's triangle index buffer of each level of detail */
+        std::array<uint32_t, TriangulationTessellator::LEVEL_OF_DETAIL_COUNT> indicesOffset;
+        /** Count of the glyph's triangle indices of each level of detail */
+        std::array<uint32_t, TriangulationTessellator::LEVEL_OF_DETAIL_COUNT> indicesCount;
     };
 
 protected:
@@ -45,11 +53,23 @@ protected:
     std::vector<glm::vec2> _vertices{}; /**< Vertex buffer */
     std::vector<uint32_t> _indices{};   /**< Index buffer */
 
+    FontSizeBucketing _fontSizeBucketing{}; /**< Selects font size for which glyphs are triangulated */
+    bool _useLevelsOfDetail{false};         /**< Indicates whether glyphs are rendered with levels of detail */
+
 public:
     TriangulationTextRenderer();
     virtual ~TriangulationTextRenderer() = default;
 
     virtual void update() override;
+
+    void setLevelsOfDetailEnabled(bool enabled);
+    bool isLevelsOfDetailEnabled() const;
+    void setFontSizeBucketing(FontSizeBucketing fontSizeBucketing);
+    FontSizeBucketing getFontSizeBucketing() const;
+
+protected:
+    GlyphKey _getGlyphKey(const Character &character) const override;
+    unsigned int _selectLevelOfDetail(const Character &character) const;
 };
 
 }  // namespace vft
@@ -0,0 +1,56 @@
+/**
+ * @file vulkan_loop_blinn_text_renderer.h
+ * @author Christian Saloň
+ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+#include <vulkan/vulkan.h>
+#include <glm/vec2.hpp>
+
+#include "glyph_cache.h"
+#include "loop_blinn_tessellator.h"
+#include "loop_blinn_text_renderer.h"
+#include "vulkan_text_renderer.h"
+
+namespace vft {
+
+/**
+ * @brief Basic implementation of vulkan text renderer where inner triangles are triangulized on the cpu and curve
+ * triangles are filled in the fragment shader, all triangles of a glyph are drawn by one pipeline
+ */
+class VulkanLoopBlinnTextRenderer : public VulkanTextRenderer, public LoopBlinnTextRenderer {
+protected:
+    VkBuffer _vertexBuffer{nullptr};             /**< Vulkan vertex buffer */
+    VkDeviceMemory _vertexBufferMemory{nullptr}; /**< Vulkan vertex buffer memory */
+    VkBuffer _indexBuffer{nullptr};              /**< Vulkan index buffer for glyph's triangles */
+    VkDeviceMemory _indexBufferMemory{nullptr};  /**< Vulkan index buffer memory for glyph's triangles */
+
+    VkPipelineLayout _pipelineLayout{nullptr}; /**< Vulkan pipeline layout for glyph's inner and curve triangles */
+    VkPipeline _pipeline{nullptr};             /**< Vulkan pipeline for glyph's inner and curve triangles */
+
+public:
+    VulkanLoopBlinnTextRenderer(VkPhysicalDevice physicalDevice,
+                                VkDevice logicalDevice,
+                                VkQueue graphicsQueue,
+                                VkCommandPool commandPool,
+                                VkRenderPass renderPass,
+                                VkSampleCountFlagBits msaaSampleCount = VK_SAMPLE_COUNT_1_BIT,
+                                VkCommandBuffer commandBuffer = nullptr);
+    virtual ~VulkanLoopBlinnTextRenderer();
+
+    void draw() override;
+    void update() override;
+
+protected:
+    void _createPipeline();
+};
+
+}  // namespace vft
@@ -34,18 +34,28 @@ public:
      */
     class FontTexture {
     public:
-        VkImage image{nullptr};                 /**< Vulkan image containing font texture */
-        VkDeviceMemory memory{nullptr};         /**< Vulkan memory containing the font texture */
-        VkImageView imageView{nullptr};         /**< Vulkan image view of font texture */
-        VkSampler sampler{nullptr};             /**< Vulkan sampler of font texture */
-        VkDescriptorSet descriptorSet{nullptr}; /**< Vulkan descriptor set of font texure */
+        VkImage image{nullptr};                     /**< Vulkan image containing font texture */
+        VkDeviceMemory memory{nullptr};             /**< Vulkan memory containing the font texture */
+        VkImageView imageView{nullptr};             /**< Vulkan image view of font texture */
+        VkSampler sampler{nullptr};                 /**< Vulkan sampler of font texture */
+        VkDescriptorSet descriptorSet{nullptr};     /**< Vulkan descriptor set of font texure */
+        FontAtlas::Type type{FontAtlas::Type::SDF}; /**< Type of distance field stored in font texture */
+        glm::uvec2 size{0, 0};                      /**< Size of vulkan image, the font atlas may have grown since */
 
         FontTexture(VkImage image,
                     VkDeviceMemory memory,
                     VkImageView imageView,
                     VkSampler sampler,
-                    VkDescriptorSet descriptorSet)
-            : image{image}, memory{memory}, imageView{imageView}, sampler{sampler}, descriptorSet{descriptorSet} {}
+                    VkDescriptorSet descriptorSet,
+                    FontAtlas::Type type,
+                    glm::uvec2 size)
+            : image{image},
+              memory{memory},
+              imageView{imageView},
+              sampler{sampler},
+              descriptorSet{descriptorSet},
+              type{type},
+              size{size} {}
     };
 
     /**
@@ -85,6 +95,7 @@ protected:
 
     VkPipelineLayout _pipelineLayout{nullptr}; /**< Vulkan pipeline layout for rendering glyphs using sdfs */
     VkPipeline _pipeline{nullptr};             /**< Vulkan pipeline for rendering glyphs using sdfs */
+    VkPipeline _msdfPipeline{nullptr};         /**< Vulkan pipeline for rendering glyphs using msdfs */
 
     VkDescriptorSetLayout _fontAtlasDescriptorSetLayout{nullptr}; /**< Vulkan descriptor set layout for font atlases */
     std::vector<VkDescriptorSet> _fontAtlasDescriptorSets{};      /**< Vulkan descriptor sets for font atlases */
@@ -120,8 +131,18 @@ protected:
     void _createDescriptorPool() override;
     void _createFontAtlasDescriptorSetLayout();
     VkDescriptorSet _createFontAtlasDescriptorSet(VkImageView imageView, VkSampler sampler);
+    void _writeFontAtlasDescriptorSet(VkDescriptorSet descriptorSet, VkImageView imageView, VkSampler sampler);
+
+    void _updateFontTextures();
+    void _createFontTexture(FontAtlas &atlas);
+    void _updateFontTexture(FontTexture &texture, FontAtlas &atlas);
+    void _createFontImage(glm::uvec2 size, VkFormat format, VkImage &image, VkDeviceMemory &imageMemory);
+    VkImageView _createFontImageView(VkImage image, VkFormat format);
+    static VkFormat _getFontAtlasFormat(FontAtlas::Type type);
 
     void _copyBufferToImage(VkBuffer buffer, VkImage image, uint32_t width, uint32_t height);
+    void _copyBufferToImage(VkBuffer buffer, VkImage image, const std::vector<VkBufferImageCopy> &regions);
+    void _copyImage(VkImage source, VkImage destination, uint32_t width, uint32_t height);
     void _transitionImageLayout(VkImage image, VkFormat format, VkImageLayout oldLayout, VkImageLayout newLayout);
 };
 
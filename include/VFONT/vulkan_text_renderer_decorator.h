@@ -36,6 +36,22 @@ public:
     void setViewportSize(unsigned int width, unsigned int height) override;
     void setCache(std::shared_ptr<GlyphCache> cache) override;
 
+    void setStatsEnabled(bool enabled) override;
+    GlyphCache::Stats getCacheStats() const override;
+    Tessellator::Stats getTessellatorStats() const override;
+    void resetStats() override;
+    void setAsyncComposition(bool enabled, unsigned int threadCount = 0) override;
+    void setSyncCompositionBudget(std::chrono::microseconds budget) override;
+    void setOnGlyphsComposed(std::function<void()> callback) override;
+    bool updateComposedGlyphs() override;
+
+    using TextRenderer::prewarm;
+    unsigned int prewarm(std::shared_ptr<Font> font,
+                         std::vector<unsigned int> fontSizes,
+                         std::vector<uint32_t> glyphIds,
+                         unsigned int threadCount = 0,
+                         std::function<void(unsigned int, unsigned int)> onProgress = nullptr) override;
+
     void setCommandBuffer(VkCommandBuffer commandBuffer) override;
 
     VkPhysicalDevice getPhysicalDevice() override;
@@ -32,12 +32,12 @@ public:
      * @brief Vulkan push constants
      */
     struct CharacterPushConstants {
-        glm::mat4 model;                  /**< Model matrix of character */
-        glm::vec4 color;                  /**< Color of character */
-        uint32_t lineSegmentsStartIndex;  /**< Index into the ssbo where glyph's line segments start */
-        uint32_t lineSegmentsCount;       /**< Number of glyph's line segments */
-        uint32_t curveSegmentsStartIndex; /**< Index into the ssbo where glyph's curve segments start */
-        uint32_t curveSegmentsCount;      /**< Number of glyph's curve segments */
+        glm::mat4 model;          /**< Model matrix of character */
+        glm::vec4 color;          /**< Color of character */
+        uint32_t bandsStartIndex; /**< Index into the band buffer where glyph's bands start */
+        uint32_t bandCount;       /**< Number of glyph's horizontal bands */
+        float bandsBottom;        /**< Bottom of glyph's bounding box divided into bands */
+        float bandsTop;           /**< Top of glyph's bounding box divided into bands */
     };
 
 protected:
@@ -47,6 +47,8 @@ protected:
     VkDeviceMemory _boundingBoxIndexBufferMemory{nullptr}; /**< Vulkan index buffer memory for bonding boxes  */
     VkBuffer _segmentsBuffer{nullptr};                     /**< Vulkan vertex buffer for line and curve segments */
     VkDeviceMemory _segmentsBufferMemory{nullptr}; /**< Vulkan vertex buffer memory for line and curve segments */
+    VkBuffer _bandsBuffer{nullptr};                /**< Vulkan buffer for horizontal bands of segments */
+    VkDeviceMemory _bandsBufferMemory{nullptr};    /**< Vulkan buffer memory for horizontal bands of segments */
 
     VkPipelineLayout _segmentsPipelineLayout{
         nullptr};                          /**< Vulkan pipeline layout for glpyh's line and curve segments */
@@ -5,11 +5,15 @@
 
 #pragma once
 
+#include <algorithm>
 #include <array>
+#include <cmath>
 #include <cstdint>
 #include <memory>
 #include <vector>
 
+#include <glm/glm.hpp>
+
 #include "curve.h"
 #include "edge.h"
 #include "font.h"
@@ -32,11 +36,30 @@ public:
     static constexpr unsigned int GLYPH_MESH_CURVE_BUFFER_INDEX = 1;
     /** Index of index buffer containing line segments in glyph's vector of index buffers */
     static constexpr unsigned int GLYPH_MESH_LINE_BUFFER_INDEX = 2;
+    /**
+     * Index of index buffer containing horizontal bands of segments in glyph's vector of index buffers. The buffer
+     * starts with the number of bands, which evenly divide the glyph's bounding box from bottom to top. Every band
+     * follows as the number of its segments and their indices sorted by max x in descending order, line segments are
+     * indexed first and curve segments follow them
+     */
+    static constexpr unsigned int GLYPH_MESH_BAND_BUFFER_INDEX = 3;
+
+    /** Max number of horizontal bands of one glyph */
+    static constexpr unsigned int MAX_BAND_COUNT = 16;
 
     WindingNumberTessellator();
     ~WindingNumberTessellator() = default;
 
-    Glyph composeGlyph(uint32_t glyphId, std::shared_ptr<vft::Font> font, unsigned int fontSize = 0) override;
+    Glyph composeGlyph(uint32_t glyphId, std::shared_ptr<vft::Font> font, unsigned int fontSize = 0) const override;
+    TessellationStrategy getStrategy() const override;
+    std::unique_ptr<Tessellator> clone() const override;
+
+    static std::vector<uint32_t> createBands(const std::vector<glm::vec2> &vertices,
+                                             const std::vector<uint32_t> &lineIndices,
+                                             const std::vector<uint32_t> &curveIndices,
+                                             float bottom,
+                                             float top);
+    static unsigned int getBand(float y, float bottom, float top, unsigned int bandCount);
 };
 
 }  // namespace vft
@@ -5,6 +5,7 @@
 
 #pragma once
 
+#include <array>
 #include <cstdint>
 #include <memory>
 #include <stdexcept>
@@ -49,6 +50,10 @@ public:
         uint32_t lineSegmentsCount;       /**< Number of glyph's line segments */
         uint32_t curveSegmentsStartIndex; /**< Index into the ssbo where glyph's curve segments start */
         uint32_t curveSegmentsCount;      /**< Number of glyph's curve segments */
+        uint32_t bandsStartIndex;         /**< Index into the band buffer where glyph's bands start */
+        uint32_t bandCount;               /**< Number of glyph's horizontal bands */
+        float bandsBottom;                /**< Bottom of glyph's bounding box divided into bands */
+        float bandsTop;                   /**< Top of glyph's bounding box divided into bands */
     };
 
     /**
@@ -80,11 +85,21 @@ protected:
     std::vector<glm::vec2> _segments{};          /**< Contains line and curve segments of all glpyhs */
     std::vector<SegmentsInfo> _segmentsInfo{};   /**< Contains segment info of all glpyhs */
 
+    /**
+     * Contains horizontal bands of all glyphs, every glyph starts with offset and segment count of each band followed
+     * by segments of all bands. Segment is stored as its index into the segments buffer shifted left by one, the
+     * lowest bit is set for curve segments
+     */
+    std::vector<uint32_t> _bands{};
+
 public:
     WindingNumberTextRenderer();
     virtual ~WindingNumberTextRenderer() = default;
 
     virtual void update() override;
+
+protected:
+    void _appendBands(const std::vector<uint32_t> &bands, uint32_t segmentsStartIndex, uint32_t lineCount);
 };
 
 }  // namespace vft
@@ -0,0 +1,16 @@
+#version 450
+
+layout(location = 0) in vec4 fragColor;
+layout(location = 1) in vec2 fragUv;
+layout(location = 2) in float fragOrientation;
+
+layout(location = 0) out vec4 outColor;
+
+void main() {
+    // Curve is u^2 - v = 0, inner triangles have u^2 - v < 0 and positive orientation everywhere
+    if (fragOrientation * (fragUv.x * fragUv.x - fragUv.y) > 0.0) {
+        discard;
+    }
+
+    outColor = fragColor;
+}
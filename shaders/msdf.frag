@@ -0,0 +1,42 @@
+#version 450
+
+layout(location = 0) in vec2 fragUv;
+
+layout(location = 0) out vec4 outColor;
+
+layout(push_constant) uniform constants {
+	mat4 model;
+    vec4 color;
+    int useSoftEdges;
+    float softEdgeMin;
+    float softEdgeMax;
+} PushConstants;
+
+layout(set = 1, binding = 0) uniform sampler2D fontAtlas;
+
+float median(float r, float g, float b) {
+    return max(min(r, g), min(max(r, g), b));
+}
+
+void main() {
+    // Median of the three channels reconstructs the distance including sharp corners
+    vec3 channels = texture(fontAtlas, fragUv).rgb;
+    float distance = median(channels.r, channels.g, channels.b);
+
+    float alpha;
+    if(PushConstants.useSoftEdges == 0) {
+        // Alpha testing
+        alpha = distance > 0.5 ? 1.f : 0.f;
+    }
+    else {
+        // Alpha blending
+        alpha = smoothstep(PushConstants.softEdgeMin, PushConstants.softEdgeMax, distance);
+    }
+
+    outColor = PushConstants.color * vec4(1.f, 1.f, 1.f, alpha);
+
+    // Prevent z-fighting
+    if(alpha < 0.01) {
+        discard;
+    }
+}
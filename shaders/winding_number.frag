@@ -7,16 +7,22 @@ layout(location = 0) out vec4 outColor;
 layout(push_constant) uniform constants {
 	mat4 model;
     vec4 color;
-    uint lineSegmentsStartIndex;
-    uint lineSegmentsCount;
-    uint curveSegmentsStartIndex;
-    uint curveSegmentsCount;
+    uint bandsStartIndex;
+    uint bandCount;
+    float bandsBottom;
+    float bandsTop;
 } PushConstants;
 
 layout(set = 1, binding = 0) readonly buffer Segments {
     vec2 segments[];
 };
 
+// Offset and segment count of each glyph's band followed by segments sorted by max x in descending order
+// Segment is stored as its index into segments shifted left by one, the lowest bit is set for curve segments
+layout(set = 1, binding = 1) readonly buffer Bands {
+    uint bands[];
+};
+
 float rayIntersectsLineSegment(vec2 position, vec2 start, vec2 end) {
     // Check if ray and line segment are parallel
     // Winding should be unchanged
@@ -177,17 +183,54 @@ float rayIntersectsCurveSegment(vec2 position, vec2 start, vec2 control, vec2 en
     return winding;
 }
 
+uint getBand(float y) {
+    if(PushConstants.bandsTop <= PushConstants.bandsBottom) {
+        return 0;
+    }
+
+    float band = floor((y - PushConstants.bandsBottom) / (PushConstants.bandsTop - PushConstants.bandsBottom) * PushConstants.bandCount);
+    return uint(clamp(band, 0.f, float(PushConstants.bandCount - 1)));
+}
+
 void main() {
     float windingNumber = 0;
 
-    // Compute winding for line segments
-    for(uint i = PushConstants.lineSegmentsStartIndex; i < PushConstants.lineSegmentsStartIndex + 2 * PushConstants.lineSegmentsCount; i += 2) {
-        windingNumber += rayIntersectsLineSegment(fragmentPosition, segments[i], segments[i + 1]);
+    if(PushConstants.bandCount == 0) {
+        discard;
     }
-    
-    // Compute winding for curve segments
-    for(uint i = PushConstants.curveSegmentsStartIndex; i < PushConstants.curveSegmentsStartIndex + 3 * PushConstants.curveSegmentsCount; i += 3) {
-        windingNumber += rayIntersectsCurveSegment(fragmentPosition, segments[i], segments[i + 1], segments[i + 2]);
+
+    // Test only segments overlapping the fragment's horizontal band
+    uint band = PushConstants.bandsStartIndex + 2 * getBand(fragmentPosition.y);
+    uint bandStart = bands[band];
+    uint bandEnd = bandStart + bands[band + 1];
+
+    for(uint i = bandStart; i < bandEnd; i++) {
+        uint segment = bands[i];
+        uint index = segment >> 1;
+
+        if((segment & 1u) == 0) {
+            vec2 start = segments[index];
+            vec2 end = segments[index + 1];
+
+            // Segments are sorted by max x, so all remaining segments are on the left of the ray
+            if(max(start.x, end.x) < fragmentPosition.x) {
+                break;
+            }
+
+            windingNumber += rayIntersectsLineSegment(fragmentPosition, start, end);
+        }
+        else {
+            vec2 start = segments[index];
+            vec2 control = segments[index + 1];
+            vec2 end = segments[index + 2];
+
+            // Segments are sorted by max x, so all remaining segments are on the left of the ray
+            if(max(max(start.x, control.x), end.x) < fragmentPosition.x) {
+                break;
+            }
+
+            windingNumber += rayIntersectsCurveSegment(fragmentPosition, start, control, end);
+        }
     }
 
     if(windingNumber != 0) {
@@ -0,0 +1,118 @@
+/**
+ * @file edge_broad_phase.cpp
+ * @author Christian Saloň
+ */
+
+#include "edge_broad_phase.h"
+
+namespace vft {
+
+/**
+ * @brief Compare candidates by the order of edges in loops
+ *
+ * @param other Compared candidate
+ *
+ * @return True if edge of this candidate comes before edge of other candidate
+ */
+bool EdgeBroadPhase::Candidate::operator<(const Candidate &other) const {
+    return std::tie(this->loopIndex, this->edgeIndex) < std::tie(other.loopIndex, other.edgeIndex);
+}
+
+/**
+ * @brief EdgeBroadPhase constructor
+ *
+ * @param tolerance Distance by which bounding boxes can be apart and still be reported as overlapping
+ */
+EdgeBroadPhase::EdgeBroadPhase(double tolerance) : _tolerance{tolerance} {}
+
+/**
+ * @brief Compute and sort bounding boxes of all edges of given loops
+ *
+ * @param vertices Vertices of loops
+ * @param edges Edge pool containing loops
+ * @param loops Indices of loops whose edges are queried
+ */
+void EdgeBroadPhase::build(const std::vector<glm::vec2> &vertices,
+                           const EdgePool &edges,
+                           const std::vector<uint32_t> &loops) {
+    this->_bounds.clear();
+    this->_maxWidth = 0;
+
+    for (unsigned int i = 0; i < loops.size(); i++) {
+        uint32_t edge = edges.getFirst(loops[i]);
+        for (unsigned int j = 0; j < edges.getSize(loops[i]); j++) {
+            const glm::vec2 &start = vertices.at(edges[edge].value.first);
+            const glm::vec2 &end = vertices.at(edges[edge].value.second);
+
+            Bounds bounds{glm::min(start, end), glm::max(start, end), Candidate{i, j, edge}};
+            this->_maxWidth = std::max(this->_maxWidth, bounds.max.x - bounds.min.x);
+            this->_bounds.push_back(bounds);
+
+            edge = edges[edge].next;
+        }
+    }
+
+    std::sort(this->_bounds.begin(), this->_bounds.end(),
+              [](const Bounds &first, const Bounds &second) { return first.min.x < second.min.x; });
+}
+
+/**
+ * @brief Find edges whose bounding boxes overlap the bounding box of given edge
+ *
+ * @param start Start of given edge
+ * @param end End of given edge
+ *
+ * @return Candidates ordered by the order of edges in loops
+ */
+std::vector<EdgeBroadPhase::Candidate> EdgeBroadPhase::query(const glm::vec2 &start, const glm::vec2 &end) const {
+    glm::vec2 min = glm::min(start, end);
+    glm::vec2 max = glm::max(start, end);
+
+    // Only boxes whose left side lies in the slab can reach the queried box
+    double slabStart = static_cast<double>(min.x) - this->_maxWidth - this->_tolerance;
+    double slabEnd = static_cast<double>(max.x) + this->_tolerance;
+
+    auto it = std::lower_bound(this->_bounds.begin(), this->_bounds.end(), slabStart,
+                               [](const Bounds &bounds, double x) { return bounds.min.x < x; });
+
+    std::vector<Candidate> candidates;
+    for (; it != this->_bounds.end() && it->min.x <= slabEnd; it++) {
+        if (it->max.x >= min.x - this->_tolerance && it->min.y <= max.y + this->_tolerance &&
+            it->max.y >= min.y - this->_tolerance) {
+            candidates.push_back(it->candidate);
+        }
+    }
+
+    std::sort(candidates.begin(), candidates.end());
+
+    return candidates;
+}
+
+/**
+ * @brief Find all pairs of edges whose bounding boxes overlap, boxes are swept once in the order of their left sides
+ *
+ * @return Pairs of overlapping edges, the first candidate of each pair comes before the second one in loops
+ */
+std::vector<std::pair<EdgeBroadPhase::Candidate, EdgeBroadPhase::Candidate>> EdgeBroadPhase::getOverlappingPairs()
+    const {
+    std::vector<std::pair<Candidate, Candidate>> pairs;
+    for (auto first = this->_bounds.begin(); first != this->_bounds.end(); first++) {
+        // Boxes starting right of the first box can not overlap it and neither can any box after them
+        for (auto second = first + 1; second != this->_bounds.end() && second->min.x <= first->max.x + this->_tolerance;
+             second++) {
+            if (second->min.y > first->max.y + this->_tolerance || second->max.y < first->min.y - this->_tolerance) {
+                continue;
+            }
+
+            if (first->candidate < second->candidate) {
+                pairs.push_back({first->candidate, second->candidate});
+            } else {
+                pairs.push_back({second->candidate, first->candidate});
+            }
+        }
+    }
+
+    return pairs;
+}
+
+}  // namespace vft
@@ -0,0 +1,354 @@
+/**
+ * @file edge_pool.cpp
+ * @author Christian Saloň
+ */
+
+#include "edge_pool.h"
+
+namespace vft {
+
+/**
+ * @brief Delete all loops and edges, allocated memory is kept for reuse
+ */
+void EdgePool::clear() {
+    this->_nodes.clear();
+    this->_loops.clear();
+    this->_outgoing.clear();
+}
+
+/**
+ * @brief Add an empty loop
+ *
+ * @return Index of loop
+ */
+uint32_t EdgePool::addLoop() {
+    this->_loops.push_back(Loop{});
+    return this->_loops.size() - 1;
+}
+
+/**
+ * @brief Add loop containing edges of given outline in the same order
+ *
+ * @param outline Outline
+ *
+ * @return Index of loop
+ */
+uint32_t EdgePool::addLoop(const Outline &outline) {
+    uint32_t loop = this->addLoop();
+    this->_nodes.reserve(this->_nodes.size() + outline.edges.size());
+
+    for (const Edge &edge : outline.edges) {
+        this->insertLast(loop, edge);
+    }
+
+    return loop;
+}
+
+/**
+ * @brief Delete all edges of loop, the loop stays empty
+ *
+ * @param loop Index of loop
+ */
+void EdgePool::clearLoop(uint32_t loop) {
+    while (this->getSize(loop) > 0) {
+        this->erase(this->getFirst(loop));
+    }
+}
+
+/**
+ * @brief Insert edge at the end of loop
+ *
+ * @param loop Index of loop
+ * @param value Edge
+ *
+ * @return Index of inserted edge
+ */
+uint32_t EdgePool::insertLast(uint32_t loop, const Edge &value) {
+    if (this->getSize(loop) > 0) {
+        return this->insertAfter(this->_nodes[this->_loops[loop].first].previous, value);
+    }
+
+    uint32_t node = this->_createNode(value, loop);
+    this->_nodes[node].previous = node;
+    this->_nodes[node].next = node;
+
+    this->_loops[loop].first = node;
+    this->_loops[loop].size = 1;
+
+    return node;
+}
+
+/**
+ * @brief Insert edge after given edge into the same loop
+ *
+ * @param node Index of edge after which the new edge is inserted
+ * @param value Edge
+ *
+ * @return Index of inserted edge
+ *
+ * @throws std::invalid_argument When given edge was deleted
+ */
+uint32_t EdgePool::insertAfter(uint32_t node, const Edge &value) {
+    uint32_t loop = this->operator[](node).loop;
+    if (loop == NONE) {
+        throw std::invalid_argument("EdgePool::insertAfter(): Edge was deleted");
+    }
+
+    uint32_t inserted = this->_createNode(value, loop);
+    uint32_t next = this->_nodes[node].next;
+
+    this->_nodes[inserted].previous = node;
+    this->_nodes[inserted].next = next;
+    this->_nodes[next].previous = inserted;
+    this->_nodes[node].next = inserted;
+
+    this->_loops[loop].size++;
+
+    return inserted;
+}
+
+/**
+ * @brief Delete edge from its loop. Links of deleted edge are kept, so the edge that followed it can still be reached
+ *
+ * @param node Index of edge
+ *
+ * @throws std::invalid_argument When edge was already deleted
+ */
+void EdgePool::erase(uint32_t node) {
+    uint32_t loop = this->operator[](node).loop;
+    if (loop == NONE) {
+        throw std::invalid_argument("EdgePool::erase(): Edge was already deleted");
+    }
+
+    this->_unlinkOutgoing(node);
+
+    Loop &edges = this->_loops[loop];
+    if (edges.size == 1) {
+        edges.first = NONE;
+    } else {
+        this->_nodes[this->_nodes[node].previous].next = this->_nodes[node].next;
+        this->_nodes[this->_nodes[node].next].previous = this->_nodes[node].previous;
+
+        if (edges.first == node) {
+            edges.first = this->_nodes[node].next;
+        }
+    }
+
+    edges.size--;
+    this->_nodes[node].loop = NONE;
+}
+
+/**
+ * @brief Get edge at given index
+ *
+ * @param node Index of edge
+ *
+ * @return Edge
+ *
+ * @throws std::out_of_range When index is out of range
+ */
+EdgePool::Node &EdgePool::operator[](uint32_t node) {
+    if (node >= this->_nodes.size()) {
+        throw std::out_of_range("EdgePool::operator[](): Index is out of range");
+    }
+
+    return this->_nodes[node];
+}
+
+/**
+ * @brief Get edge at given index
+ *
+ * @param node Index of edge
+ *
+ * @return Edge
+ *
+ * @throws std::out_of_range When index is out of range
+ */
+const EdgePool::Node &EdgePool::operator[](uint32_t node) const {
+    if (node >= this->_nodes.size()) {
+        throw std::out_of_range("EdgePool::operator[](): Index is out of range");
+    }
+
+    return this->_nodes[node];
+}
+
+/**
+ * @brief Get the first edge of loop
+ *
+ * @param loop Index of loop
+ *
+ * @return Index of first edge, NONE if loop is empty
+ *
+ * @throws std::out_of_range When loop does not exist
+ */
+uint32_t EdgePool::getFirst(uint32_t loop) const {
+    if (loop >= this->_loops.size()) {
+        throw std::out_of_range("EdgePool::getFirst(): Index is out of range");
+    }
+
+    return this->_loops[loop].first;
+}
+
+/**
+ * @brief Get number of edges in loop
+ *
+ * @param loop Index of loop
+ *
+ * @return Edge count
+ *
+ * @throws std::out_of_range When loop does not exist
+ */
+unsigned int EdgePool::getSize(uint32_t loop) const {
+    if (loop >= this->_loops.size()) {
+        throw std::out_of_range("EdgePool::getSize(): Index is out of range");
+    }
+
+    return this->_loops[loop].size;
+}
+
+/**
+ * @brief Get number of loops
+ *
+ * @return Loop count
+ */
+unsigned int EdgePool::getLoopCount() const {
+    return this->_loops.size();
+}
+
+/**
+ * @brief Get position of edge in its loop counted from the first edge. Traverses the loop, so it should only be used
+ * to order a few edges
+ *
+ * @param node Index of edge
+ *
+ * @return Position of edge
+ *
+ * @throws std::invalid_argument When edge was deleted
+ */
+unsigned int EdgePool::getPosition(uint32_t node) const {
+    uint32_t loop = this->operator[](node).loop;
+    if (loop == NONE) {
+        throw std::invalid_argument("EdgePool::getPosition(): Edge was deleted");
+    }
+
+    unsigned int position = 0;
+    for (uint32_t current = this->_loops[loop].first; current != node; current = this->_nodes[current].next) {
+        position++;
+    }
+
+    return position;
+}
+
+/**
+ * @brief Copy edges of loop into outline
+ *
+ * @param loop Index of loop
+ * @param orientation Orientation of outline
+ *
+ * @return Outline with edges in the order of loop
+ */
+Outline EdgePool::getOutline(uint32_t loop, Outline::Orientation orientation) const {
+    Outline outline;
+    outline.orientation = orientation;
+    outline.edges.reserve(this->getSize(loop));
+
+    uint32_t node = this->getFirst(loop);
+    for (unsigned int i = 0; i < this->getSize(loop); i++) {
+        outline.edges.push_back(this->_nodes[node].value);
+        node = this->_nodes[node].next;
+    }
+
+    return outline;
+}
+
+/**
+ * @brief Get all edges of all loops that start at given vertex, in no particular order
+ *
+ * @param vertex Index of vertex
+ *
+ * @return Indices of edges
+ */
+std::vector<uint32_t> EdgePool::getEdgesStartingAt(uint32_t vertex) const {
+    std::vector<uint32_t> edges;
+    if (vertex >= this->_outgoing.size()) {
+        return edges;
+    }
+
+    for (uint32_t node = this->_outgoing[vertex]; node != NONE; node = this->_nodes[node].nextOutgoing) {
+        edges.push_back(node);
+    }
+
+    return edges;
+}
+
+/**
+ * @brief Get number of edges of one loop that start at given vertex
+ *
+ * @param vertex Index of vertex
+ * @param loop Index of loop
+ *
+ * @return Edge count
+ */
+unsigned int EdgePool::getEdgeCountStartingAt(uint32_t vertex, uint32_t loop) const {
+    unsigned int count = 0;
+    if (vertex >= this->_outgoing.size()) {
+        return count;
+    }
+
+    for (uint32_t node = this->_outgoing[vertex]; node != NONE; node = this->_nodes[node].nextOutgoing) {
+        if (this->_nodes[node].loop == loop) {
+            count++;
+        }
+    }
+
+    return count;
+}
+
+/**
+ * @brief Append unlinked edge to the arena
+ *
+ * @param value Edge
+ * @param loop Index of loop that will contain edge
+ *
+ * @return Index of edge
+ */
+uint32_t EdgePool::_createNode(const Edge &value, uint32_t loop) {
+    this->_nodes.push_back(Node{value, NONE, NONE, loop, NONE});
+
+    uint32_t node = this->_nodes.size() - 1;
+    this->_linkOutgoing(node);
+
+    return node;
+}
+
+/**
+ * @brief Add edge to the list of edges starting at its start vertex
+ *
+ * @param node Index of edge
+ */
+void EdgePool::_linkOutgoing(uint32_t node) {
+    uint32_t vertex = this->_nodes[node].value.first;
+    if (vertex >= this->_outgoing.size()) {
+        this->_outgoing.resize(vertex + 1, NONE);
+    }
+
+    this->_nodes[node].nextOutgoing = this->_outgoing[vertex];
+    this->_outgoing[vertex] = node;
+}
+
+/**
+ * @brief Remove edge from the list of edges starting at its start vertex
+ *
+ * @param node Index of edge
+ */
+void EdgePool::_unlinkOutgoing(uint32_t node) {
+    uint32_t *link = &this->_outgoing[this->_nodes[node].value.first];
+    while (*link != node) {
+        link = &this->_nodes[*link].nextOutgoing;
+    }
+
+    *link = this->_nodes[node].nextOutgoing;
+    this->_nodes[node].nextOutgoing = NONE;
+}
+
+}  // namespace vft
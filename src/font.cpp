@@ -12,20 +12,12 @@ namespace vft {
  *
  * @param fontFile Path to font file
  */
-Font::Font(std::string fontFile) {
+Font::Font(std::string fontFile) : _fontFile{fontFile} {
     if (fontFile.empty()) {
         throw std::runtime_error("Font::Font(): Path to .ttf file was not entered");
     }
 
-    if (FT_Init_FreeType(&(this->_ft))) {
-        throw std::runtime_error("Font::Font(): Error initializing freetype");
-    }
-
-    if (FT_New_Face(this->_ft, fontFile.c_str(), 0, &this->_face)) {
-        throw std::runtime_error("Font::Font(): Error loading font face, check path to .ttf file");
-    }
-
-    FT_Set_Pixel_Sizes(this->_face, this->_pixelSize, 0);
+    this->_createFace(this->_ft, this->_face);
 }
 
 /**
@@ -34,25 +26,38 @@ Font::Font(std::string fontFile) {
  * @param buffer Pointer to memory where the font is stored
  * @param size Size of buffer
  */
-Font::Font(uint8_t *buffer, long size) {
+Font::Font(uint8_t *buffer, long size) : _buffer{buffer}, _bufferSize{size} {
     if (size <= 0) {
         throw std::runtime_error("Font::Font(): Buffer size must be greater than zero");
     }
 
-    if (FT_Init_FreeType(&(this->_ft))) {
-        throw std::runtime_error("Font::Font(): Error initializing freetype");
-    }
+    this->_createFace(this->_ft, this->_face);
+}
 
-    if (FT_New_Memory_Face(this->_ft, buffer, size, 0, &this->_face)) {
-        throw std::runtime_error("Font::Font(): Error loading font from memory");
+/**
+ * @brief Font destructor, releases all freetype faces and libraries created for this font
+ */
+Font::~Font() {
+    {
+        // Faces of threads that have not exited yet, the others were released by their threads
+        std::unique_lock lock{this->_threadFaces->mutex};
+        for (auto &[threadId, threadFace] : this->_threadFaces->faces) {
+            Font::_releaseFace(threadFace);
+        }
+
+        this->_threadFaces->faces.clear();
     }
 
-    FT_Set_Pixel_Sizes(this->_face, this->_pixelSize, 0);
+    FT_Done_Face(this->_face);
+    FT_Done_FreeType(this->_ft);
 }
 
 /**
  * @brief Set pixel size of freetype font using FT_Set_Pixel_Sizes()
  *
+ * Changes the shared face, so it must not be called while other threads use the font. Faces returned by
+ * getThreadFace() are not affected
+ *
  * @param pixelSize New pixel size
  */
 void Font::setPixelSize(unsigned int pixelSize) {
@@ -101,4 +106,133 @@ FT_Face Font::getFace() const {
     return this->_face;
 }
 
+/**
+ * @brief Get freetype font face owned by the calling thread. The face is created on first use in each thread and is
+ * released when the thread exits or the font is destroyed. Loading glyphs or changing the pixel size of this face does
+ * not affect other threads
+ *
+ * @return Handle to freetype font face of calling thread
+ */
+FT_Face Font::getThreadFace() const {
+    std::thread::id threadId = std::this_thread::get_id();
+
+    {
+        std::shared_lock lock{this->_threadFaces->mutex};
+        auto it = this->_threadFaces->faces.find(threadId);
+        if (it != this->_threadFaces->faces.end()) {
+            return it->second.face;
+        }
+    }
+
+    // Each thread needs its own freetype library, libraries are not thread safe either
+    ThreadFace threadFace{};
+    this->_createFace(threadFace.library, threadFace.face);
+
+    {
+        std::unique_lock lock{this->_threadFaces->mutex};
+        this->_threadFaces->faces.insert({threadId, threadFace});
+    }
+
+    // Short-lived threads (e.g. rasterizing a font atlas) would otherwise leave their faces behind until the font is
+    // destroyed
+    thread_local ThreadFaceOwner owner{};
+    std::erase_if(owner.fonts, [](const std::weak_ptr<ThreadFaces> &font) { return font.expired(); });
+    owner.fonts.push_back(this->_threadFaces);
+
+    return threadFace.face;
+}
+
+/**
+ * @brief Get 64-bit FNV-1a hash of the font data. Fonts loaded from identical files have the same hash regardless of
+ * their path. The hash is computed on first use
+ *
+ * @return Hash of font contents
+ */
+uint64_t Font::getContentHash() const {
+    std::call_once(this->_contentHashFlag, [this]() {
+        uint64_t hash = 14695981039346656037ull;
+        auto update = [&hash](const uint8_t *data, std::size_t size) {
+            for (std::size_t i = 0; i < size; i++) {
+                hash ^= data[i];
+                hash *= 1099511628211ull;
+            }
+        };
+
+        if (this->_buffer != nullptr) {
+            update(this->_buffer, static_cast<std::size_t>(this->_bufferSize));
+        } else {
+            std::ifstream file{this->_fontFile, std::ios::binary};
+            if (!file.is_open()) {
+                throw std::runtime_error("Font::getContentHash(): Error opening font file");
+            }
+
+            char chunk[65536];
+            while (file.read(chunk, sizeof(chunk)) || file.gcount() > 0) {
+                update(reinterpret_cast<const uint8_t *>(chunk), static_cast<std::size_t>(file.gcount()));
+            }
+        }
+
+        this->_contentHash = hash;
+    });
+
+    return this->_contentHash;
+}
+
+/**
+ * @brief Initialize freetype library and load font face from the same source as this font
+ *
+ * @param library Initialized freetype library
+ * @param face Loaded freetype font face
+ */
+void Font::_createFace(FT_Library &library, FT_Face &face) const {
+    if (FT_Init_FreeType(&library)) {
+        throw std::runtime_error("Font::_createFace(): Error initializing freetype");
+    }
+
+    if (this->_buffer != nullptr) {
+        if (FT_New_Memory_Face(library, this->_buffer, this->_bufferSize, 0, &face)) {
+            FT_Done_FreeType(library);
+            throw std::runtime_error("Font::_createFace(): Error loading font from memory");
+        }
+    } else {
+        if (FT_New_Face(library, this->_fontFile.c_str(), 0, &face)) {
+            FT_Done_FreeType(library);
+            throw std::runtime_error("Font::_createFace(): Error loading font face, check path to .ttf file");
+        }
+    }
+
+    FT_Set_Pixel_Sizes(face, this->_pixelSize, 0);
+}
+
+/**
+ * @brief Release freetype font face and library of one thread
+ *
+ * @param threadFace Library and face to release
+ */
+void Font::_releaseFace(ThreadFace &threadFace) {
+    FT_Done_Face(threadFace.face);
+    FT_Done_FreeType(threadFace.library);
+}
+
+/**
+ * @brief Release faces of the exiting thread in all fonts that still exist
+ */
+Font::ThreadFaceOwner::~ThreadFaceOwner() {
+    std::thread::id threadId = std::this_thread::get_id();
+
+    for (const std::weak_ptr<ThreadFaces> &font : this->fonts) {
+        std::shared_ptr<ThreadFaces> threadFaces = font.lock();
+        if (threadFaces == nullptr) {
+            continue;
+        }
+
+        std::unique_lock lock{threadFaces->mutex};
+        auto it = threadFaces->faces.find(threadId);
+        if (it != threadFaces->faces.end()) {
+            Font::_releaseFace(it->second);
+            threadFaces->faces.erase(it);
+        }
+    }
+}
+
 }  // namespace vft
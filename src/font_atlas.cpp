@@ -8,134 +8,174 @@
 namespace vft {
 
 /**
- * @brief Construct texture containing sdfs of selected glyphs using the freetype sdf rasterizer
+ * @brief Construct texture containing sdfs of selected glyphs using the freetype sdf rasterizer or msdfs generated from
+ * glyph outlines
  *
  * @param font Font used to rasterize glyphs into sdfs
- * @param fontSize Font size of rasterized glyphs
+ * @param fontSize Size in pixels of em square of msdfs, sdfs are always rasterized at SDF_GLYPH_SIZE
  * @param glyphIds Glyph indices to rasterize
+ * @param type Type of distance field stored in font atlas
+ * @param threadCount Number of threads rasterizing glyphs, 0 uses all hardware threads
+ * @param padding Number of empty pixels around each glyph bitmap
+ *
+ * @throws std::invalid_argument When msdfs are rasterized with font size 0
  */
-FontAtlas::FontAtlas(std::shared_ptr<Font> font, unsigned int fontSize, std::vector<uint32_t> glyphIds)
-    : _fontFamily{font->getFontFamily()} {
-    // Set size of each glyph bitmap to approximetly 64 x 64
-    // Freetype does not produce exact size of bitmap
-    unsigned int oldPixelSize = font->getPixelSize();
-    font->setPixelSize(64);
-
-    // Load bitmap for all glyphs
-    std::unordered_map<BitmapInfo, std::vector<uint8_t>, BitmapInfoHash> bitmaps;
-    for (uint32_t glyphId : glyphIds) {
-        // Generate sdf bitmap for glyph
-        if (FT_Load_Glyph(font->getFace(), glyphId, FT_LOAD_RENDER)) {
-            throw std::runtime_error("FontAtlas::FontAtlas(): Error loading glyph");
-        }
-        if (FT_Render_Glyph(font->getFace()->glyph, FT_RENDER_MODE_SDF)) {
-            throw std::runtime_error("FontAtlas::FontAtlas(): Error rasterizing sdf bitmap");
-        }
-        FT_GlyphSlot slot = font->getFace()->glyph;
-        const FT_Bitmap &bitmap = slot->bitmap;
-
-        if (bitmap.width == 0 || bitmap.rows == 0) {
-            bitmaps.insert({BitmapInfo{glyphId, 0, 0}, {}});
-            continue;
-        }
-
-        // Write data into glyph bitmap
-        std::vector<uint8_t> texture;
-        for (unsigned int i = 0; i < bitmap.width * bitmap.rows; i++) {
-            texture.push_back(bitmap.buffer[i]);
-        }
-
-        bitmaps.insert({BitmapInfo{glyphId, bitmap.width, bitmap.rows}, texture});
+FontAtlas::FontAtlas(std::shared_ptr<Font> font,
+                     unsigned int fontSize,
+                     std::vector<uint32_t> glyphIds,
+                     Type type,
+                     unsigned int threadCount,
+                     unsigned int padding)
+    : _fontFamily{font->getFontFamily()},
+      _type{type},
+      _fontSize{fontSize},
+      _threadCount{threadCount},
+      _padding{padding} {
+    if (this->_type == Type::MSDF && this->_fontSize == 0) {
+        throw std::invalid_argument("FontAtlas::FontAtlas(): Font size of msdf font atlas must be greater than 0");
     }
 
-    // Reset to old pixel size
-    font->setPixelSize(oldPixelSize);
+    // Remove duplicate glyph ids, glyphs are packed in the order of their first occurrence
+    std::unordered_set<uint32_t> uniqueGlyphIds;
+    std::erase_if(glyphIds, [&](uint32_t glyphId) { return !uniqueGlyphIds.insert(glyphId).second; });
 
-    // Calculate the total area of all glyph bitmaps
-    unsigned int area = 0;
-    for (const auto &bitmap : bitmaps) {
-        area += bitmap.first.width * bitmap.first.height;
-    }
-
-    // Get the size of texture needed to store all glyphs
-    // Texture is a square where length is a power of two
-    unsigned int size = 128;
-    while (area * 1.5 > size * size) {
-        size *= 2;
-    }
+    // Load bitmap for all glyphs, the result does not depend on the number of threads
+    std::vector<std::pair<BitmapInfo, std::vector<uint8_t>>> bitmaps =
+        this->_rasterizeGlyphs(font, this->_fontSize, glyphIds, this->_threadCount);
 
-    // Set texture width and height
-    this->_width = size;
-    this->_height = size;
+    // Pack glyph bitmaps, sets the size of texture
+    std::vector<glm::uvec2> positions = this->_packBitmaps(bitmaps);
 
     // Initialize texture to zeros
-    this->_texture.assign(this->_width * this->_height, 0);
-
-    glm::uvec2 pen{0, 0};  // Current position in texture
-    unsigned int currentRowHeight = 0;
+    this->_texture.assign(this->_width * this->_height * this->getChannelCount(), 0);
 
     // Store glyph bitmaps into texture
-    for (const auto &bitmap : bitmaps) {
-        // Check if glyph will fit on current row in texture
-        if (pen.x + bitmap.first.width > this->_width) {
-            pen.x = 0;
-            pen.y += currentRowHeight;
-            currentRowHeight = 0;
-        }
-
-        // Write bitmap data into atlas texture
-        for (unsigned int y = 0; y < bitmap.first.height; y++) {
-            for (unsigned int x = 0; x < bitmap.first.width; x++) {
-                uint8_t pixel = bitmap.second[y * bitmap.first.width + x];
-                this->_texture[(pen.y + y) * this->_width + (pen.x + x)] = pixel;
-            }
-        }
-
-        // Calculate uvs
-        glm::vec2 uvTopLeft{pen.x / static_cast<float>(this->_width), pen.y / static_cast<float>(this->_height)};
-        glm::vec2 uvBottomRight{(pen.x + bitmap.first.width) / static_cast<float>(this->_width),
-                                (pen.y + bitmap.first.height) / static_cast<float>(this->_height)};
-
-        // Insert glyph data
-        this->_glyphs.insert({bitmap.first.glyphId, GlyphInfo{uvTopLeft, uvBottomRight}});
-
-        // Update texture pen position
-        pen.x += bitmap.first.width;
-        currentRowHeight = std::max(currentRowHeight, bitmap.first.height);
+    for (std::size_t i = 0; i < bitmaps.size(); i++) {
+        this->_storeBitmap(bitmaps[i].first, bitmaps[i].second, positions[i]);
     }
 }
 
 /**
- * @brief Construct texture containing sdfs of selected unicode code points using the freetype sdf rasterizer
+ * @brief Construct texture containing sdfs of selected unicode code points using the freetype sdf rasterizer or msdfs
+ * generated from glyph outlines
  *
  * @param font Font used to rasterize glyphs into sdfs
- * @param fontSize Font size of rasterized glyphs
+ * @param fontSize Size in pixels of em square of msdfs, sdfs are always rasterized at SDF_GLYPH_SIZE
  * @param characterRanges Ranges of unicode code points to rasterize
+ * @param type Type of distance field stored in font atlas
+ * @param threadCount Number of threads rasterizing glyphs, 0 uses all hardware threads
+ * @param padding Number of empty pixels around each glyph bitmap
+ *
+ * @throws std::invalid_argument When msdfs are rasterized with font size 0
  */
-FontAtlas::FontAtlas(std::shared_ptr<Font> font, unsigned int fontSize, std::vector<CharacterRange> characterRanges)
-    : FontAtlas{font, fontSize, this->_getRangesGlyphIds(font, characterRanges)} {}
+FontAtlas::FontAtlas(std::shared_ptr<Font> font,
+                     unsigned int fontSize,
+                     std::vector<CharacterRange> characterRanges,
+                     Type type,
+                     unsigned int threadCount,
+                     unsigned int padding)
+    : FontAtlas{font, fontSize, this->_getRangesGlyphIds(font, characterRanges), type, threadCount, padding} {}
 
 /**
- * @brief Construct texture containing sdfs of selected utf-32 encoded characters using the freetype sdf rasterizer
+ * @brief Construct texture containing sdfs of selected utf-32 encoded characters using the freetype sdf rasterizer or
+ * msdfs generated from glyph outlines
  *
  * @param font Font used to rasterize glyphs into sdfs
- * @param fontSize Font size of rasterized glyphs
+ * @param fontSize Size in pixels of em square of msdfs, sdfs are always rasterized at SDF_GLYPH_SIZE
  * @param characters Utf-32 encoded characters to rasterize
+ * @param type Type of distance field stored in font atlas
+ * @param threadCount Number of threads rasterizing glyphs, 0 uses all hardware threads
+ * @param padding Number of empty pixels around each glyph bitmap
+ *
+ * @throws std::invalid_argument When msdfs are rasterized with font size 0
  */
-FontAtlas::FontAtlas(std::shared_ptr<Font> font, unsigned int fontSize, std::u32string characters)
-    : FontAtlas{font, fontSize, this->_getUtf32GlyphIds(font, characters)} {}
+FontAtlas::FontAtlas(std::shared_ptr<Font> font,
+                     unsigned int fontSize,
+                     std::u32string characters,
+                     Type type,
+                     unsigned int threadCount,
+                     unsigned int padding)
+    : FontAtlas{font, fontSize, this->_getUtf32GlyphIds(font, characters), type, threadCount, padding} {}
 
 /**
- * @brief Construct texture containing sdfs of all glyphs in font file using the freetype sdf rasterizer
+ * @brief Construct texture containing sdfs of all glyphs in font file using the freetype sdf rasterizer or msdfs
+ * generated from glyph outlines
  *
  * @param font Font used to rasterize glyphs into sdfs
- * @param fontSize Font size of rasterized glyphs
+ * @param fontSize Size in pixels of em square of msdfs, sdfs are always rasterized at SDF_GLYPH_SIZE
+ * @param type Type of distance field stored in font atlas
+ * @param threadCount Number of threads rasterizing glyphs, 0 uses all hardware threads
+ * @param padding Number of empty pixels around each glyph bitmap
+ *
+ * @throws std::invalid_argument When msdfs are rasterized with font size 0
+ */
+FontAtlas::FontAtlas(std::shared_ptr<Font> font,
+                     unsigned int fontSize,
+                     Type type,
+                     unsigned int threadCount,
+                     unsigned int padding)
+    : FontAtlas{font, fontSize, this->_getAllGlyphIds(font), type, threadCount, padding} {}
+
+/**
+ * @brief Rasterize glyphs missing in font atlas and pack them next to the existing ones. The texture grows when they do
+ * not fit into it, existing glyphs keep their positions in pixels, but their UVs change. Bitmaps of glyphs added after
+ * the texture was released are kept as pending uploads
+ *
+ * @param font Font used to rasterize glyphs, it must be the font the atlas was created from
+ * @param glyphIds Glyph indices to add, glyphs already in the atlas are skipped
+ */
+void FontAtlas::addGlyphs(std::shared_ptr<Font> font, std::vector<uint32_t> glyphIds) {
+    std::unordered_set<uint32_t> uniqueGlyphIds;
+    std::erase_if(glyphIds, [&](uint32_t glyphId) {
+        return this->_glyphs.contains(glyphId) || !uniqueGlyphIds.insert(glyphId).second;
+    });
+    if (glyphIds.empty()) {
+        return;
+    }
+
+    std::vector<std::pair<BitmapInfo, std::vector<uint8_t>>> bitmaps =
+        this->_rasterizeGlyphs(font, this->_fontSize, glyphIds, this->_threadCount);
+
+    for (std::size_t i = 0; i < bitmaps.size(); i++) {
+        if (bitmaps[i].first.width == 0 || bitmaps[i].first.height == 0) {
+            this->_storeBitmap(bitmaps[i].first, bitmaps[i].second, glm::uvec2{0, 0});
+        }
+    }
+
+    for (std::size_t i : FontAtlas::_getPackingOrder(bitmaps)) {
+        glm::uvec2 allocation{bitmaps[i].first.width + this->_padding, bitmaps[i].first.height + this->_padding};
+
+        std::optional<glm::uvec2> position = this->_packer.findPosition(allocation.x);
+        while (!position.has_value() || position.value().y + allocation.y + this->_padding > this->_height) {
+            // Grow the shorter side of texture, texture is widened if the bitmap is wider than the texture
+            if (!position.has_value() || this->_width <= this->_height) {
+                this->_resize(this->_width * 2, this->_height);
+            } else {
+                this->_resize(this->_width, this->_height * 2);
+            }
+
+            position = this->_packer.findPosition(allocation.x);
+        }
+
+        this->_packer.insert(allocation.x, allocation.y);
+        this->_storeBitmap(bitmaps[i].first, bitmaps[i].second,
+                           position.value() + glm::uvec2{this->_padding, this->_padding});
+    }
+}
+
+/**
+ * @brief Check whether font atlas contains glyph
+ *
+ * @param glyphId Glyph index
+ *
+ * @return True if glyph is in font atlas, else false
  */
-FontAtlas::FontAtlas(std::shared_ptr<Font> font, unsigned int fontSize)
-    : FontAtlas{font, fontSize, this->_getAllGlyphIds(font)} {}
+bool FontAtlas::contains(uint32_t glyphId) const {
+    return this->_glyphs.contains(glyphId);
+}
 
 /**
- * @brief Get glyph info (UVs) of selected glyph
+ * @brief Get glyph info (UVs) of selected glyph, UVs are relative to the current size of texture
  *
  * @param glyphId Glyph index of selected glyph
  *
@@ -146,7 +186,10 @@ FontAtlas::GlyphInfo FontAtlas::getGlyph(uint32_t glyphId) const {
         throw std::invalid_argument("FontAtlas::getGlyph(): Font atlas does not contain glyph with given glyph id");
     }
 
-    return this->_glyphs.at(glyphId);
+    const Region &region = this->_glyphs.at(glyphId);
+    glm::vec2 size{static_cast<float>(this->_width), static_cast<float>(this->_height)};
+
+    return GlyphInfo{glm::vec2{region.position} / size, glm::vec2{region.position + region.size} / size};
 }
 
 /**
@@ -158,6 +201,24 @@ std::string FontAtlas::getFontFamily() const {
     return this->_fontFamily;
 }
 
+/**
+ * @brief Getter for type of distance field stored in font atlas
+ *
+ * @return Type of distance field
+ */
+FontAtlas::Type FontAtlas::getType() const {
+    return this->_type;
+}
+
+/**
+ * @brief Get number of bytes of one texture pixel, msdfs are stored in rgba pixels
+ *
+ * @return Number of channels of texture
+ */
+unsigned int FontAtlas::getChannelCount() const {
+    return this->_type == Type::MSDF ? MsdfGenerator::CHANNEL_COUNT : 1;
+}
+
 /**
  * @brief Getter for the size of final texture
  *
@@ -167,15 +228,338 @@ glm::uvec2 FontAtlas::getSize() const {
     return glm::uvec2{this->_width, this->_height};
 }
 
+/**
+ * @brief Getter for ratio of texture area covered by glyph bitmaps, the rest is padding and unused space
+ *
+ * @return Occupancy of texture from 0 to 1
+ */
+double FontAtlas::getOccupancy() const {
+    return static_cast<double>(this->_usedArea) / (static_cast<uint64_t>(this->_width) * this->_height);
+}
+
 /**
  * @brief Get raw bytes of texture
  *
- * @return Vector of bytes containing texture data
+ * @return Vector of bytes containing texture data, it is empty if the texture was released
  */
 const std::vector<uint8_t> &FontAtlas::getTexture() const {
     return this->_texture;
 }
 
+/**
+ * @brief Free texture after it was uploaded to the gpu, glyphs added later are kept as pending uploads
+ */
+void FontAtlas::releaseTexture() {
+    this->_texture = std::vector<uint8_t>{};
+    this->_isTextureReleased = true;
+}
+
+/**
+ * @brief Check whether texture was released after upload to the gpu
+ *
+ * @return True if texture was released, else false
+ */
+bool FontAtlas::isTextureReleased() const {
+    return this->_isTextureReleased;
+}
+
+/**
+ * @brief Getter for glyph bitmaps added after the texture was released, which are not uploaded to the gpu yet
+ *
+ * @return Pending uploads in the order glyphs were added
+ */
+const std::vector<FontAtlas::Upload> &FontAtlas::getPendingUploads() const {
+    return this->_pendingUploads;
+}
+
+/**
+ * @brief Free pending uploads after they were uploaded to the gpu
+ */
+void FontAtlas::clearPendingUploads() {
+    this->_pendingUploads = std::vector<Upload>{};
+}
+
+/**
+ * @brief Pack glyph bitmaps into texture using the skyline packer and set the size of texture. Bitmaps are packed from
+ * the tallest one, ties are broken by width and then by the order of bitmaps, so the layout is deterministic. Texture
+ * widths that are powers of two are tried and the one resulting in the smallest texture is used, the height of texture
+ * is the height of packed bitmaps
+ *
+ * @param bitmaps Glyph info and bytes of bitmaps
+ *
+ * @return Positions of top left corners of bitmaps in texture, empty bitmaps are at the origin
+ */
+std::vector<glm::uvec2> FontAtlas::_packBitmaps(
+    const std::vector<std::pair<BitmapInfo, std::vector<uint8_t>>> &bitmaps) {
+    unsigned int padding = this->_padding;
+    std::vector<std::size_t> order = FontAtlas::_getPackingOrder(bitmaps);
+
+    // Every bitmap occupies its padding on the right and bottom side, padding on the left and top side of texture is
+    // excluded from the packing area
+    uint64_t area = 0;
+    unsigned int maxWidth = 0;
+    for (std::size_t i : order) {
+        area += static_cast<uint64_t>(bitmaps[i].first.width + padding) * (bitmaps[i].first.height + padding);
+        maxWidth = std::max(maxWidth, bitmaps[i].first.width + padding);
+    }
+
+    // Texture is at most as wide as a square of the same area rounded up to a power of two, so that long narrow
+    // textures do not exceed the max image size of devices
+    unsigned int minTextureWidth = std::bit_ceil(std::max(maxWidth + padding, 1u));
+    unsigned int maxTextureWidth =
+        std::max(minTextureWidth, std::bit_ceil(static_cast<unsigned int>(std::ceil(std::sqrt(area)))));
+
+    std::vector<glm::uvec2> positions(bitmaps.size(), glm::uvec2{0, 0});
+    uint64_t bestArea = UINT64_MAX;
+    for (unsigned int width = minTextureWidth; width <= maxTextureWidth; width *= 2) {
+        SkylinePacker packer{width - padding};
+        std::vector<glm::uvec2> candidatePositions(bitmaps.size(), glm::uvec2{0, 0});
+        for (std::size_t i : order) {
+            glm::uvec2 position =
+                packer.insert(bitmaps[i].first.width + padding, bitmaps[i].first.height + padding).value();
+            candidatePositions[i] = position + glm::uvec2{padding, padding};
+        }
+
+        unsigned int height = std::max(packer.getHeight() + padding, 1u);
+        if (static_cast<uint64_t>(width) * height < bestArea) {
+            bestArea = static_cast<uint64_t>(width) * height;
+            positions = std::move(candidatePositions);
+            this->_packer = packer;
+            this->_width = width;
+            this->_height = height;
+        }
+    }
+
+    return positions;
+}
+
+/**
+ * @brief Get order in which bitmaps are packed, from the tallest one, ties are broken by width and then by the order
+ * of bitmaps
+ *
+ * @param bitmaps Glyph info and bytes of bitmaps
+ *
+ * @return Indices of bitmaps that are not empty in packing order
+ */
+std::vector<std::size_t> FontAtlas::_getPackingOrder(
+    const std::vector<std::pair<BitmapInfo, std::vector<uint8_t>>> &bitmaps) {
+    std::vector<std::size_t> order;
+    for (std::size_t i = 0; i < bitmaps.size(); i++) {
+        if (bitmaps[i].first.width > 0 && bitmaps[i].first.height > 0) {
+            order.push_back(i);
+        }
+    }
+
+    std::stable_sort(order.begin(), order.end(), [&](std::size_t first, std::size_t second) {
+        const BitmapInfo &a = bitmaps[first].first;
+        const BitmapInfo &b = bitmaps[second].first;
+        return a.height != b.height ? a.height > b.height : a.width > b.width;
+    });
+
+    return order;
+}
+
+/**
+ * @brief Store glyph bitmap at given position. The bitmap is written into texture, or kept as pending upload if the
+ * texture was released
+ *
+ * @param info Glyph index and size of bitmap
+ * @param bitmap Bytes of bitmap, they are moved into pending upload
+ * @param position Position of top left corner of bitmap in texture
+ */
+void FontAtlas::_storeBitmap(const BitmapInfo &info, std::vector<uint8_t> &bitmap, const glm::uvec2 &position) {
+    glm::uvec2 size{info.width, info.height};
+
+    if (info.width > 0 && info.height > 0) {
+        if (this->_isTextureReleased) {
+            this->_pendingUploads.push_back(Upload{Region{position, size}, std::move(bitmap)});
+        } else {
+            // Write bitmap data into atlas texture, rows of bitmap are copied at once including all channels
+            unsigned int channelCount = this->getChannelCount();
+            for (unsigned int y = 0; y < info.height; y++) {
+                auto row = bitmap.begin() + y * info.width * channelCount;
+                std::copy(row, row + info.width * channelCount,
+                          this->_texture.begin() + ((position.y + y) * this->_width + position.x) * channelCount);
+            }
+        }
+    }
+
+    this->_glyphs.insert({info.glyphId, Region{position, size}});
+    this->_usedArea += static_cast<uint64_t>(info.width) * info.height;
+}
+
+/**
+ * @brief Resize texture, its content stays in the top left corner and the new area is empty
+ *
+ * @param width New width of texture, it must not be smaller than the current width
+ * @param height New height of texture, it must not be smaller than the current height
+ */
+void FontAtlas::_resize(unsigned int width, unsigned int height) {
+    if (!this->_isTextureReleased) {
+        unsigned int channelCount = this->getChannelCount();
+        std::vector<uint8_t> texture(static_cast<std::size_t>(width) * height * channelCount, 0);
+        for (unsigned int y = 0; y < this->_height; y++) {
+            auto row = this->_texture.begin() + y * this->_width * channelCount;
+            std::copy(row, row + this->_width * channelCount, texture.begin() + y * width * channelCount);
+        }
+
+        this->_texture = std::move(texture);
+    }
+
+    this->_packer.setWidth(width - this->_padding);
+    this->_width = width;
+    this->_height = height;
+}
+
+/**
+ * @brief Rasterize bitmaps of glyphs in parallel. Workers take glyphs one by one, each of them rasterizes glyphs using
+ * its own freetype face
+ *
+ * @param font Font used to rasterize glyphs
+ * @param fontSize Size in pixels of em square of msdfs
+ * @param glyphIds Glyph indices to rasterize
+ * @param threadCount Number of threads rasterizing glyphs including the calling thread, 0 uses all hardware threads.
+ * Every thread rasterizes at least MIN_GLYPHS_PER_THREAD glyphs
+ *
+ * @return Glyph info and bytes of bitmaps in the order of glyph indices
+ *
+ * @throws First exception thrown while rasterizing glyphs
+ */
+std::vector<std::pair<FontAtlas::BitmapInfo, std::vector<uint8_t>>> FontAtlas::_rasterizeGlyphs(
+    std::shared_ptr<Font> font,
+    unsigned int fontSize,
+    const std::vector<uint32_t> &glyphIds,
+    unsigned int threadCount) const {
+    std::vector<std::pair<BitmapInfo, std::vector<uint8_t>>> bitmaps(glyphIds.size());
+
+    unsigned int total = glyphIds.size();
+    if (threadCount == 0) {
+        threadCount = std::max(std::thread::hardware_concurrency(), 1u);
+    }
+    threadCount = std::min(threadCount, std::max((total + MIN_GLYPHS_PER_THREAD - 1) / MIN_GLYPHS_PER_THREAD, 1u));
+
+    std::atomic<unsigned int> nextGlyph{0};
+    std::exception_ptr error{nullptr};
+    std::mutex errorMutex;
+
+    auto work = [&]() {
+        try {
+            // Set size of each glyph bitmap to approximetly 64 x 64
+            // Freetype does not produce exact size of bitmap
+            // Only the face of current thread is resized, so the font can be used by other threads meanwhile
+            FT_Face face = font->getThreadFace();
+            FT_Set_Pixel_Sizes(face, FontAtlas::SDF_GLYPH_SIZE, FontAtlas::SDF_GLYPH_SIZE);
+
+            for (unsigned int i = nextGlyph++; i < total; i = nextGlyph++) {
+                bitmaps[i].first = this->_type == Type::MSDF
+                                       ? this->_rasterizeMsdf(face, glyphIds[i], fontSize, bitmaps[i].second)
+                                       : this->_rasterizeSdf(face, glyphIds[i], bitmaps[i].second);
+            }
+        } catch (...) {
+            std::lock_guard lock{errorMutex};
+            if (error == nullptr) {
+                error = std::current_exception();
+            }
+
+            // Stop other workers
+            nextGlyph = total;
+        }
+    };
+
+    // Calling thread rasterizes glyphs as well
+    std::vector<std::thread> threads;
+    for (unsigned int i = 1; i < threadCount; i++) {
+        threads.emplace_back(work);
+    }
+    work();
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+
+    if (error != nullptr) {
+        std::rethrow_exception(error);
+    }
+
+    return bitmaps;
+}
+
+/**
+ * @brief Rasterize sdf bitmap of glyph using the freetype sdf rasterizer
+ *
+ * @param face Freetype face set to SDF_GLYPH_SIZE
+ * @param glyphId Glyph index to rasterize
+ * @param bitmap Bytes of sdf bitmap
+ *
+ * @return Glyph index and size of bitmap
+ */
+FontAtlas::BitmapInfo FontAtlas::_rasterizeSdf(FT_Face face, uint32_t glyphId, std::vector<uint8_t> &bitmap) const {
+    // Generate sdf bitmap for glyph
+    if (FT_Load_Glyph(face, glyphId, FT_LOAD_RENDER)) {
+        throw std::runtime_error("FontAtlas::_rasterizeSdf(): Error loading glyph");
+    }
+    if (FT_Render_Glyph(face->glyph, FT_RENDER_MODE_SDF)) {
+        throw std::runtime_error("FontAtlas::_rasterizeSdf(): Error rasterizing sdf bitmap");
+    }
+    const FT_Bitmap &sdf = face->glyph->bitmap;
+
+    if (sdf.width == 0 || sdf.rows == 0) {
+        return BitmapInfo{glyphId, 0, 0};
+    }
+
+    // Write data into glyph bitmap
+    bitmap.assign(sdf.buffer, sdf.buffer + sdf.width * sdf.rows);
+
+    return BitmapInfo{glyphId, sdf.width, sdf.rows};
+}
+
+/**
+ * @brief Generate msdf bitmap of glyph from its outline. The bitmap covers the same box as the freetype sdf of the
+ * glyph at SDF_GLYPH_SIZE, which is used to compute the glyph's quad, scaled to the msdf size. Distances are encoded
+ * the same way as in freetype sdfs
+ *
+ * @param face Freetype face set to SDF_GLYPH_SIZE
+ * @param glyphId Glyph index to rasterize
+ * @param size Size in pixels of em square of msdf
+ * @param bitmap Bytes of msdf bitmap
+ *
+ * @return Glyph index and size of bitmap
+ */
+FontAtlas::BitmapInfo FontAtlas::_rasterizeMsdf(FT_Face face,
+                                                uint32_t glyphId,
+                                                unsigned int size,
+                                                std::vector<uint8_t> &bitmap) const {
+    if (FT_Load_Glyph(face, glyphId, FT_LOAD_DEFAULT)) {
+        throw std::runtime_error("FontAtlas::_rasterizeMsdf(): Error loading glyph");
+    }
+    const FT_Outline &outline = face->glyph->outline;
+
+    if (face->glyph->format != FT_GLYPH_FORMAT_OUTLINE || outline.n_contours == 0) {
+        return BitmapInfo{glyphId, 0, 0};
+    }
+
+    // Box of freetype sdf in pixels, outline is in 26.6 fixed point format
+    FT_BBox box;
+    FT_Outline_Get_CBox(&outline, &box);
+    double spread = FontAtlas::SDF_SPREAD;
+    double left = std::floor(box.xMin / 64.0) - spread;
+    double top = std::ceil(box.yMax / 64.0) + spread;
+    double boxWidth = std::ceil(box.xMax / 64.0) - std::floor(box.xMin / 64.0) + 2 * spread;
+    double boxHeight = std::ceil(box.yMax / 64.0) - std::floor(box.yMin / 64.0) + 2 * spread;
+
+    double scale = static_cast<double>(size) / FontAtlas::SDF_GLYPH_SIZE;
+    unsigned int width = static_cast<unsigned int>(std::ceil(boxWidth * scale));
+    unsigned int height = static_cast<unsigned int>(std::ceil(boxHeight * scale));
+    if (width == 0 || height == 0) {
+        return BitmapInfo{glyphId, 0, 0};
+    }
+
+    MsdfGenerator generator{outline};
+    generator.generate(glm::dvec2{left, top}, glm::dvec2{boxWidth / width, boxHeight / height}, spread, width, height,
+                       bitmap);
+
+    return BitmapInfo{glyphId, width, height};
+}
+
 /**
  * @brief Get all glyph indices in selected font
  *
@@ -188,10 +572,11 @@ std::vector<uint32_t> FontAtlas::_getAllGlyphIds(std::shared_ptr<Font> font) con
     uint32_t charcode;
     uint32_t glyphId;
 
-    charcode = FT_Get_First_Char(font->getFace(), &glyphId);
+    FT_Face face = font->getThreadFace();
+    charcode = FT_Get_First_Char(face, &glyphId);
     while (glyphId != 0) {
         glyphIds.push_back(glyphId);
-        charcode = FT_Get_Next_Char(font->getFace(), charcode, &glyphId);
+        charcode = FT_Get_Next_Char(face, charcode, &glyphId);
     }
 
     return glyphIds;
@@ -208,10 +593,11 @@ std::vector<uint32_t> FontAtlas::_getAllGlyphIds(std::shared_ptr<Font> font) con
 std::vector<uint32_t> FontAtlas::_getRangesGlyphIds(std::shared_ptr<Font> font,
                                                     std::vector<CharacterRange> characterRanges) const {
     std::vector<uint32_t> glyphIds;
+    FT_Face face = font->getThreadFace();
 
     for (const CharacterRange &range : characterRanges) {
         for (unsigned int i = range.start; i <= range.end; i++) {
-            glyphIds.push_back(FT_Get_Char_Index(font->getFace(), i));
+            glyphIds.push_back(FT_Get_Char_Index(face, i));
         }
     }
 
@@ -228,9 +614,10 @@ std::vector<uint32_t> FontAtlas::_getRangesGlyphIds(std::shared_ptr<Font> font,
  */
 std::vector<uint32_t> FontAtlas::_getUtf32GlyphIds(std::shared_ptr<Font> font, std::u32string characters) const {
     std::vector<uint32_t> glyphIds;
+    FT_Face face = font->getThreadFace();
 
     for (const char32_t &character : characters) {
-        glyphIds.push_back(FT_Get_Char_Index(font->getFace(), character));
+        glyphIds.push_back(FT_Get_Char_Index(face, character));
     }
 
     return glyphIds;
@@ -0,0 +1,55 @@
+/**
+ * @file font_size_bucketing.cpp
+ * @author Christian Saloň
+ */
+
+#include "font_size_bucketing.h"
+
+namespace vft {
+
+/**
+ * @brief FontSizeBucketing constructor
+ *
+ * @param ratio Ratio between upper bounds of neighbouring buckets, 1 keeps every font size in its own bucket
+ */
+FontSizeBucketing::FontSizeBucketing(double ratio) : _ratio{ratio} {
+    if (ratio < 1) {
+        throw std::invalid_argument("FontSizeBucketing::FontSizeBucketing(): Ratio must be at least 1");
+    }
+}
+
+/**
+ * @brief Get font size for which glyphs of given font size are composed
+ *
+ * @param fontSize Font size of character
+ *
+ * @return Upper bound of bucket containing font size, never smaller than font size
+ */
+unsigned int FontSizeBucketing::getBucketFontSize(unsigned int fontSize) const {
+    if (this->_ratio == 1 || fontSize <= 1) {
+        return fontSize;
+    }
+
+    // Upper bounds of buckets are ratio^k rounded up, so the previous bound can already contain the font size
+    auto getUpperBound = [this](double exponent) {
+        return static_cast<unsigned int>(std::ceil(std::pow(this->_ratio, exponent) - 1e-9));
+    };
+
+    double exponent = std::ceil(std::log(static_cast<double>(fontSize)) / std::log(this->_ratio) - 1e-9);
+    if (getUpperBound(exponent - 1) >= fontSize) {
+        return getUpperBound(exponent - 1);
+    }
+
+    return std::max(getUpperBound(exponent), fontSize);
+}
+
+/**
+ * @brief Getter for ratio between upper bounds of neighbouring buckets
+ *
+ * @return Ratio of buckets
+ */
+double FontSizeBucketing::getRatio() const {
+    return this->_ratio;
+}
+
+}  // namespace vft
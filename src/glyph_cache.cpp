@@ -21,15 +21,20 @@ GlyphKey::GlyphKey(std::string fontName, uint32_t glyphId, unsigned int fontSize
  * @brief GlyphCache constructor
  *
  * @param maxSize Maximum size of cache
+ * @param shardCount Number of independently locked parts of cache
  */
-GlyphCache::GlyphCache(unsigned long maxSize) {
+GlyphCache::GlyphCache(unsigned long maxSize, unsigned int shardCount) {
+    for (unsigned int i = 0; i < std::max(shardCount, 1u); i++) {
+        this->_shards.push_back(std::make_unique<Shard>());
+    }
+
     this->setMaxSize(maxSize);
 }
 
 /**
  * @brief GlyphCache constructor
  */
-GlyphCache::GlyphCache() : _maxSize{ULONG_MAX} {}
+GlyphCache::GlyphCache() : GlyphCache{ULONG_MAX} {}
 
 /**
  * @brief Add glyph to cache
@@ -38,36 +43,240 @@ GlyphCache::GlyphCache() : _maxSize{ULONG_MAX} {}
  * @param glyph Glyph to be added
  */
 void GlyphCache::setGlyph(GlyphKey key, Glyph glyph) {
-    if (this->exists(key)) {
-        // Update key to be most recently used (front of list)
-        this->_updateToMRU(key);
+    Shard &shard = this->_getShard(key);
+    std::unique_lock lock{shard.mutex};
+
+    auto it = shard.glyphs.find(key);
+    if (it != shard.glyphs.end()) {
+        it->second.referenced = true;
         return;
     }
 
-    if (this->_cache.size() >= this->_maxSize) {
-        this->_eraseLRU();
+    this->_insert(shard, key, std::make_shared<const Glyph>(std::move(glyph)));
+}
+
+/**
+ * @brief Get glyph from cache. The returned glyph stays valid even if it is evicted from cache meanwhile
+ *
+ * @param key Key of glyph
+ *
+ * @return Glyph stored in cache
+ */
+std::shared_ptr<const Glyph> GlyphCache::getGlyph(GlyphKey key) const {
+    Shard &shard = this->_getShard(key);
+    std::shared_lock lock{shard.mutex};
+
+    auto it = shard.glyphs.find(key);
+    if (it == shard.glyphs.end()) {
+        this->_count(this->_misses);
+        throw std::runtime_error("GlyphCache::getGlyph(): Glyph cache does not contain selected glyph");
+    }
+
+    this->_count(this->_hits);
+
+    // Mark glyph as recently used, its position in the LRU list is updated during eviction
+    it->second.referenced = true;
+
+    return it->second.glyph;
+}
+
+/**
+ * @brief Get glyph from cache if it is stored. A missing glyph is not counted as a miss, it is counted when the glyph
+ * is composed by getOrComposeGlyph()
+ *
+ * @param key Key of glyph
+ *
+ * @return Glyph stored in cache, nullptr if cache does not contain the glyph
+ */
+std::shared_ptr<const Glyph> GlyphCache::findGlyph(GlyphKey key) const {
+    Shard &shard = this->_getShard(key);
+    std::shared_lock lock{shard.mutex};
+
+    auto it = shard.glyphs.find(key);
+    if (it == shard.glyphs.end()) {
+        return nullptr;
     }
 
-    this->_cache.insert({key, glyph});
-    this->_used.push_front(key);
+    it->second.referenced = true;
+    this->_count(this->_hits);
+
+    return it->second.glyph;
 }
 
 /**
- * @brief Get glyph from cache
+ * @brief Get glyph from cache, compose and store it if it is not in cache. If several threads request the same
+ * missing glyph, only one of them composes it and the others wait for the result. If a disk cache is set and disk
+ * key is given, the glyph is loaded from disk before composing it and composed glyphs are written to disk
  *
  * @param key Key of glyph
+ * @param compose Function that composes the glyph
+ * @param diskKey Key of glyph in disk cache, std::nullopt if disk cache should not be used
  *
  * @return Glyph stored in cache
  */
-const Glyph &GlyphCache::getGlyph(GlyphKey key) {
-    if (!this->exists(key)) {
-        throw std::runtime_error("GlyphCache::getGlyph(): Glyph cache does not contain selected glyph");
+std::shared_ptr<const Glyph> GlyphCache::getOrComposeGlyph(GlyphKey key,
+                                                           const std::function<Glyph()> &compose,
+                                                           std::optional<GlyphDiskCache::Key> diskKey) {
+    Shard &shard = this->_getShard(key);
+
+    {
+        std::shared_lock lock{shard.mutex};
+
+        auto it = shard.glyphs.find(key);
+        if (it != shard.glyphs.end()) {
+            it->second.referenced = true;
+            this->_count(this->_hits);
+            return it->second.glyph;
+        }
+    }
+
+    std::promise<std::shared_ptr<const Glyph>> promise;
+
+    {
+        std::unique_lock lock{shard.mutex};
+
+        // Glyph could have been added before the exclusive lock was acquired
+        auto it = shard.glyphs.find(key);
+        if (it != shard.glyphs.end()) {
+            it->second.referenced = true;
+            this->_count(this->_hits);
+            return it->second.glyph;
+        }
+
+        this->_count(this->_misses);
+
+        // Wait for glyph that is being composed by another thread
+        auto pendingIt = shard.pending.find(key);
+        if (pendingIt != shard.pending.end()) {
+            std::shared_future<std::shared_ptr<const Glyph>> future = pendingIt->second;
+            lock.unlock();
+
+            return future.get();
+        }
+
+        shard.pending.insert({key, promise.get_future().share()});
+    }
+
+    // Load or compose glyph without holding the lock
+    std::shared_ptr<const Glyph> glyph{nullptr};
+    try {
+        std::shared_ptr<GlyphDiskCache> diskCache = std::atomic_load(&this->_diskCache);
+        std::optional<Glyph> storedGlyph = std::nullopt;
+        if (diskCache != nullptr && diskKey.has_value()) {
+            storedGlyph = diskCache->load(diskKey.value());
+        }
+
+        if (storedGlyph.has_value()) {
+            this->_count(this->_diskLoads);
+            glyph = std::make_shared<const Glyph>(std::move(storedGlyph.value()));
+        } else {
+            glyph = std::make_shared<const Glyph>(compose());
+
+            // Failing to persist glyph is not an error, it is composed again next time
+            if (diskCache != nullptr && diskKey.has_value()) {
+                diskCache->store(diskKey.value(), *glyph);
+            }
+        }
+    } catch (...) {
+        std::unique_lock lock{shard.mutex};
+        shard.pending.erase(key);
+        promise.set_exception(std::current_exception());
+
+        throw;
+    }
+
+    {
+        std::unique_lock lock{shard.mutex};
+        this->_insert(shard, key, glyph);
+        shard.pending.erase(key);
+    }
+
+    promise.set_value(glyph);
+
+    return glyph;
+}
+
+/**
+ * @brief Compose glyphs of one font in parallel on a thread pool and store them in cache, so they are not composed
+ * during rendering.
+ * Glyphs already in cache are skipped and glyphs stored in disk cache are loaded from it. If cache limits are smaller
+ * than the number of glyphs, the least recently used glyphs are evicted as usual
+ *
+ * @param font Font of glyphs
+ * @param keys Keys of glyphs to compose, duplicates are composed only once
+ * @param tessellator Tessellator used to compose glyphs, it is shared by all worker threads
+ * @param threadCount Number of worker threads, 0 uses the number of hardware threads
+ * @param onProgress Called after each glyph with the number of processed glyphs and total number of glyphs, calls are
+ * serialized but can come from any worker thread
+ *
+ * @return Number of glyphs that are composed or loaded from cache
+ *
+ * @throws Rethrows the first exception thrown while composing glyphs, after all worker threads finish
+ */
+unsigned int GlyphCache::prewarm(std::shared_ptr<Font> font,
+                                 std::vector<GlyphKey> keys,
+                                 const Tessellator &tessellator,
+                                 unsigned int threadCount,
+                                 std::function<void(unsigned int, unsigned int)> onProgress) {
+    if (font == nullptr) {
+        throw std::invalid_argument("GlyphCache::prewarm(): Font must not be nullptr");
+    }
+
+    std::unordered_set<GlyphKey, GlyphKeyHash> uniqueKeys;
+    std::erase_if(keys, [&](const GlyphKey &key) { return !uniqueKeys.insert(key).second; });
+
+    unsigned int total = keys.size();
+    if (threadCount == 0) {
+        threadCount = std::max(std::thread::hardware_concurrency(), 1u);
+    }
+    threadCount = std::min(threadCount, std::max(total, 1u));
+
+    // Hashing font content is only needed to look glyphs up on disk
+    std::optional<uint64_t> fontHash = std::nullopt;
+    if (this->getDiskCache() != nullptr) {
+        fontHash = font->getContentHash();
+    }
+    TessellationStrategy strategy = tessellator.getStrategy();
+    uint32_t variant = tessellator.getVariant();
+
+    std::atomic<unsigned int> prewarmed{0};
+    unsigned int processed = 0;
+    std::exception_ptr error{nullptr};
+    std::mutex mutex;
+
+    // Tessellators keep the state of composition per call, so all workers share one tessellator
+    ThreadPool threadPool{threadCount};
+    for (const GlyphKey &key : keys) {
+        threadPool.submit([&, key]() {
+            try {
+                std::optional<GlyphDiskCache::Key> diskKey = std::nullopt;
+                if (fontHash.has_value()) {
+                    diskKey = GlyphDiskCache::Key{fontHash.value(), key.glyphId, key.fontSize, strategy, variant};
+                }
+
+                this->getOrComposeGlyph(
+                    key, [&]() { return tessellator.composeGlyph(key.glyphId, font, key.fontSize); }, diskKey);
+                prewarmed++;
+            } catch (...) {
+                std::lock_guard lock{mutex};
+                if (error == nullptr) {
+                    error = std::current_exception();
+                }
+            }
+
+            if (onProgress) {
+                std::lock_guard lock{mutex};
+                onProgress(++processed, total);
+            }
+        });
     }
+    threadPool.wait();
 
-    // Update key to be most recently used (front of list)
-    this->_updateToMRU(key);
+    if (error != nullptr) {
+        std::rethrow_exception(error);
+    }
 
-    return this->_cache.at(key);
+    return prewarmed;
 }
 
 /**
@@ -78,11 +287,24 @@ const Glyph &GlyphCache::getGlyph(GlyphKey key) {
  * @return True if glyph is in cache, else false
  */
 bool GlyphCache::exists(GlyphKey key) const {
-    if (this->_cache.find(key) == this->_cache.end()) {
-        return false;
-    }
+    Shard &shard = this->_getShard(key);
+    std::shared_lock lock{shard.mutex};
+
+    return shard.glyphs.contains(key);
+}
+
+/**
+ * @brief Check whether glyph with given key is being composed or loaded from disk by some thread
+ *
+ * @param key Key of glyph
+ *
+ * @return True if glyph is being composed, else false
+ */
+bool GlyphCache::isPending(GlyphKey key) const {
+    Shard &shard = this->_getShard(key);
+    std::shared_lock lock{shard.mutex};
 
-    return true;
+    return shard.pending.contains(key);
 }
 
 /**
@@ -91,54 +313,263 @@ bool GlyphCache::exists(GlyphKey key) const {
  * @param key Key of glyph to remove
  */
 void GlyphCache::clearGlyph(GlyphKey key) {
-    if (!this->exists(key)) {
+    Shard &shard = this->_getShard(key);
+    std::unique_lock lock{shard.mutex};
+
+    auto it = shard.glyphs.find(key);
+    if (it == shard.glyphs.end()) {
         return;
     }
 
-    this->_cache.erase(key);
-    std::erase(this->_used, key);
+    shard.byteSize -= it->second.byteSize;
+    this->_byteSize -= it->second.byteSize;
+    this->_size--;
+    shard.used.erase(it->second.usage);
+    shard.glyphs.erase(it);
 }
 
 /**
  * @brief Remove all glyphs from cache
  */
 void GlyphCache::clearAll() {
-    this->_cache.clear();
+    for (std::unique_ptr<Shard> &shard : this->_shards) {
+        std::unique_lock lock{shard->mutex};
+
+        this->_size -= shard->glyphs.size();
+        this->_byteSize -= shard->byteSize;
+
+        shard->glyphs.clear();
+        shard->used.clear();
+        shard->byteSize = 0;
+    }
 }
 
 /**
- * @brief Set maximum size of cache
+ * @brief Set maximum number of glyphs in cache
  *
  * @param maxSize New maximum size
  */
 void GlyphCache::setMaxSize(unsigned long maxSize) {
     this->_maxSize = std::max(maxSize, static_cast<unsigned long>(1));
 
-    while (this->_cache.size() > this->_maxSize) {
-        this->_eraseLRU();
+    for (std::unique_ptr<Shard> &shard : this->_shards) {
+        std::unique_lock lock{shard->mutex};
+        this->_eraseOverBudget(*shard, 0);
+    }
+}
+
+/**
+ * @brief Set maximum memory used by glyphs in cache. One glyph is always kept, even if it alone exceeds the limit
+ *
+ * @param maxBytes New maximum memory in bytes
+ */
+void GlyphCache::setMaxBytes(std::size_t maxBytes) {
+    this->_maxBytes = maxBytes;
+
+    for (std::unique_ptr<Shard> &shard : this->_shards) {
+        std::unique_lock lock{shard->mutex};
+        this->_eraseOverBudget(*shard, 0);
     }
 }
 
 /**
- * @brief Erase the least recently used glyph from cache
+ * @brief Set persistent cache consulted when a glyph is missing in memory
+ *
+ * @param diskCache Disk cache, nullptr disables it
+ */
+void GlyphCache::setDiskCache(std::shared_ptr<GlyphDiskCache> diskCache) {
+    std::atomic_store(&this->_diskCache, diskCache);
+}
+
+/**
+ * @brief Get number of glyphs in cache
+ *
+ * @return Glyph count
+ */
+unsigned long GlyphCache::getSize() const {
+    return this->_size;
+}
+
+/**
+ * @brief Get memory used by glyphs in cache
+ *
+ * @return Memory in bytes
+ */
+std::size_t GlyphCache::getByteSize() const {
+    return this->_byteSize;
+}
+
+/**
+ * @brief Getter for persistent cache consulted when a glyph is missing in memory
+ *
+ * @return Disk cache, nullptr if it is not set
+ */
+std::shared_ptr<GlyphDiskCache> GlyphCache::getDiskCache() const {
+    return std::atomic_load(&this->_diskCache);
+}
+
+/**
+ * @brief Enable or disable collecting statistics of cache usage
+ *
+ * @param enabled True to collect statistics
+ */
+void GlyphCache::setStatsEnabled(bool enabled) {
+    this->_statsEnabled = enabled;
+}
+
+/**
+ * @brief Get statistics of cache usage since the last reset, together with current size and limits of cache
+ *
+ * @return Snapshot of statistics
+ */
+GlyphCache::Stats GlyphCache::getStats() const {
+    Stats stats{};
+    stats.hits = this->_hits.load(std::memory_order_relaxed);
+    stats.misses = this->_misses.load(std::memory_order_relaxed);
+    stats.diskLoads = this->_diskLoads.load(std::memory_order_relaxed);
+    stats.evictions = this->_evictions.load(std::memory_order_relaxed);
+    stats.size = this->getSize();
+    stats.byteSize = this->getByteSize();
+    stats.maxSize = this->_maxSize;
+    stats.maxBytes = this->_maxBytes;
+
+    return stats;
+}
+
+/**
+ * @brief Reset all counters of cache usage
+ */
+void GlyphCache::resetStats() {
+    this->_hits = 0;
+    this->_misses = 0;
+    this->_diskLoads = 0;
+    this->_evictions = 0;
+}
+
+/**
+ * @brief Get shard where glyph with given key is stored
+ *
+ * @param key Key of glyph
+ *
+ * @return Shard of glyph
  */
-void GlyphCache::_eraseLRU() {
-    GlyphKey lru = this->_used.back();
-    this->_cache.erase(lru);
-    this->_used.pop_back();
+GlyphCache::Shard &GlyphCache::_getShard(const GlyphKey &key) const {
+    // Mix bits of hash, glyph keys of one font differ only in the low bits
+    std::size_t hash = GlyphKeyHash()(key);
+    hash = ((hash >> 16) ^ hash) * 0x45d9f3b;
+    hash = ((hash >> 16) ^ hash) * 0x45d9f3b;
+    hash = (hash >> 16) ^ hash;
+
+    return *this->_shards[hash % this->_shards.size()];
 }
 
 /**
- * @brief Set glyph with given key as most recently used
+ * @brief Insert glyph into shard and evict glyphs if shard is over budget. Exclusive lock of shard must be held
  *
+ * @param shard Shard of glyph
  * @param key Key of glyph
+ * @param glyph Glyph to insert
+ */
+void GlyphCache::_insert(Shard &shard, const GlyphKey &key, std::shared_ptr<const Glyph> glyph) {
+    std::size_t byteSize = glyph->getMemorySize();
+
+    auto [it, inserted] = shard.glyphs.emplace(std::piecewise_construct, std::forward_as_tuple(key),
+                                               std::forward_as_tuple(std::move(glyph), byteSize));
+    if (!inserted) {
+        return;
+    }
+
+    shard.used.push_front(&it->first);
+    it->second.usage = shard.used.begin();
+    shard.byteSize += byteSize;
+    this->_byteSize += byteSize;
+    this->_size++;
+
+    this->_eraseOverBudget(shard);
+}
+
+/**
+ * @brief Erase the least recently used glyph from shard. Exclusive lock of shard must be held
+ *
+ * @param shard Shard of cache
+ */
+void GlyphCache::_eraseLRU(Shard &shard) {
+    auto it = shard.glyphs.find(*shard.used.back());
+    shard.byteSize -= it->second.byteSize;
+    this->_byteSize -= it->second.byteSize;
+    this->_size--;
+    shard.used.pop_back();
+    shard.glyphs.erase(it);
+
+    this->_count(this->_evictions);
+}
+
+/**
+ * @brief Erase least recently used glyphs until glyph count and memory of cache are within limits after a glyph was
+ * inserted into shard. Glyphs of the shard are erased first, except for the inserted glyph, then glyphs of other
+ * shards. Locks of other shards are only tried, so threads evicting at the same time do not deadlock, a shard locked by
+ * another thread is skipped and the cache gets within limits on a later insert. Exclusive lock of shard must be held
+ *
+ * @param shard Shard of inserted glyph
  */
-void GlyphCache::_updateToMRU(GlyphKey key) {
-    if (!this->exists(key)) {
-        throw std::runtime_error("GlyphCache::_updateToMRU(): Glyph cache does not contain selected glyph");
+void GlyphCache::_eraseOverBudget(Shard &shard) {
+    this->_eraseOverBudget(shard, 1);
+
+    for (std::unique_ptr<Shard> &otherShard : this->_shards) {
+        if (!this->_isOverBudget()) {
+            return;
+        }
+        if (otherShard.get() == &shard) {
+            continue;
+        }
+
+        std::unique_lock lock{otherShard->mutex, std::try_to_lock};
+        if (lock.owns_lock()) {
+            this->_eraseOverBudget(*otherShard, 0);
+        }
+    }
+}
+
+/**
+ * @brief Erase least recently used glyphs of shard until glyph count and memory of cache are within limits or shard
+ * has minSize glyphs. Glyphs that were read since the last pass are moved to the front of the LRU list instead. The
+ * last glyph of cache is never erased. Exclusive lock of shard must be held
+ *
+ * @param shard Shard of cache
+ * @param minSize Number of most recently used glyphs kept in shard
+ */
+void GlyphCache::_eraseOverBudget(Shard &shard, std::size_t minSize) {
+    while (this->_isOverBudget() && shard.glyphs.size() > minSize && this->_size > 1) {
+        auto it = shard.glyphs.find(*shard.used.back());
+
+        // Give referenced glyph a second chance, flags are cleared so the loop ends after one pass at most
+        if (it->second.referenced.exchange(false)) {
+            shard.used.splice(shard.used.begin(), shard.used, it->second.usage);
+            continue;
+        }
+
+        this->_eraseLRU(shard);
     }
+}
+
+/**
+ * @brief Check whether glyph count or memory of cache exceeds its limits
+ *
+ * @return True if cache is over budget
+ */
+bool GlyphCache::_isOverBudget() const {
+    return this->_size > this->_maxSize || this->_byteSize > this->_maxBytes;
+}
 
-    this->_used.splice(this->_used.begin(), this->_used, std::find(this->_used.begin(), this->_used.end(), key));
+/**
+ * @brief Increment counter if statistics are enabled
+ *
+ * @param counter Counter to increment
+ */
+void GlyphCache::_count(std::atomic<uint64_t> &counter) const {
+    if (this->_statsEnabled.load(std::memory_order_relaxed)) {
+        counter.fetch_add(1, std::memory_order_relaxed);
+    }
 }
 
 }  // namespace vft
@@ -9,6 +9,60 @@
 
 namespace vft {
 
+/**
+ * @brief Triangulate glyph polygon. Polygons without holes whose contours have at most MAX_EAR_CLIPPING_EDGES edges are
+ * triangulated by ear clipping, other polygons and contours which ear clipping fails on are triangulated by constrained
+ * delaunay triangulation
+ *
+ * @param vertices Vertices of polygon, duplicate vertices are removed if constrained delaunay triangulation is used
+ * @param polygon Contours of polygon which do not intersect each other, filled area is on the right side of contours
+ *
+ * @return Indices of triangles
+ */
+std::vector<uint32_t> GlyphCompositor::triangulate(std::vector<glm::vec2> &vertices,
+                                                   const std::vector<Outline> &polygon) {
+    // Contours with filled area on their right side are holes if they are counter clockwise, ear clipping is quadratic
+    // in edge count of contour so long contours are left to constrained delaunay triangulation
+    bool isClippable = std::all_of(polygon.begin(), polygon.end(), [](const Outline &outline) {
+        return outline.orientation != Outline::Orientation::CCW &&
+               outline.edges.size() <= GlyphCompositor::MAX_EAR_CLIPPING_EDGES;
+    });
+
+    if (isClippable) {
+        static thread_local EarClippingContext context{};
+
+        std::size_t indexCount = 0;
+        for (const Outline &outline : polygon) {
+            indexCount += outline.edges.size() >= 3 ? 3 * (outline.edges.size() - 2) : 0;
+        }
+
+        std::vector<uint32_t> indices;
+        indices.reserve(indexCount);
+
+        bool isClipped = std::all_of(polygon.begin(), polygon.end(), [&](const Outline &outline) {
+            return GlyphCompositor::_clipEars(vertices, outline, context, indices);
+        });
+        if (isClipped) {
+            return indices;
+        }
+    }
+
+    std::vector<Edge> edges;
+    for (const Outline &outline : polygon) {
+        edges.insert(edges.end(), outline.edges.begin(), outline.edges.end());
+    }
+
+    // Remove duplicate vertices
+    CDT::RemoveDuplicatesAndRemapEdges<float>(
+        vertices, [](const glm::vec2 &p) { return p.x; }, [](const glm::vec2 &p) { return p.y; }, edges.begin(),
+        edges.end(), [](const Edge &e) { return e.first; }, [](const Edge &e) { return e.second; },
+        [](uint32_t i1, uint32_t i2) -> Edge {
+            return Edge{i1, i2};
+        });
+
+    return GlyphCompositor::triangulate(vertices, edges);
+}
+
 /**
  * @brief Performs constrained delaunay triangulation on a glyph
  */
@@ -26,14 +80,150 @@ std::vector<uint32_t> GlyphCompositor::triangulate(std::vector<glm::vec2> &verti
 
     // Create index buffer from triangulation
     std::vector<uint32_t> glyphIndices;
-    CDT::TriangleVec cdtTriangles = cdt.triangles;
-    for (int i = 0; i < cdtTriangles.size(); i++) {
-        glyphIndices.push_back(cdtTriangles.at(i).vertices.at(0));
-        glyphIndices.push_back(cdtTriangles.at(i).vertices.at(1));
-        glyphIndices.push_back(cdtTriangles.at(i).vertices.at(2));
+    glyphIndices.reserve(3 * cdt.triangles.size());
+    for (const CDT::Triangle &triangle : cdt.triangles) {
+        glyphIndices.insert(glyphIndices.end(), triangle.vertices.begin(), triangle.vertices.end());
     }
 
     return glyphIndices;
 }
 
+/**
+ * @brief Triangulate one contour by repeatedly cutting off ears, triangles formed by two consecutive edges which
+ * contain no other vertex of contour
+ *
+ * @param vertices Vertices of polygon
+ * @param outline Contour without holes
+ * @param context Working storage of ear clipping
+ * @param indices Index buffer, indices of triangles are appended to it
+ *
+ * @return False if contour touches itself or no ear was found because of rounding errors, indices are left unchanged
+ */
+bool GlyphCompositor::_clipEars(const std::vector<glm::vec2> &vertices,
+                                const Outline &outline,
+                                EarClippingContext &context,
+                                std::vector<uint32_t> &indices) {
+    if (outline.edges.size() < 3) {
+        return true;
+    }
+
+    if (context.visits.size() < vertices.size()) {
+        context.visits.resize(vertices.size(), 0);
+    }
+
+    // Every contour marks its vertices by its own id, so the marks do not have to be cleared
+    if (++context.contourId == 0) {
+        std::fill(context.visits.begin(), context.visits.end(), 0);
+        context.contourId = 1;
+    }
+
+    context.contour.clear();
+    for (const Edge &edge : outline.edges) {
+        if (context.visits[edge.first] == context.contourId) {
+            return false;
+        }
+
+        context.visits[edge.first] = context.contourId;
+        context.contour.push_back(edge.first);
+    }
+
+    uint32_t size = context.contour.size();
+    context.previous.resize(size);
+    context.next.resize(size);
+    for (uint32_t i = 0; i < size; i++) {
+        context.previous[i] = (i + size - 1) % size;
+        context.next[i] = (i + 1) % size;
+    }
+
+    // Convex vertices turn right in clockwise contours
+    float turn = outline.orientation == Outline::Orientation::CW ? -1.f : 1.f;
+    std::size_t firstIndex = indices.size();
+
+    uint32_t remaining = size;
+    uint32_t current = 0;
+    uint32_t testedSinceLastEar = 0;
+    while (remaining > 3) {
+        uint32_t previous = context.previous[current];
+        uint32_t next = context.next[current];
+        const glm::vec2 &a = vertices[context.contour[previous]];
+        const glm::vec2 &b = vertices[context.contour[current]];
+        const glm::vec2 &c = vertices[context.contour[next]];
+
+        double cross = GlyphCompositor::_getSignedArea(a, b, c);
+
+        bool isEar = cross * turn >= 0;
+        for (uint32_t other = context.next[next]; isEar && other != previous; other = context.next[other]) {
+            const glm::vec2 &point = vertices[context.contour[other]];
+            isEar = point == a || point == b || point == c || !GlyphCompositor::_isInTriangle(point, a, b, c);
+        }
+
+        if (!isEar) {
+            current = next;
+            if (++testedSinceLastEar > remaining) {
+                indices.resize(firstIndex);
+                return false;
+            }
+
+            continue;
+        }
+
+        // Vertex between collinear edges is removed without creating an empty triangle
+        if (cross != 0) {
+            indices.insert(indices.end(), {context.contour[previous], context.contour[current], context.contour[next]});
+        }
+
+        context.next[previous] = next;
+        context.previous[next] = previous;
+        remaining--;
+        testedSinceLastEar = 0;
+        current = previous;
+    }
+
+    // Last triangle is empty if the remaining vertices are collinear
+    const glm::vec2 &a = vertices[context.contour[context.previous[current]]];
+    const glm::vec2 &b = vertices[context.contour[current]];
+    const glm::vec2 &c = vertices[context.contour[context.next[current]]];
+    if (GlyphCompositor::_getSignedArea(a, b, c) != 0) {
+        indices.insert(indices.end(), {context.contour[context.previous[current]], context.contour[current],
+                                       context.contour[context.next[current]]});
+    }
+
+    return true;
+}
+
+/**
+ * @brief Check whether point lies inside of triangle or on its boundary
+ *
+ * @param point Point
+ * @param a First vertex of triangle
+ * @param b Second vertex of triangle
+ * @param c Third vertex of triangle
+ *
+ * @return True if point lies in triangle
+ */
+bool GlyphCompositor::_isInTriangle(const glm::vec2 &point,
+                                    const glm::vec2 &a,
+                                    const glm::vec2 &b,
+                                    const glm::vec2 &c) {
+    double ab = GlyphCompositor::_getSignedArea(a, b, point);
+    double bc = GlyphCompositor::_getSignedArea(b, c, point);
+    double ca = GlyphCompositor::_getSignedArea(c, a, point);
+
+    return (ab >= 0 && bc >= 0 && ca >= 0) || (ab <= 0 && bc <= 0 && ca <= 0);
+}
+
+/**
+ * @brief Compute twice the signed area of triangle, it is positive if vertices are in counter clockwise order
+ *
+ * @param a First vertex of triangle
+ * @param b Second vertex of triangle
+ * @param c Third vertex of triangle
+ *
+ * @return Twice the signed area of triangle
+ */
+double GlyphCompositor::_getSignedArea(const glm::vec2 &a, const glm::vec2 &b, const glm::vec2 &c) {
+    return (static_cast<double>(b.x) - a.x) * (static_cast<double>(c.y) - a.y) -
+           (static_cast<double>(b.y) - a.y) * (static_cast<double>(c.x) - a.x);
+}
+
 }  // namespace vft
@@ -0,0 +1,257 @@
+/**
+ * @file glyph_disk_cache.cpp
+ * @author Christian Saloň
+ */
+
+#include "glyph_disk_cache.h"
+
+namespace vft {
+
+/**
+ * @brief GlyphDiskCache constructor
+ *
+ * @param directory Directory where glyph files are stored, it is created when the first glyph is stored
+ */
+GlyphDiskCache::GlyphDiskCache(std::filesystem::path directory) : _directory{directory} {
+    if (directory.empty()) {
+        throw std::runtime_error("GlyphDiskCache::GlyphDiskCache(): Cache directory was not entered");
+    }
+}
+
+/**
+ * @brief Load glyph from disk
+ *
+ * @param key Key of glyph
+ *
+ * @return Stored glyph, std::nullopt if glyph is not stored, was stored by another format version or file is corrupted
+ */
+std::optional<Glyph> GlyphDiskCache::load(const Key &key) const {
+    std::ifstream file{this->_getFilePath(key), std::ios::binary | std::ios::ate};
+    if (!file.is_open()) {
+        return std::nullopt;
+    }
+
+    // Read whole file at once
+    std::streamsize fileSize = file.tellg();
+    std::vector<char> data(static_cast<std::size_t>(std::max<std::streamsize>(fileSize, 0)));
+    file.seekg(0);
+    if (!file.read(data.data(), fileSize)) {
+        return std::nullopt;
+    }
+
+    return GlyphDiskCache::deserialize(key, data.data(), data.size());
+}
+
+/**
+ * @brief Store glyph on disk, replaces glyph with the same key
+ *
+ * @param key Key of glyph
+ * @param glyph Glyph to store
+ *
+ * @return True if glyph was stored, false if the file could not be written
+ */
+bool GlyphDiskCache::store(const Key &key, const Glyph &glyph) {
+    std::vector<char> data = GlyphDiskCache::serialize(key, glyph);
+    std::filesystem::path filePath = this->_getFilePath(key);
+
+    std::error_code error;
+    std::filesystem::create_directories(filePath.parent_path(), error);
+    if (error) {
+        return false;
+    }
+
+    // Write into a temporary file first, so readers never see a partially written glyph
+    std::stringstream tempFileName;
+    tempFileName << filePath.filename().string() << "." << std::hash<std::thread::id>()(std::this_thread::get_id())
+                 << "." << this->_tempFileCounter++ << ".tmp";
+    std::filesystem::path tempFilePath = filePath.parent_path() / tempFileName.str();
+
+    {
+        std::ofstream file{tempFilePath, std::ios::binary | std::ios::trunc};
+        if (!file.is_open()) {
+            return false;
+        }
+
+        file.write(data.data(), data.size());
+        if (!file.good()) {
+            file.close();
+            std::filesystem::remove(tempFilePath, error);
+            return false;
+        }
+    }
+
+    std::filesystem::rename(tempFilePath, filePath, error);
+    if (error) {
+        std::filesystem::remove(tempFilePath, error);
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Remove all glyphs stored in cache directory
+ */
+void GlyphDiskCache::clear() {
+    std::error_code error;
+    for (const std::filesystem::directory_entry &entry : std::filesystem::directory_iterator{this->_directory, error}) {
+        std::filesystem::remove_all(entry.path(), error);
+    }
+}
+
+/**
+ * @brief Convert glyph into its binary representation
+ *
+ * @param key Key of glyph
+ * @param glyph Glyph to convert
+ *
+ * @return Glyph data in the format of glyph files
+ */
+std::vector<char> GlyphDiskCache::serialize(const Key &key, const Glyph &glyph) {
+    FileHeader header{};
+    std::memcpy(header.magic, "VFGM", 4);
+    header.version = FORMAT_VERSION;
+    header.fontHash = key.fontHash;
+    header.glyphId = key.glyphId;
+    header.fontSize = key.fontSize;
+    header.strategy = static_cast<uint32_t>(key.strategy);
+    header.vertexCount = glyph.mesh.getVertexCount();
+    header.width = glyph.getWidth();
+    header.height = glyph.getHeight();
+    header.bearingX = glyph.getBearingX();
+    header.bearingY = glyph.getBearingY();
+    header.advanceX = glyph.getAdvanceX();
+    header.advanceY = glyph.getAdvanceY();
+    header.drawCount = glyph.mesh.getDrawCount();
+    header.variant = key.variant;
+
+    std::vector<glm::vec2> vertices = glyph.mesh.getVertices();
+    std::vector<uint32_t> indexCounts(header.drawCount);
+    std::size_t size = sizeof(FileHeader) + indexCounts.size() * sizeof(uint32_t) + vertices.size() * sizeof(glm::vec2);
+    for (uint32_t i = 0; i < header.drawCount; i++) {
+        indexCounts[i] = glyph.mesh.getIndexCount(i);
+        size += indexCounts[i] * sizeof(uint32_t);
+    }
+
+    std::vector<char> data(size);
+    std::size_t offset = 0;
+    auto write = [&data, &offset](const void *source, std::size_t sourceSize) {
+        if (sourceSize > 0) {
+            std::memcpy(data.data() + offset, source, sourceSize);
+            offset += sourceSize;
+        }
+    };
+
+    write(&header, sizeof(FileHeader));
+    write(indexCounts.data(), indexCounts.size() * sizeof(uint32_t));
+    write(vertices.data(), vertices.size() * sizeof(glm::vec2));
+    for (uint32_t i = 0; i < header.drawCount; i++) {
+        std::vector<uint32_t> indices = glyph.mesh.getIndices(i);
+        write(indices.data(), indices.size() * sizeof(uint32_t));
+    }
+
+    return data;
+}
+
+/**
+ * @brief Create glyph from its binary representation
+ *
+ * @param key Expected key of glyph
+ * @param data Glyph data in the format of glyph files
+ * @param size Size of data in bytes
+ *
+ * @return Glyph, std::nullopt if data has another format version, key or is corrupted
+ */
+std::optional<Glyph> GlyphDiskCache::deserialize(const Key &key, const char *data, std::size_t size) {
+    if (size < sizeof(FileHeader)) {
+        return std::nullopt;
+    }
+
+    FileHeader header;
+    std::memcpy(&header, data, sizeof(FileHeader));
+    if (std::memcmp(header.magic, "VFGM", 4) != 0 || header.version != FORMAT_VERSION ||
+        header.fontHash != key.fontHash || header.glyphId != key.glyphId || header.fontSize != key.fontSize ||
+        header.strategy != static_cast<uint32_t>(key.strategy) || header.variant != key.variant) {
+        return std::nullopt;
+    }
+
+    if (header.drawCount > GlyphMesh::MAX_DRAW_COUNT) {
+        return std::nullopt;
+    }
+
+    // Check that all sections fit into data before copying them
+    uint64_t offset = sizeof(FileHeader);
+    uint64_t indexCountsSize = static_cast<uint64_t>(header.drawCount) * sizeof(uint32_t);
+    if (offset + indexCountsSize > size) {
+        return std::nullopt;
+    }
+
+    // Copy section of data into destination, empty sections may not have an allocated destination
+    auto read = [data, &offset](void *destination, std::size_t destinationSize) {
+        if (destinationSize > 0) {
+            std::memcpy(destination, data + offset, destinationSize);
+            offset += destinationSize;
+        }
+    };
+
+    std::vector<uint32_t> indexCounts(header.drawCount);
+    read(indexCounts.data(), indexCountsSize);
+
+    uint64_t expectedSize = offset + static_cast<uint64_t>(header.vertexCount) * sizeof(glm::vec2);
+    for (uint32_t indexCount : indexCounts) {
+        expectedSize += static_cast<uint64_t>(indexCount) * sizeof(uint32_t);
+    }
+
+    if (expectedSize != size) {
+        return std::nullopt;
+    }
+
+    std::vector<glm::vec2> vertices(header.vertexCount);
+    read(vertices.data(), vertices.size() * sizeof(glm::vec2));
+
+    std::vector<std::vector<uint32_t>> indices(header.drawCount);
+    for (uint32_t i = 0; i < header.drawCount; i++) {
+        indices[i].resize(indexCounts[i]);
+        read(indices[i].data(), indices[i].size() * sizeof(uint32_t));
+    }
+
+    Glyph glyph{};
+    glyph.mesh = GlyphMesh{vertices, indices};
+    glyph.setWidth(header.width);
+    glyph.setHeight(header.height);
+    glyph.setBearingX(header.bearingX);
+    glyph.setBearingY(header.bearingY);
+    glyph.setAdvanceX(header.advanceX);
+    glyph.setAdvanceY(header.advanceY);
+
+    return glyph;
+}
+
+/**
+ * @brief Getter for cache directory
+ *
+ * @return Directory where glyph files are stored
+ */
+const std::filesystem::path &GlyphDiskCache::getDirectory() const {
+    return this->_directory;
+}
+
+/**
+ * @brief Get path of file storing glyph with given key. Glyphs of one font are stored in a common subdirectory
+ *
+ * @param key Key of glyph
+ *
+ * @return Path to glyph file
+ */
+std::filesystem::path GlyphDiskCache::_getFilePath(const Key &key) const {
+    std::stringstream fontDirectory;
+    fontDirectory << std::hex << key.fontHash;
+
+    std::stringstream fileName;
+    fileName << static_cast<uint32_t>(key.strategy) << "-" << key.variant << "-" << key.fontSize << "-" << key.glyphId
+             << ".vfg";
+
+    return this->_directory / fontDirectory.str() / fileName.str();
+}
+
+}  // namespace vft
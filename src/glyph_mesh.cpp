@@ -8,71 +8,205 @@
 namespace vft {
 
 /**
- * @brief GlyphMesh constructor
+ * @brief GlyphMesh constructor, packs vertex and index buffers into one allocation
  *
  * @param vertices Glyph's vertex buffer
  * @param indices Glyph's index buffers
+ *
+ * @throws std::invalid_argument When there are more than MAX_DRAW_COUNT index buffers
  */
-GlyphMesh::GlyphMesh(std::vector<glm::vec2> vertices, std::vector<std::vector<uint32_t>> indices)
-    : _vertices{vertices}, _indices{indices} {}
+GlyphMesh::GlyphMesh(const std::vector<glm::vec2> &vertices, const std::vector<std::vector<uint32_t>> &indices) {
+    if (indices.size() > MAX_DRAW_COUNT) {
+        throw std::invalid_argument("GlyphMesh::GlyphMesh(): Mesh can have at most " + std::to_string(MAX_DRAW_COUNT) +
+                                    " index buffers");
+    }
+
+    this->_vertexCount = vertices.size();
+    this->_drawCount = indices.size();
+    // Flattened curves and intersections are not whole font units, so vertices are stored in the finest fraction of
+    // font unit in which all of them fit
+    float maxCoordinate = 0;
+    for (const glm::vec2 &vertex : vertices) {
+        maxCoordinate = std::max({maxCoordinate, std::abs(vertex.x), std::abs(vertex.y)});
+    }
+    for (int exponent = MAX_VERTEX_SCALE_EXPONENT; exponent >= 0; exponent--) {
+        if (std::round(std::ldexp(maxCoordinate, exponent)) <= std::numeric_limits<int16_t>::max()) {
+            this->_quantizedVertices = true;
+            this->_vertexScaleExponent = exponent;
+            break;
+        }
+    }
+    this->_shortIndices = std::all_of(indices.begin(), indices.end(), [](const std::vector<uint32_t> &buffer) {
+        return std::all_of(buffer.begin(), buffer.end(),
+                           [](uint32_t index) { return index <= std::numeric_limits<uint16_t>::max(); });
+    });
+
+    this->_indexOffsets[0] = 0;
+    for (unsigned int i = 0; i < MAX_DRAW_COUNT; i++) {
+        this->_indexOffsets[i + 1] = this->_indexOffsets[i] + (i < indices.size() ? indices[i].size() : 0);
+    }
+
+    if (this->_getDataSize() == 0) {
+        return;
+    }
+
+    this->_data = std::make_unique<std::byte[]>(this->_getDataSize());
+
+    if (this->_quantizedVertices) {
+        float scale = this->getVertexScale();
+        int16_t *data = reinterpret_cast<int16_t *>(this->_data.get());
+        for (const glm::vec2 &vertex : vertices) {
+            *data++ = static_cast<int16_t>(std::round(vertex.x * scale));
+            *data++ = static_cast<int16_t>(std::round(vertex.y * scale));
+        }
+    } else {
+        std::memcpy(this->_data.get(), vertices.data(), vertices.size() * sizeof(glm::vec2));
+    }
+
+    std::byte *indicesStart = this->_data.get() + this->_getIndicesStart();
+    for (unsigned int i = 0; i < indices.size(); i++) {
+        if (this->_shortIndices) {
+            uint16_t *data = reinterpret_cast<uint16_t *>(indicesStart) + this->_indexOffsets[i];
+            std::transform(indices[i].begin(), indices[i].end(), data,
+                           [](uint32_t index) { return static_cast<uint16_t>(index); });
+        } else if (!indices[i].empty()) {
+            uint32_t *data = reinterpret_cast<uint32_t *>(indicesStart) + this->_indexOffsets[i];
+            std::memcpy(data, indices[i].data(), indices[i].size() * sizeof(uint32_t));
+        }
+    }
+}
 
 /**
- * @brief GlyphMesh constructor
+ * @brief GlyphMesh constructor, creates an empty mesh
  */
-GlyphMesh::GlyphMesh() {
-    // Resize indices array to prevent index out of range exception in getIndices()
-    this->_indices.resize(10);
-}
+GlyphMesh::GlyphMesh() {}
 
 /**
- * @brief Add vertex to vertex buffer
+ * @brief GlyphMesh copy constructor
  *
- * @param vertex New Vertex
+ * @param other Copied mesh
  */
-void GlyphMesh::addVertex(glm::vec2 vertex) {
-    this->_vertices.push_back(vertex);
+GlyphMesh::GlyphMesh(const GlyphMesh &other)
+    : _indexOffsets{other._indexOffsets},
+      _vertexCount{other._vertexCount},
+      _drawCount{other._drawCount},
+      _quantizedVertices{other._quantizedVertices},
+      _vertexScaleExponent{other._vertexScaleExponent},
+      _shortIndices{other._shortIndices} {
+    if (other._data != nullptr) {
+        this->_data = std::make_unique<std::byte[]>(other._getDataSize());
+        std::memcpy(this->_data.get(), other._data.get(), other._getDataSize());
+    }
 }
 
 /**
- * @brief Set vertex buffer of glyph
+ * @brief GlyphMesh copy assignment
+ *
+ * @param other Copied mesh
  *
- * @param vertices New vertex buffer
+ * @return This mesh
  */
-void GlyphMesh::setVertices(std::vector<glm::vec2> vertices) {
-    this->_vertices = vertices;
+GlyphMesh &GlyphMesh::operator=(const GlyphMesh &other) {
+    if (this != &other) {
+        *this = GlyphMesh{other};
+    }
+
+    return *this;
 }
 
 /**
- * @brief Set one index buffer of glyph
- * @param drawIndex Index pointing to which index buffer to set from vector of index buffers
- * @param indices New index buffer
+ * @brief Get one vertex of vertex buffer
+ *
+ * @param vertexIndex Index of vertex
+ *
+ * @return Vertex
  */
-void GlyphMesh::setIndices(unsigned int drawIndex, std::vector<uint32_t> indices) {
-    this->_indices.at(drawIndex) = indices;
+glm::vec2 GlyphMesh::getVertex(uint32_t vertexIndex) const {
+    if (vertexIndex >= this->_vertexCount) {
+        throw std::out_of_range("GlyphMesh::getVertex(): Index is out of range");
+    }
+
+    if (this->_quantizedVertices) {
+        const int16_t *data = reinterpret_cast<const int16_t *>(this->_data.get()) + vertexIndex * 2;
+        return glm::vec2{static_cast<float>(data[0]), static_cast<float>(data[1])} / this->getVertexScale();
+    }
+
+    glm::vec2 vertex;
+    std::memcpy(&vertex, this->_data.get() + vertexIndex * sizeof(glm::vec2), sizeof(glm::vec2));
+    return vertex;
 }
 
 /**
- * @brief Get vertex buffer of glyph
+ * @brief Get copy of vertex buffer of glyph
  *
  * @return Vertex buffer
  */
-const std::vector<glm::vec2> &GlyphMesh::getVertices() const {
-    return this->_vertices;
+std::vector<glm::vec2> GlyphMesh::getVertices() const {
+    std::vector<glm::vec2> vertices;
+    this->appendVertices(vertices);
+
+    return vertices;
 }
 
 /**
- * @brief Get index buffer at given index
+ * @brief Get copy of index buffer at given index
  *
- * @param drawIndex Index pointing to which index buffer to get from vector of index buffers
+ * @param drawIndex Index pointing to which index buffer to get, index buffers that were not set are empty
  *
  * @return Index buffer
  */
-const std::vector<uint32_t> &GlyphMesh::getIndices(unsigned int drawIndex) const {
-    if (drawIndex >= this->_indices.size()) {
-        throw std::out_of_range("GlyphMesh::getIndices(): Index is out of range");
+std::vector<uint32_t> GlyphMesh::getIndices(unsigned int drawIndex) const {
+    std::vector<uint32_t> indices;
+    this->appendIndices(drawIndex, indices);
+
+    return indices;
+}
+
+/**
+ * @brief Append vertex buffer of glyph to given vertices
+ *
+ * @param vertices Vertex buffer to which vertices are appended
+ */
+void GlyphMesh::appendVertices(std::vector<glm::vec2> &vertices) const {
+    if (this->_vertexCount == 0) {
+        return;
+    }
+
+    if (this->_quantizedVertices) {
+        float scale = this->getVertexScale();
+        const int16_t *data = reinterpret_cast<const int16_t *>(this->_data.get());
+        vertices.reserve(vertices.size() + this->_vertexCount);
+        for (uint32_t i = 0; i < this->_vertexCount; i++) {
+            vertices.push_back(glm::vec2{static_cast<float>(data[2 * i]), static_cast<float>(data[2 * i + 1])} /
+                               scale);
+        }
+
+        return;
+    }
+
+    std::size_t start = vertices.size();
+    vertices.resize(start + this->_vertexCount);
+    std::memcpy(vertices.data() + start, this->_data.get(), this->_vertexCount * sizeof(glm::vec2));
+}
+
+/**
+ * @brief Append index buffer at given index to given indices
+ *
+ * @param drawIndex Index pointing to which index buffer to append, index buffers that were not set are empty
+ * @param indices Index buffer to which indices are appended
+ * @param offset Value added to every appended index, used when vertex buffers of several meshes are merged
+ *
+ * @throws std::out_of_range When draw index is not smaller than MAX_DRAW_COUNT
+ */
+void GlyphMesh::appendIndices(unsigned int drawIndex, std::vector<uint32_t> &indices, uint32_t offset) const {
+    if (drawIndex >= MAX_DRAW_COUNT) {
+        throw std::out_of_range("GlyphMesh::appendIndices(): Index is out of range");
     }
 
-    return this->_indices.at(drawIndex);
+    indices.reserve(indices.size() + this->getIndexCount(drawIndex));
+    for (uint32_t i = this->_indexOffsets[drawIndex]; i < this->_indexOffsets[drawIndex + 1]; i++) {
+        indices.push_back(this->_getIndex(i) + offset);
+    }
 }
 
 /**
@@ -81,17 +215,24 @@ const std::vector<uint32_t> &GlyphMesh::getIndices(unsigned int drawIndex) const
  * @return Vertex count
  */
 uint32_t GlyphMesh::getVertexCount() const {
-    return this->_vertices.size();
+    return this->_vertexCount;
 }
 
 /**
  * @brief Get number if indices in one index buffer
  *
  * @param drawIndex Index pointing to one specific index buffer
- * @return
+ *
+ * @return Index count, zero for index buffers that were not set
+ *
+ * @throws std::out_of_range When draw index is not smaller than MAX_DRAW_COUNT
  */
 uint32_t GlyphMesh::getIndexCount(unsigned int drawIndex) const {
-    return this->_indices.at(drawIndex).size();
+    if (drawIndex >= MAX_DRAW_COUNT) {
+        throw std::out_of_range("GlyphMesh::getIndexCount(): Index is out of range");
+    }
+
+    return this->_indexOffsets[drawIndex + 1] - this->_indexOffsets[drawIndex];
 }
 
 /**
@@ -100,7 +241,95 @@ uint32_t GlyphMesh::getIndexCount(unsigned int drawIndex) const {
  * @return Index buffer count
  */
 unsigned int GlyphMesh::getDrawCount() const {
-    return this->_indices.size();
+    return this->_drawCount;
+}
+
+/**
+ * @brief Check whether vertices are stored as 16-bit integers
+ *
+ * @return True if vertices are quantized to fractions of font unit
+ */
+bool GlyphMesh::hasQuantizedVertices() const {
+    return this->_quantizedVertices;
+}
+
+/**
+ * @brief Get number of quantization steps in one font unit
+ *
+ * @return Scale of quantized vertices, a power of two
+ */
+float GlyphMesh::getVertexScale() const {
+    return std::ldexp(1.f, this->_vertexScaleExponent);
+}
+
+/**
+ * @brief Check whether indices are stored as 16-bit integers
+ *
+ * @return True if indices are 16-bit
+ */
+bool GlyphMesh::hasShortIndices() const {
+    return this->_shortIndices;
+}
+
+/**
+ * @brief Get number of bytes allocated on the heap by vertex and index buffers
+ *
+ * @return Size of mesh buffers in bytes
+ */
+std::size_t GlyphMesh::getMemorySize() const {
+    return this->_getDataSize();
+}
+
+/**
+ * @brief Get number of bytes used by one vertex
+ *
+ * @return Vertex size in bytes
+ */
+std::size_t GlyphMesh::_getVertexSize() const {
+    return this->_quantizedVertices ? 2 * sizeof(int16_t) : sizeof(glm::vec2);
+}
+
+/**
+ * @brief Get number of bytes used by one index
+ *
+ * @return Index size in bytes
+ */
+std::size_t GlyphMesh::_getIndexSize() const {
+    return this->_shortIndices ? sizeof(uint16_t) : sizeof(uint32_t);
+}
+
+/**
+ * @brief Get offset of the first index buffer in data. Vertex size is a multiple of index size, so indices are aligned
+ *
+ * @return Offset in bytes
+ */
+std::size_t GlyphMesh::_getIndicesStart() const {
+    return this->_vertexCount * this->_getVertexSize();
+}
+
+/**
+ * @brief Get size of allocation storing vertex and index buffers
+ *
+ * @return Size in bytes
+ */
+std::size_t GlyphMesh::_getDataSize() const {
+    return this->_getIndicesStart() + this->_indexOffsets[MAX_DRAW_COUNT] * this->_getIndexSize();
+}
+
+/**
+ * @brief Get index stored at given position of all index buffers
+ *
+ * @param index Position of index counted from the start of the first index buffer
+ *
+ * @return Index
+ */
+uint32_t GlyphMesh::_getIndex(uint32_t index) const {
+    const std::byte *indicesStart = this->_data.get() + this->_getIndicesStart();
+    if (this->_shortIndices) {
+        return reinterpret_cast<const uint16_t *>(indicesStart)[index];
+    }
+
+    return reinterpret_cast<const uint32_t *>(indicesStart)[index];
 }
 
 }  // namespace vft
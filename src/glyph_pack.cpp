@@ -0,0 +1,234 @@
+﻿/**
+ * @file glyph_pack.cpp
+ * @author Christian Saloň
+ */
+
+#include "glyph_pack.h"
+
+namespace vft {
+
+/**
+ * @brief GlyphPack constructor, creates an empty pack
+ *
+ * @param fontHash Hash of font contents, see Font::getContentHash()
+ * @param strategy Algorithm used to compose glyphs
+ * @param variant Tessellator settings used to compose glyphs, see Tessellator::getVariant()
+ */
+GlyphPack::GlyphPack(uint64_t fontHash, TessellationStrategy strategy, uint32_t variant)
+    : _fontHash{fontHash}, _strategy{strategy}, _variant{variant} {}
+
+/**
+ * @brief GlyphPack constructor, loads pack from file
+ *
+ * @param path Path to pack file
+ */
+GlyphPack::GlyphPack(const std::filesystem::path &path) {
+    std::ifstream file{path, std::ios::binary | std::ios::ate};
+    if (!file.is_open()) {
+        throw std::runtime_error("GlyphPack::GlyphPack(): Error opening glyph pack file");
+    }
+
+    uint64_t fileSize = static_cast<uint64_t>(file.tellg());
+    file.seekg(0);
+
+    PackHeader header;
+    if (fileSize < sizeof(PackHeader) || !file.read(reinterpret_cast<char *>(&header), sizeof(PackHeader))) {
+        throw std::runtime_error("GlyphPack::GlyphPack(): Glyph pack file is corrupted");
+    }
+    if (std::memcmp(header.magic, "VFGP", 4) != 0) {
+        throw std::runtime_error("GlyphPack::GlyphPack(): File is not a glyph pack");
+    }
+    if (header.version != FORMAT_VERSION) {
+        throw std::runtime_error("GlyphPack::GlyphPack(): Glyph pack was created by an unsupported version");
+    }
+
+    uint64_t tableSize = static_cast<uint64_t>(header.glyphCount) * sizeof(PackEntry);
+    if (sizeof(PackHeader) + tableSize > fileSize) {
+        throw std::runtime_error("GlyphPack::GlyphPack(): Glyph pack file is corrupted");
+    }
+
+    this->_fontHash = header.fontHash;
+    this->_strategy = static_cast<TessellationStrategy>(header.strategy);
+    this->_variant = header.variant;
+
+    // Read table and data section with one read each
+    uint64_t dataSize = fileSize - sizeof(PackHeader) - tableSize;
+    this->_entries.resize(header.glyphCount);
+    this->_data.resize((dataSize + sizeof(uint64_t) - 1) / sizeof(uint64_t));
+    if (!file.read(reinterpret_cast<char *>(this->_entries.data()), tableSize) ||
+        !file.read(reinterpret_cast<char *>(this->_data.data()), dataSize)) {
+        throw std::runtime_error("GlyphPack::GlyphPack(): Error reading glyph pack file");
+    }
+
+    for (const PackEntry &entry : this->_entries) {
+        if (entry.offset + entry.size > dataSize) {
+            throw std::runtime_error("GlyphPack::GlyphPack(): Glyph pack file is corrupted");
+        }
+    }
+}
+
+/**
+ * @brief Add glyph to pack. Can be called from several threads at once
+ *
+ * @param glyphId Glyph id
+ * @param fontSize Font size used as the key of glyph in cache, zero if glyph does not depend on font size
+ * @param glyph Composed glyph
+ */
+void GlyphPack::addGlyph(uint32_t glyphId, unsigned int fontSize, const Glyph &glyph) {
+    std::vector<char> glyphData = GlyphDiskCache::serialize(
+        GlyphDiskCache::Key{this->_fontHash, glyphId, fontSize, this->_strategy, this->_variant}, glyph);
+
+    std::lock_guard lock{this->_mutex};
+
+    uint64_t offset = this->_data.size() * sizeof(uint64_t);
+    this->_data.resize(this->_data.size() + (glyphData.size() + sizeof(uint64_t) - 1) / sizeof(uint64_t));
+    std::memcpy(reinterpret_cast<char *>(this->_data.data()) + offset, glyphData.data(), glyphData.size());
+
+    this->_entries.push_back(PackEntry{glyphId, fontSize, offset, glyphData.size()});
+}
+
+/**
+ * @brief Write pack to file. Glyphs are sorted by font size and glyph id, so the file does not depend on the order in
+ * which glyphs were added
+ *
+ * @param path Path to pack file
+ */
+void GlyphPack::save(const std::filesystem::path &path) const {
+    std::lock_guard lock{this->_mutex};
+
+    std::vector<unsigned int> order(this->_entries.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [this](unsigned int a, unsigned int b) {
+        const PackEntry &first = this->_entries[a];
+        const PackEntry &second = this->_entries[b];
+        return first.fontSize != second.fontSize ? first.fontSize < second.fontSize : first.glyphId < second.glyphId;
+    });
+
+    // Compute offsets of glyphs in sorted order
+    std::vector<PackEntry> entries;
+    entries.reserve(this->_entries.size());
+    uint64_t offset = 0;
+    for (unsigned int i : order) {
+        PackEntry entry = this->_entries[i];
+        entry.offset = offset;
+        entries.push_back(entry);
+
+        offset += (entry.size + sizeof(uint64_t) - 1) / sizeof(uint64_t) * sizeof(uint64_t);
+    }
+
+    PackHeader header{};
+    std::memcpy(header.magic, "VFGP", 4);
+    header.version = FORMAT_VERSION;
+    header.fontHash = this->_fontHash;
+    header.strategy = static_cast<uint32_t>(this->_strategy);
+    header.glyphCount = entries.size();
+    header.variant = this->_variant;
+
+    std::ofstream file{path, std::ios::binary | std::ios::trunc};
+    if (!file.is_open()) {
+        throw std::runtime_error("GlyphPack::save(): Error creating glyph pack file");
+    }
+
+    file.write(reinterpret_cast<const char *>(&header), sizeof(PackHeader));
+    file.write(reinterpret_cast<const char *>(entries.data()), entries.size() * sizeof(PackEntry));
+
+    const char padding[sizeof(uint64_t)]{};
+    for (unsigned int i : order) {
+        const PackEntry &entry = this->_entries[i];
+        file.write(reinterpret_cast<const char *>(this->_data.data()) + entry.offset, entry.size);
+        file.write(padding, (sizeof(uint64_t) - entry.size % sizeof(uint64_t)) % sizeof(uint64_t));
+    }
+
+    if (!file.good()) {
+        throw std::runtime_error("GlyphPack::save(): Error writing glyph pack file");
+    }
+}
+
+/**
+ * @brief Insert all glyphs of pack into glyph cache. Glyph keys do not contain the tessellation strategy, so the pack
+ * must be composed by the strategy and with the settings of the renderer using the cache
+ *
+ * @param cache Glyph cache to prefill
+ * @param font Font the pack was created from
+ * @param strategy Tessellation strategy of the renderer using the cache
+ * @param variant Tessellator settings of the renderer using the cache, e.g.
+ * TriangulationTessellator::LEVELS_OF_DETAIL_VARIANT if levels of detail are enabled
+ *
+ * @return Number of glyphs inserted into cache
+ *
+ * @throws std::runtime_error If pack was created from a different font, by a different tessellation strategy or with
+ * different tessellator settings
+ */
+unsigned int GlyphPack::prefill(GlyphCache &cache,
+                                std::shared_ptr<Font> font,
+                                TessellationStrategy strategy,
+                                uint32_t variant) const {
+    if (font->getContentHash() != this->_fontHash) {
+        throw std::runtime_error("GlyphPack::prefill(): Glyph pack was created from a different font");
+    }
+    if (strategy != this->_strategy) {
+        throw std::runtime_error("GlyphPack::prefill(): Glyph pack was created by a different tessellation strategy");
+    }
+    if (variant != this->_variant) {
+        throw std::runtime_error("GlyphPack::prefill(): Glyph pack was created with different tessellator settings");
+    }
+
+    std::lock_guard lock{this->_mutex};
+
+    std::string fontFamily = font->getFontFamily();
+    const char *data = reinterpret_cast<const char *>(this->_data.data());
+
+    unsigned int count = 0;
+    for (const PackEntry &entry : this->_entries) {
+        std::optional<Glyph> glyph = GlyphDiskCache::deserialize(
+            GlyphDiskCache::Key{this->_fontHash, entry.glyphId, entry.fontSize, this->_strategy, this->_variant},
+            data + entry.offset, entry.size);
+        if (!glyph.has_value()) {
+            throw std::runtime_error("GlyphPack::prefill(): Glyph pack file is corrupted");
+        }
+
+        cache.setGlyph(GlyphKey{fontFamily, entry.glyphId, entry.fontSize}, std::move(glyph.value()));
+        count++;
+    }
+
+    return count;
+}
+
+/**
+ * @brief Getter for hash of font the pack was created from
+ *
+ * @return Hash of font contents
+ */
+uint64_t GlyphPack::getFontHash() const {
+    return this->_fontHash;
+}
+
+/**
+ * @brief Getter for algorithm used to compose glyphs
+ *
+ * @return Tessellation strategy
+ */
+TessellationStrategy GlyphPack::getStrategy() const {
+    return this->_strategy;
+}
+
+/**
+ * @brief Getter for tessellator settings used to compose glyphs
+ *
+ * @return Variant of glyphs, see Tessellator::getVariant()
+ */
+uint32_t GlyphPack::getVariant() const {
+    return this->_variant;
+}
+
+/**
+ * @brief Get number of glyphs in pack
+ *
+ * @return Glyph count
+ */
+unsigned int GlyphPack::getGlyphCount() const {
+    std::lock_guard lock{this->_mutex};
+    return this->_entries.size();
+}
+
+}  // namespace vft
@@ -0,0 +1,107 @@
+/**
+ * @file histogram.cpp
+ * @author Christian Saloň
+ */
+
+#include "histogram.h"
+
+namespace vft {
+
+/**
+ * @brief Get average of recorded values
+ *
+ * @return Mean value, zero if no values were recorded
+ */
+double Histogram::Snapshot::getMean() const {
+    return this->count == 0 ? 0 : static_cast<double>(this->sum) / static_cast<double>(this->count);
+}
+
+/**
+ * @brief Estimate percentile of recorded values, the result is the upper bound of the bucket containing it
+ *
+ * @param percentile Percentile in range [0, 1] (e.g. 0.99)
+ *
+ * @return Upper estimate of percentile, zero if no values were recorded
+ */
+uint64_t Histogram::Snapshot::getPercentile(double percentile) const {
+    if (this->count == 0) {
+        return 0;
+    }
+
+    uint64_t rank = static_cast<uint64_t>(percentile * static_cast<double>(this->count));
+    uint64_t cumulativeCount = 0;
+    for (unsigned int i = 0; i < BUCKET_COUNT; i++) {
+        cumulativeCount += this->buckets[i];
+        if (cumulativeCount > rank) {
+            return std::min(Histogram::getBucketUpperBound(i), this->max);
+        }
+    }
+
+    return this->max;
+}
+
+/**
+ * @brief Record value into histogram
+ *
+ * @param value Recorded value
+ */
+void Histogram::record(uint64_t value) {
+    unsigned int bucket = std::min(static_cast<unsigned int>(std::bit_width(value)), BUCKET_COUNT - 1);
+    this->_buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+    this->_count.fetch_add(1, std::memory_order_relaxed);
+    this->_sum.fetch_add(value, std::memory_order_relaxed);
+
+    uint64_t min = this->_min.load(std::memory_order_relaxed);
+    while (value < min && !this->_min.compare_exchange_weak(min, value, std::memory_order_relaxed)) {
+    }
+
+    uint64_t max = this->_max.load(std::memory_order_relaxed);
+    while (value > max && !this->_max.compare_exchange_weak(max, value, std::memory_order_relaxed)) {
+    }
+}
+
+/**
+ * @brief Remove all recorded values
+ */
+void Histogram::reset() {
+    for (std::atomic<uint64_t> &bucket : this->_buckets) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+
+    this->_count.store(0, std::memory_order_relaxed);
+    this->_sum.store(0, std::memory_order_relaxed);
+    this->_min.store(UINT64_MAX, std::memory_order_relaxed);
+    this->_max.store(0, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Copy histogram data. Values recorded concurrently may be only partially included
+ *
+ * @return Snapshot of histogram
+ */
+Histogram::Snapshot Histogram::getSnapshot() const {
+    Snapshot snapshot{};
+    for (unsigned int i = 0; i < BUCKET_COUNT; i++) {
+        snapshot.buckets[i] = this->_buckets[i].load(std::memory_order_relaxed);
+    }
+
+    snapshot.count = this->_count.load(std::memory_order_relaxed);
+    snapshot.sum = this->_sum.load(std::memory_order_relaxed);
+    snapshot.min = snapshot.count == 0 ? 0 : this->_min.load(std::memory_order_relaxed);
+    snapshot.max = this->_max.load(std::memory_order_relaxed);
+
+    return snapshot;
+}
+
+/**
+ * @brief Get largest value counted in bucket
+ *
+ * @param bucket Index of bucket
+ *
+ * @return Upper bound of bucket
+ */
+uint64_t Histogram::getBucketUpperBound(unsigned int bucket) {
+    return bucket >= BUCKET_COUNT - 1 ? UINT64_MAX : (static_cast<uint64_t>(1) << bucket) - 1;
+}
+
+}  // namespace vft
@@ -0,0 +1,107 @@
+/**
+ * @file loop_blinn_tessellator.cpp
+ * @author Christian Saloň
+ */
+
+#include "loop_blinn_tessellator.h"
+
+namespace vft {
+
+/**
+ * @brief Composes a glyph ready for rendering
+ *
+ * @param glyphId Id of glyph to compose
+ * @param font Font of glyph
+ * @param fontSize Font size of glyph
+ */
+Glyph LoopBlinnTessellator::composeGlyph(uint32_t glyphId,
+                                         std::shared_ptr<vft::Font> font,
+                                         unsigned int fontSize) const {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    Context context{};
+
+    Glyph glyph = this->_composeGlyph(glyphId, font, context);
+
+    std::vector<glm::vec2> vertices;
+    std::vector<uint32_t> triangles;
+
+    if (context.contourCount >= 1) {
+        // Perform union of all contours
+        PolygonOperator polygonOperator{};
+        polygonOperator.unite(context.vertices, context.contours);
+        if (!polygonOperator.hasOverlappingContours()) {
+            this->_recordSkippedUnion();
+        }
+        vertices = polygonOperator.getVertices();
+        std::vector<Outline> polygon = polygonOperator.getPolygon();
+
+        // Triangulation of inner triangles
+        triangles = GlyphCompositor::triangulate(vertices, polygon);
+    }
+
+    // Every curve triangle gets its own vertices, because they differ in texture coordinates
+    std::vector<uint32_t> curveIndices;
+    curveIndices.reserve(3 * context.curveSegments.size());
+    for (Curve curve : context.curveSegments) {
+        for (uint32_t vertexIndex : {curve.start, curve.control, curve.end}) {
+            curveIndices.push_back(vertices.size());
+            vertices.push_back(context.vertices.at(vertexIndex));
+        }
+    }
+
+    glyph.mesh = GlyphMesh{vertices, {triangles, curveIndices}};
+
+    this->_recordStats(start, glyph, context.lineSegments.size() + context.curveSegments.size());
+
+    return glyph;
+}
+
+/**
+ * @brief Get algorithm used by this tessellator
+ *
+ * @return Tessellation strategy
+ */
+TessellationStrategy LoopBlinnTessellator::getStrategy() const {
+    return TessellationStrategy::LOOP_BLINN;
+}
+
+/**
+ * @brief Create a new tessellator of the same type, which records statistics together with this tessellator
+ *
+ * @return New tessellator
+ */
+std::unique_ptr<Tessellator> LoopBlinnTessellator::clone() const {
+    std::unique_ptr<Tessellator> tessellator = std::make_unique<LoopBlinnTessellator>();
+    this->_shareStats(*tessellator);
+
+    return tessellator;
+}
+
+/**
+ * @brief Get texture coordinates of start, control and end point of curve triangle. Points of the curve satisfy
+ * u^2 - v = 0, points between the curve and the line from start to end point satisfy u^2 - v < 0
+ *
+ * @return Texture coordinates of curve triangle vertices
+ */
+std::array<glm::vec2, 3> LoopBlinnTessellator::getCurveTextureCoordinates() {
+    return {glm::vec2{0.f, 0.f}, glm::vec2{0.5f, 0.f}, glm::vec2{1.f, 1.f}};
+}
+
+/**
+ * @brief Get on which side of curve the glyph is filled. Curves bulging out of the inner outline are filled between
+ * the curve and the line from start to end point, curves bulging into it are filled between the curve and control point
+ *
+ * @param start Curve start point
+ * @param control Curve control point
+ * @param end Curve end point
+ *
+ * @return 1 if fragments with u^2 - v < 0 are filled, -1 if fragments with u^2 - v > 0 are filled
+ */
+float LoopBlinnTessellator::getCurveOrientation(const glm::vec2 &start,
+                                                const glm::vec2 &control,
+                                                const glm::vec2 &end) {
+    return TessellationShadersTessellator::_isOnLeftSide(start, end, control) ? 1.f : -1.f;
+}
+
+}  // namespace vft
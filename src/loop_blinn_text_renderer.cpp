@@ -0,0 +1,78 @@
+/**
+ * @file loop_blinn_text_renderer.cpp
+ * @author Christian Saloň
+ */
+
+#include "loop_blinn_text_renderer.h"
+
+namespace vft {
+
+/**
+ * @brief Initialize Loop-Blinn text renderer
+ */
+LoopBlinnTextRenderer::LoopBlinnTextRenderer() {
+    this->_tessellator = std::make_shared<LoopBlinnTessellator>();
+}
+
+/**
+ * @brief Recreates vertex and index buffers for all characters in text block
+ */
+void LoopBlinnTextRenderer::update() {
+    this->_resetCompositionBudget();
+
+    this->_vertices.clear();
+    this->_indices.clear();
+    this->_offsets.clear();
+
+    uint32_t vertexCount = 0;
+    uint32_t indexCount = 0;
+
+    std::array<glm::vec2, 3> curveTextureCoordinates = LoopBlinnTessellator::getCurveTextureCoordinates();
+
+    for (unsigned int i = 0; i < this->_textBlocks.size(); i++) {
+        for (const Character &character : this->_textBlocks[i]->getCharacters()) {
+            GlyphKey key = this->_getGlyphKey(character);
+
+            if (!this->_offsets.contains(key)) {
+                // Get glyph from cache, compose it if it is missing
+                std::shared_ptr<const Glyph> glyph = this->_getGlyph(key, character);
+
+                // Inner triangles are always filled, u^2 - v = -1 everywhere inside of them
+                for (const glm::vec2 &position : glyph->mesh.getVertices()) {
+                    this->_vertices.push_back(Vertex{position, glm::vec2{0.f, 1.f}, 1.f});
+                }
+
+                // Vertices of every curve triangle are dedicated to it, so they get curve texture coordinates
+                std::vector<uint32_t> curveIndices =
+                    glyph->mesh.getIndices(LoopBlinnTessellator::GLYPH_MESH_CURVE_BUFFER_INDEX);
+                for (std::size_t j = 0; j + 2 < curveIndices.size(); j += 3) {
+                    float orientation = LoopBlinnTessellator::getCurveOrientation(
+                        glyph->mesh.getVertex(curveIndices[j]), glyph->mesh.getVertex(curveIndices[j + 1]),
+                        glyph->mesh.getVertex(curveIndices[j + 2]));
+                    for (unsigned int k = 0; k < curveTextureCoordinates.size(); k++) {
+                        Vertex &vertex = this->_vertices[vertexCount + curveIndices[j + k]];
+                        vertex.uv = curveTextureCoordinates[k];
+                        vertex.orientation = orientation;
+                    }
+                }
+
+                // Create index buffer, offset indices by vertices of previous glyphs
+                glyph->mesh.appendIndices(LoopBlinnTessellator::GLYPH_MESH_TRIANGLE_BUFFER_INDEX, this->_indices,
+                                          vertexCount);
+                glyph->mesh.appendIndices(LoopBlinnTessellator::GLYPH_MESH_CURVE_BUFFER_INDEX, this->_indices,
+                                          vertexCount);
+
+                // Compute buffer offsets
+                uint32_t glyphIndexCount =
+                    glyph->mesh.getIndexCount(LoopBlinnTessellator::GLYPH_MESH_TRIANGLE_BUFFER_INDEX) +
+                    glyph->mesh.getIndexCount(LoopBlinnTessellator::GLYPH_MESH_CURVE_BUFFER_INDEX);
+                this->_offsets.insert({key, GlyphInfo{indexCount, glyphIndexCount}});
+
+                vertexCount += glyph->mesh.getVertexCount();
+                indexCount += glyphIndexCount;
+            }
+        }
+    }
+}
+
+}  // namespace vft
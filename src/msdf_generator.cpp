@@ -0,0 +1,645 @@
+/**
+ * @file msdf_generator.cpp
+ * @author Christian Saloň
+ *
+ * Segment coloring, signed pseudo-distances and error correction are adapted from msdfgen
+ * (https://github.com/Chlumsky/msdfgen), which is distributed under the following license:
+ *
+ * MIT License
+ *
+ * Copyright (c) 2014 - 2024 Viktor Chlumsky
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ * Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "msdf_generator.h"
+
+namespace vft {
+
+/**
+ * @brief Compare signed distances by their size, distances of equal size are compared by the dot product
+ *
+ * @param other Signed distance to compare with
+ *
+ * @return True if this distance is nearer than the other one
+ */
+bool MsdfGenerator::SignedDistance::operator<(const SignedDistance &other) const {
+    return std::abs(this->distance) < std::abs(other.distance) ||
+           (std::abs(this->distance) == std::abs(other.distance) && this->dot < other.dot);
+}
+
+/**
+ * @brief Decompose outline into contours of lines and quadratic bezier curves and color their segments, cubic bezier
+ * curves are approximated by two quadratic bezier curves
+ *
+ * @param outline Freetype outline of glyph in 26.6 fixed point format
+ */
+MsdfGenerator::MsdfGenerator(const FT_Outline &outline) {
+    FT_Outline_Funcs functions{};
+
+    functions.move_to = [](const FT_Vector *to, void *user) {
+        Context *context = static_cast<Context *>(user);
+
+        context->contours.push_back({});
+        context->lastPoint = glm::dvec2{to->x / 64.0, to->y / 64.0};
+
+        return 0;
+    };
+
+    functions.line_to = [](const FT_Vector *to, void *user) {
+        Context *context = static_cast<Context *>(user);
+
+        glm::dvec2 end{to->x / 64.0, to->y / 64.0};
+        if (end != context->lastPoint) {
+            context->contours.back().push_back(
+                Segment{{context->lastPoint, 0.5 * (context->lastPoint + end), end}, false, WHITE});
+        }
+        context->lastPoint = end;
+
+        return 0;
+    };
+
+    functions.conic_to = [](const FT_Vector *control, const FT_Vector *to, void *user) {
+        Context *context = static_cast<Context *>(user);
+
+        glm::dvec2 end{to->x / 64.0, to->y / 64.0};
+        context->contours.back().push_back(
+            Segment{{context->lastPoint, glm::dvec2{control->x / 64.0, control->y / 64.0}, end}, true, WHITE});
+        context->lastPoint = end;
+
+        return 0;
+    };
+
+    functions.cubic_to = [](const FT_Vector *firstControl, const FT_Vector *secondControl, const FT_Vector *to,
+                            void *user) {
+        Context *context = static_cast<Context *>(user);
+
+        std::array<glm::dvec2, 4> cubic{context->lastPoint, glm::dvec2{firstControl->x / 64.0, firstControl->y / 64.0},
+                                        glm::dvec2{secondControl->x / 64.0, secondControl->y / 64.0},
+                                        glm::dvec2{to->x / 64.0, to->y / 64.0}};
+
+        // Split cubic curve in half, each half with control points q1 and q2 is approximated by a quadratic curve
+        // with control point (3 * (q1 + q2) - (start + end)) / 4
+        glm::dvec2 middle = 0.125 * (cubic[0] + 3.0 * cubic[1] + 3.0 * cubic[2] + cubic[3]);
+        glm::dvec2 firstControlPoint =
+            0.25 * (1.5 * (cubic[0] + cubic[1]) + 0.75 * (cubic[0] + 2.0 * cubic[1] + cubic[2]) - cubic[0] - middle);
+        glm::dvec2 secondControlPoint =
+            0.25 * (0.75 * (cubic[1] + 2.0 * cubic[2] + cubic[3]) + 1.5 * (cubic[2] + cubic[3]) - middle - cubic[3]);
+
+        context->contours.back().push_back(Segment{{cubic[0], firstControlPoint, middle}, true, WHITE});
+        context->contours.back().push_back(Segment{{middle, secondControlPoint, cubic[3]}, true, WHITE});
+        context->lastPoint = cubic[3];
+
+        return 0;
+    };
+
+    Context context{};
+    if (FT_Outline_Decompose(const_cast<FT_Outline *>(&outline), &functions, &context)) {
+        throw std::runtime_error("MsdfGenerator::MsdfGenerator(): Error decomposing outline");
+    }
+
+    // Remove contours without any segment
+    for (std::vector<Segment> &contour : context.contours) {
+        if (!contour.empty()) {
+            this->_contours.push_back(std::move(contour));
+        }
+    }
+
+    FT_Orientation orientation = FT_Outline_Get_Orientation(const_cast<FT_Outline *>(&outline));
+    this->_orientation = orientation == FT_ORIENTATION_POSTSCRIPT ? -1.0 : 1.0;
+
+    this->_colorSegments();
+}
+
+/**
+ * @brief Generate multi-channel signed distance field of outline, distances are positive inside of outline
+ *
+ * @param origin Top left corner of bitmap in outline coordinates
+ * @param pixelSize Size of one pixel of bitmap in outline coordinates
+ * @param range Distance in outline coordinates mapped to the ends of the encoded range
+ * @param width Width of bitmap in pixels
+ * @param height Height of bitmap in pixels
+ * @param bitmap Bitmap with CHANNEL_COUNT bytes per pixel, rows are ordered from top to bottom
+ */
+void MsdfGenerator::generate(const glm::dvec2 &origin,
+                             const glm::dvec2 &pixelSize,
+                             double range,
+                             unsigned int width,
+                             unsigned int height,
+                             std::vector<uint8_t> &bitmap) const {
+    bitmap.assign(width * height * MsdfGenerator::CHANNEL_COUNT, 255);
+
+    for (unsigned int y = 0; y < height; y++) {
+        for (unsigned int x = 0; x < width; x++) {
+            glm::dvec2 point{origin.x + (x + 0.5) * pixelSize.x, origin.y - (y + 0.5) * pixelSize.y};
+
+            // Find the nearest segment of each channel and the nearest segment of all
+            std::array<NearestSegment, 3> channels{};
+            SignedDistance nearest{};
+            for (const std::vector<Segment> &contour : this->_contours) {
+                for (const Segment &segment : contour) {
+                    double parameter = 0;
+                    SignedDistance distance = MsdfGenerator::_getSignedDistance(segment, point, parameter);
+                    if (distance < nearest) {
+                        nearest = distance;
+                    }
+
+                    for (unsigned int channel = 0; channel < channels.size(); channel++) {
+                        if ((segment.color & (1 << channel)) && distance < channels[channel].distance) {
+                            channels[channel] = NearestSegment{distance, &segment, parameter};
+                        }
+                    }
+                }
+            }
+
+            std::array<double, 3> distances{};
+            for (unsigned int channel = 0; channel < channels.size(); channel++) {
+                if (channels[channel].segment == nullptr) {
+                    distances[channel] = this->_orientation * nearest.distance;
+                    continue;
+                }
+
+                MsdfGenerator::_convertToPseudoDistance(*channels[channel].segment, point, channels[channel].parameter,
+                                                        channels[channel].distance);
+                distances[channel] = this->_orientation * channels[channel].distance.distance;
+            }
+
+            // Median of channels must be inside of outline exactly where the point is, otherwise overlapping contours
+            // or a clash of channels would create artifacts
+            double median = std::max(std::min(distances[0], distances[1]),
+                                     std::min(std::max(distances[0], distances[1]), distances[2]));
+            bool isInside = this->_getWindingNumber(point) != 0;
+            if ((median > 0) != isInside) {
+                double trueDistance = isInside ? std::abs(nearest.distance) : -std::abs(nearest.distance);
+                distances = {trueDistance, trueDistance, trueDistance};
+            }
+
+            std::size_t pixel = (y * width + x) * MsdfGenerator::CHANNEL_COUNT;
+            for (unsigned int channel = 0; channel < channels.size(); channel++) {
+                bitmap[pixel + channel] = MsdfGenerator::_encodeDistance(distances[channel], range);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Color segments of all contours, segments meeting at a corner never share two color channels. Contours without
+ * corners are white, so all channels store the same distance
+ */
+void MsdfGenerator::_colorSegments() {
+    double crossThreshold = std::sin(MsdfGenerator::CORNER_ANGLE_THRESHOLD);
+    unsigned int seed = 0;
+
+    for (std::vector<Segment> &contour : this->_contours) {
+        // Find segments starting at a corner
+        std::vector<std::size_t> corners;
+        glm::dvec2 previousDirection = MsdfGenerator::_getDirection(contour.back(), 1);
+        for (std::size_t i = 0; i < contour.size(); i++) {
+            if (MsdfGenerator::_isCorner(glm::normalize(previousDirection),
+                                         glm::normalize(MsdfGenerator::_getDirection(contour[i], 0)), crossThreshold)) {
+                corners.push_back(i);
+            }
+            previousDirection = MsdfGenerator::_getDirection(contour[i], 1);
+        }
+
+        if (corners.empty()) {
+            for (Segment &segment : contour) {
+                segment.color = WHITE;
+            }
+        } else if (corners.size() == 1) {
+            // Teardrop, the contour is split into three parts, the middle one is white
+            std::array<uint8_t, 3> colors{};
+            uint8_t color = WHITE;
+            MsdfGenerator::_switchColor(color, seed);
+            colors[0] = color;
+            colors[1] = WHITE;
+            MsdfGenerator::_switchColor(color, seed);
+            colors[2] = color;
+
+            std::size_t corner = corners[0];
+            if (contour.size() < 3) {
+                contour = MsdfGenerator::_splitIntoThirds(contour);
+                corner *= 3;
+            }
+
+            std::size_t count = contour.size();
+            for (std::size_t i = 0; i < count; i++) {
+                int part = static_cast<int>(3 + 2.875 * i / (count - 1) - 1.4375 + 0.5) - 2;
+                contour[(corner + i) % count].color = colors[part];
+            }
+        } else {
+            // Color changes at every corner, the last color must differ from the first one
+            uint8_t color = WHITE;
+            MsdfGenerator::_switchColor(color, seed);
+            uint8_t initialColor = color;
+
+            std::size_t spline = 0;
+            for (std::size_t i = 0; i < contour.size(); i++) {
+                std::size_t index = (corners[0] + i) % contour.size();
+                if (spline + 1 < corners.size() && corners[spline + 1] == index) {
+                    spline++;
+                    MsdfGenerator::_switchColor(color, seed, spline == corners.size() - 1 ? initialColor : 0);
+                }
+                contour[index].color = color;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Switch to a color with two channels, which shares exactly one channel with the current color
+ *
+ * @param color Current color, it is replaced by the new color
+ * @param seed Seed selecting one of the possible colors
+ * @param bannedColor Color which must share at most one channel with the new color
+ */
+void MsdfGenerator::_switchColor(uint8_t &color, unsigned int &seed, uint8_t bannedColor) {
+    uint8_t combined = color & bannedColor;
+    if (combined == RED || combined == GREEN || combined == BLUE) {
+        color = combined ^ WHITE;
+        return;
+    }
+
+    if (color == 0 || color == WHITE) {
+        static constexpr std::array<uint8_t, 3> start{GREEN | BLUE, RED | BLUE, RED | GREEN};
+        color = start[seed % 3];
+        seed /= 3;
+        return;
+    }
+
+    unsigned int shifted = color << (1 + (seed & 1));
+    color = (shifted | shifted >> 3) & WHITE;
+    seed >>= 1;
+}
+
+/**
+ * @brief Check whether two segments meet at a corner
+ *
+ * @param previousDirection Normalized direction at the end of the first segment
+ * @param nextDirection Normalized direction at the start of the second segment
+ * @param threshold Sine of the min angle between directions of segments meeting at a corner
+ *
+ * @return True if the segments meet at a corner
+ */
+bool MsdfGenerator::_isCorner(const glm::dvec2 &previousDirection, const glm::dvec2 &nextDirection, double threshold) {
+    return glm::dot(previousDirection, nextDirection) <= 0 ||
+           std::abs(MsdfGenerator::_cross(previousDirection, nextDirection)) > threshold;
+}
+
+/**
+ * @brief Split every segment of contour into three segments with the same shape
+ *
+ * @param contour Contour to split
+ *
+ * @return Contour with three times more segments
+ */
+std::vector<MsdfGenerator::Segment> MsdfGenerator::_splitIntoThirds(const std::vector<Segment> &contour) {
+    std::vector<Segment> split;
+    for (const Segment &segment : contour) {
+        for (unsigned int i = 0; i < 3; i++) {
+            double start = i / 3.0;
+            double end = (i + 1) / 3.0;
+
+            // Control point of part of quadratic curve lies on the tangent at the part's start
+            glm::dvec2 startPoint = MsdfGenerator::_getPoint(segment, start);
+            glm::dvec2 endPoint = MsdfGenerator::_getPoint(segment, end);
+            glm::dvec2 controlPoint = segment.isCurve
+                                          ? startPoint + (end - start) * MsdfGenerator::_getDirection(segment, start)
+                                          : 0.5 * (startPoint + endPoint);
+
+            split.push_back(Segment{{startPoint, controlPoint, endPoint}, segment.isCurve, segment.color});
+        }
+    }
+
+    return split;
+}
+
+/**
+ * @brief Evaluate point of segment
+ *
+ * @param segment Line or quadratic bezier curve
+ * @param parameter Parameter of point
+ *
+ * @return Point of segment
+ */
+glm::dvec2 MsdfGenerator::_getPoint(const Segment &segment, double parameter) {
+    if (!segment.isCurve) {
+        return glm::mix(segment.points[0], segment.points[2], parameter);
+    }
+
+    return glm::mix(glm::mix(segment.points[0], segment.points[1], parameter),
+                    glm::mix(segment.points[1], segment.points[2], parameter), parameter);
+}
+
+/**
+ * @brief Get direction of segment, the direction of a quadratic curve is half of its derivative
+ *
+ * @param segment Line or quadratic bezier curve
+ * @param parameter Parameter of point
+ *
+ * @return Direction of segment at the point
+ */
+glm::dvec2 MsdfGenerator::_getDirection(const Segment &segment, double parameter) {
+    if (!segment.isCurve) {
+        return segment.points[2] - segment.points[0];
+    }
+
+    glm::dvec2 tangent =
+        glm::mix(segment.points[1] - segment.points[0], segment.points[2] - segment.points[1], parameter);
+    if (tangent == glm::dvec2{0, 0}) {
+        // Control point coincides with an end point
+        return segment.points[2] - segment.points[0];
+    }
+
+    return tangent;
+}
+
+/**
+ * @brief Compute signed distance from segment to point, positive on the right side of segment
+ *
+ * @param segment Line or quadratic bezier curve
+ * @param point Point
+ * @param parameter Parameter of the nearest point of segment, it is outside of [0, 1] if the nearest point is an end
+ * point and the point lies beyond it
+ *
+ * @return Signed distance
+ */
+MsdfGenerator::SignedDistance MsdfGenerator::_getSignedDistance(const Segment &segment,
+                                                                const glm::dvec2 &point,
+                                                                double &parameter) {
+    if (!segment.isCurve) {
+        glm::dvec2 startToPoint = point - segment.points[0];
+        glm::dvec2 direction = segment.points[2] - segment.points[0];
+        parameter = glm::dot(startToPoint, direction) / glm::dot(direction, direction);
+
+        glm::dvec2 endPointToPoint = (parameter > 0.5 ? segment.points[2] : segment.points[0]) - point;
+        double endPointDistance = glm::length(endPointToPoint);
+        if (parameter > 0 && parameter < 1) {
+            double orthogonalDistance = MsdfGenerator::_cross(startToPoint, direction) / glm::length(direction);
+            if (std::abs(orthogonalDistance) < endPointDistance) {
+                return SignedDistance{orthogonalDistance, 0};
+            }
+        }
+
+        double sign = MsdfGenerator::_cross(startToPoint, direction) >= 0 ? 1 : -1;
+        return SignedDistance{sign * endPointDistance,
+                              std::abs(glm::dot(glm::normalize(direction), glm::normalize(endPointToPoint)))};
+    }
+
+    // Nearest point of curve B(t) satisfies dot(B(t) - point, B'(t)) = 0, which is a cubic equation
+    glm::dvec2 pointToStart = segment.points[0] - point;
+    glm::dvec2 firstDifference = segment.points[1] - segment.points[0];
+    glm::dvec2 secondDifference = segment.points[2] - segment.points[1] - firstDifference;
+    std::array<double, 3> roots{};
+    unsigned int rootCount = MsdfGenerator::_solveCubic(
+        roots, glm::dot(secondDifference, secondDifference), 3 * glm::dot(firstDifference, secondDifference),
+        2 * glm::dot(firstDifference, firstDifference) + glm::dot(pointToStart, secondDifference),
+        glm::dot(pointToStart, firstDifference));
+
+    // Distance from start point
+    glm::dvec2 startDirection = MsdfGenerator::_getDirection(segment, 0);
+    double minDistance =
+        (MsdfGenerator::_cross(startDirection, pointToStart) >= 0 ? 1 : -1) * glm::length(pointToStart);
+    parameter = -glm::dot(pointToStart, startDirection) / glm::dot(startDirection, startDirection);
+
+    // Distance from end point
+    glm::dvec2 endDirection = MsdfGenerator::_getDirection(segment, 1);
+    glm::dvec2 pointToEnd = segment.points[2] - point;
+    if (glm::length(pointToEnd) < std::abs(minDistance)) {
+        minDistance = (MsdfGenerator::_cross(endDirection, pointToEnd) >= 0 ? 1 : -1) * glm::length(pointToEnd);
+        parameter = glm::dot(point - segment.points[1], endDirection) / glm::dot(endDirection, endDirection);
+    }
+
+    // Distance from inner points
+    for (unsigned int i = 0; i < rootCount; i++) {
+        if (roots[i] > 0 && roots[i] < 1) {
+            glm::dvec2 pointToCurve =
+                pointToStart + 2 * roots[i] * firstDifference + roots[i] * roots[i] * secondDifference;
+            double distance = glm::length(pointToCurve);
+            if (distance <= std::abs(minDistance)) {
+                glm::dvec2 direction = firstDifference + roots[i] * secondDifference;
+                minDistance = (MsdfGenerator::_cross(direction, pointToCurve) >= 0 ? 1 : -1) * distance;
+                parameter = roots[i];
+            }
+        }
+    }
+
+    if (parameter >= 0 && parameter <= 1) {
+        return SignedDistance{minDistance, 0};
+    }
+    if (parameter < 0.5) {
+        return SignedDistance{minDistance,
+                              std::abs(glm::dot(glm::normalize(startDirection), glm::normalize(pointToStart)))};
+    }
+    return SignedDistance{minDistance, std::abs(glm::dot(glm::normalize(endDirection), glm::normalize(pointToEnd)))};
+}
+
+/**
+ * @brief Replace distance from the end point of segment by the distance from the segment's extension along its end
+ * tangent, if the point lies beyond the end point. Corners are then reconstructed sharp by the median of channels
+ *
+ * @param segment Line or quadratic bezier curve
+ * @param point Point
+ * @param parameter Parameter of the nearest point of segment
+ * @param distance Signed distance from segment, it is replaced by the pseudo-distance
+ */
+void MsdfGenerator::_convertToPseudoDistance(const Segment &segment,
+                                             const glm::dvec2 &point,
+                                             double parameter,
+                                             SignedDistance &distance) {
+    if (parameter >= 0 && parameter <= 1) {
+        return;
+    }
+
+    bool isBeforeStart = parameter < 0;
+    glm::dvec2 direction = glm::normalize(MsdfGenerator::_getDirection(segment, isBeforeStart ? 0 : 1));
+    glm::dvec2 endPointToPoint = point - segment.points[isBeforeStart ? 0 : 2];
+    double tangentDistance = glm::dot(endPointToPoint, direction);
+    if (isBeforeStart ? tangentDistance < 0 : tangentDistance > 0) {
+        double perpendicularDistance = MsdfGenerator::_cross(endPointToPoint, direction);
+        if (std::abs(perpendicularDistance) <= std::abs(distance.distance)) {
+            distance = SignedDistance{perpendicularDistance, 0};
+        }
+    }
+}
+
+/**
+ * @brief Compute winding number of outline around point by counting crossings of a ray cast from the point in the
+ * direction of x axis, quadratic curves are split into parts monotonic in y
+ *
+ * @param point Point
+ *
+ * @return Winding number, the point is inside of outline if it is nonzero
+ */
+int MsdfGenerator::_getWindingNumber(const glm::dvec2 &point) const {
+    int winding = 0;
+
+    for (const std::vector<Segment> &contour : this->_contours) {
+        for (const Segment &segment : contour) {
+            double startY = segment.points[0].y;
+            double controlY = segment.points[1].y;
+            double endY = segment.points[2].y;
+
+            // Parameters bounding parts of segment monotonic in y
+            std::array<double, 3> bounds{0, 1, 1};
+            unsigned int partCount = 1;
+            double a = startY - 2 * controlY + endY;
+            if (segment.isCurve && a != 0) {
+                double extremum = (startY - controlY) / a;
+                if (extremum > 0 && extremum < 1) {
+                    bounds = {0, extremum, 1};
+                    partCount = 2;
+                }
+            }
+
+            for (unsigned int i = 0; i < partCount; i++) {
+                double partStartY = MsdfGenerator::_getPoint(segment, bounds[i]).y;
+                double partEndY = MsdfGenerator::_getPoint(segment, bounds[i + 1]).y;
+                if ((partStartY <= point.y) == (partEndY <= point.y)) {
+                    continue;
+                }
+
+                // Find parameter of the crossing inside of the part
+                double parameter =
+                    bounds[i] + (bounds[i + 1] - bounds[i]) * (point.y - partStartY) / (partEndY - partStartY);
+                if (segment.isCurve) {
+                    std::array<double, 3> roots{};
+                    unsigned int rootCount =
+                        MsdfGenerator::_solveQuadratic(roots, a, 2 * (controlY - startY), startY - point.y);
+                    for (unsigned int j = 0; j < rootCount; j++) {
+                        if (roots[j] >= bounds[i] && roots[j] <= bounds[i + 1]) {
+                            parameter = roots[j];
+                        }
+                    }
+                }
+
+                if (MsdfGenerator::_getPoint(segment, parameter).x > point.x) {
+                    winding += partEndY > partStartY ? 1 : -1;
+                }
+            }
+        }
+    }
+
+    return winding;
+}
+
+/**
+ * @brief Solve quadratic equation a * x^2 + b * x + c = 0
+ *
+ * @param roots Real roots of equation
+ * @param a Quadratic coefficient
+ * @param b Linear coefficient
+ * @param c Constant coefficient
+ *
+ * @return Number of real roots
+ */
+unsigned int MsdfGenerator::_solveQuadratic(std::array<double, 3> &roots, double a, double b, double c) {
+    if (a == 0 || std::abs(b) > 1e12 * std::abs(a)) {
+        // Linear equation
+        if (b == 0) {
+            return 0;
+        }
+        roots[0] = -c / b;
+        return 1;
+    }
+
+    double discriminant = b * b - 4 * a * c;
+    if (discriminant > 0) {
+        discriminant = std::sqrt(discriminant);
+        roots[0] = (-b + discriminant) / (2 * a);
+        roots[1] = (-b - discriminant) / (2 * a);
+        return 2;
+    }
+    if (discriminant == 0) {
+        roots[0] = -b / (2 * a);
+        return 1;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Solve cubic equation a * x^3 + b * x^2 + c * x + d = 0 using the trigonometric or Cardano's formula
+ *
+ * @param roots Real roots of equation
+ * @param a Cubic coefficient
+ * @param b Quadratic coefficient
+ * @param c Linear coefficient
+ * @param d Constant coefficient
+ *
+ * @return Number of real roots
+ */
+unsigned int MsdfGenerator::_solveCubic(std::array<double, 3> &roots, double a, double b, double c, double d) {
+    // Equation is treated as quadratic if the cubic coefficient is too small relative to others
+    if (a == 0 || std::abs(b / a) >= 1e6) {
+        return MsdfGenerator::_solveQuadratic(roots, b, c, d);
+    }
+
+    // Normalized equation x^3 + b * x^2 + c * x + d = 0
+    b /= a;
+    c /= a;
+    d /= a;
+
+    double q = (b * b - 3 * c) / 9;
+    double r = (b * (2 * b * b - 9 * c) + 27 * d) / 54;
+    double qCubed = q * q * q;
+    double shift = b / 3;
+
+    if (r * r < qCubed) {
+        // Three real roots
+        double angle = std::acos(std::clamp(r / std::sqrt(qCubed), -1.0, 1.0));
+        double scale = -2 * std::sqrt(q);
+        roots[0] = scale * std::cos(angle / 3) - shift;
+        roots[1] = scale * std::cos((angle + 2 * std::numbers::pi) / 3) - shift;
+        roots[2] = scale * std::cos((angle - 2 * std::numbers::pi) / 3) - shift;
+        return 3;
+    }
+
+    double u = (r < 0 ? 1 : -1) * std::cbrt(std::abs(r) + std::sqrt(r * r - qCubed));
+    double v = u == 0 ? 0 : q / u;
+    roots[0] = u + v - shift;
+    if (u == v || std::abs(u - v) < 1e-12 * std::abs(u + v)) {
+        roots[1] = -0.5 * (u + v) - shift;
+        return 2;
+    }
+
+    return 1;
+}
+
+/**
+ * @brief Compute z coordinate of cross product of two vectors
+ *
+ * @param first First vector
+ * @param second Second vector
+ *
+ * @return Cross product
+ */
+double MsdfGenerator::_cross(const glm::dvec2 &first, const glm::dvec2 &second) {
+    return first.x * second.y - first.y * second.x;
+}
+
+/**
+ * @brief Map signed distance to byte, distances -range, 0 and range are mapped to 0, 128 and 255
+ *
+ * @param distance Signed distance
+ * @param range Max encoded distance
+ *
+ * @return Encoded distance
+ */
+uint8_t MsdfGenerator::_encodeDistance(double distance, double range) {
+    double value = std::clamp(0.5 + distance / (2 * range), 0.0, 1.0);
+    return static_cast<uint8_t>(std::lround(value * 255));
+}
+
+}  // namespace vft
@@ -8,7 +8,7 @@
 namespace vft {
 
 /**
- * @brief Union of two polygons
+ * @brief Union of two polygons, computed by unite() on contours of both polygons
  *
  * @param vertices Vertices of both polygons
  * @param first First polygon
@@ -17,919 +17,698 @@ namespace vft {
 void PolygonOperator::join(const std::vector<glm::vec2> &vertices,
                            const std::vector<Outline> &first,
                            const std::vector<Outline> &second) {
-    this->_initializeContours(vertices, first, second);
-    this->_resolveOverlappingEdges();
-    this->_resolveIntersectingEdges();
+    std::vector<Outline> polygon = first;
+    polygon.insert(polygon.end(), second.begin(), second.end());
 
-    std::vector<Contour> allContours = this->_first;
-    allContours.insert(allContours.end(), this->_second.begin(), this->_second.end());
-    this->_removeUnwantedIntersections(this->_intersections, allContours);
-
-    this->_walkContours();
+    this->unite(vertices, polygon);
 }
 
 /**
- * @brief Initialize polygons to be ready for traversal
+ * @brief Union of all contours of one polygon under the nonzero fill rule, all contours are resolved in a single pass.
+ * Edges are split at all intersections, winding numbers on both sides of every split edge are computed and only edges
+ * separating filled and empty area are kept. Output contours have filled area on their right side
  *
- * @param vertices Vertices of both polygons
- * @param first First polygon
- * @param second Second polygon
+ * @param vertices Vertices of polygon
+ * @param polygon Contours of polygon, they can intersect each other and themselves
  */
-void PolygonOperator::_initializeContours(const std::vector<glm::vec2> &vertices,
-                                          const std::vector<Outline> &first,
-                                          const std::vector<Outline> &second) {
+void PolygonOperator::unite(const std::vector<glm::vec2> &vertices, const std::vector<Outline> &polygon) {
     // Reset polygons
-    this->_first.clear();
-    this->_second.clear();
+    this->_edges.clear();
     this->_output.clear();
 
-    // Initialize first polygon
     this->_vertices = vertices;
-    for (Outline outline : first) {
-        for (Outline contourWithNoIntersections : this->_resolveSelfIntersections(outline)) {
-            this->_first.push_back(Contour{false, contourWithNoIntersections});
-        }
+
+    // Contours which do not touch each other nor themselves are only kept or removed as a whole
+    this->_hasOverlappingContours = this->_hasOverlappingEdges(polygon);
+    if (!this->_hasOverlappingContours) {
+        this->_selectNonzeroContours(polygon);
+        return;
     }
 
-    // Initialize second polygon
-    for (Outline outline : second) {
-        for (Outline contourWithNoIntersections : this->_resolveSelfIntersections(outline)) {
-            this->_second.push_back(Contour{false, contourWithNoIntersections});
+    this->_edges.clear();
+
+    // Vertices at the same position are merged, so overlapping edges of different contours share their vertices
+    std::vector<uint32_t> replacement = this->_weldVertices();
+    std::vector<Outline> welded = polygon;
+    for (Outline &outline : welded) {
+        for (Edge &edge : outline.edges) {
+            edge = Edge{replacement.at(edge.first), replacement.at(edge.second)};
         }
+
+        std::erase_if(outline.edges, [](const Edge &edge) { return edge.first == edge.second; });
+    }
+
+    std::vector<Edge> edges = this->_splitAtIntersections(welded);
+
+    // Intersections found by different pairs of edges at the same point are merged as well
+    replacement = this->_weldVertices();
+    for (Edge &edge : edges) {
+        edge = Edge{replacement[edge.first], replacement[edge.second]};
     }
+
+    std::vector<Edge> boundary = this->_selectNonzeroBoundary(edges);
+    this->_linkBoundary(boundary);
 }
 
 /**
- * @brief Resolve self intersections of one outline
+ * @brief Check whether any two edges of polygon intersect, touch or overlap, only edges with overlapping bounding
+ * boxes are tested
  *
- * @param outline Given outline
+ * @param polygon Contours of polygon
  *
- * @return Outlines with no self intersections
+ * @return True if any edges overlap
  */
-std::vector<Outline> PolygonOperator::_resolveSelfIntersections(Outline outline) {
-    std::list<uint32_t> intersections;
-
-    // Handle overlapping edges
-    for (unsigned int i = 0; i < outline.edges.size(); i++) {
-        Edge firstEdge{outline.edges.getAt(i)->value.first, outline.edges.getAt(i)->value.second};
-
-        for (unsigned int j = i + 2; j < outline.edges.size(); j++) {
-            Edge secondEdge{outline.edges.getAt(j)->value.first, outline.edges.getAt(j)->value.second};
-
-            // Skip duplicate edges
-            if (firstEdge.first == secondEdge.first && firstEdge.second == secondEdge.second) {
-                continue;
-            }
-
-            if (glm::distance(this->_vertices.at(firstEdge.first), this->_vertices.at(secondEdge.second)) <=
-                    this->_epsilon &&
-                glm::distance(this->_vertices.at(firstEdge.second), this->_vertices.at(secondEdge.first)) <=
-                    this->_epsilon) {
-                // Fully overlapped edges (inverse edges)
-                // First edge is A -> B, second is B -> A
-
-                // Delete both edges
-                outline.edges.deleteAt(j);
-                outline.edges.deleteAt(i);
-
-                // Insert both vertices as intersections
-                this->_addIntersectionIfNeeded(intersections, firstEdge.first);
-                this->_addIntersectionIfNeeded(intersections, firstEdge.second);
-
-                // Make sure the next edge is the one after deleted edge
-                j--;
-                // Update first edge to make sure its the next edge after deleted edge
-                firstEdge = Edge{outline.edges.getAt(i)->value.first, outline.edges.getAt(i)->value.second};
-            } else if (this->_isEdgeOnEdge(secondEdge, firstEdge)) {
-                // Second edge fully lies on first edge
-
-                // Update edges so that overlapped part is deleted
-                outline.edges.insertAt(Edge{secondEdge.first, firstEdge.second}, i + 1);
-                outline.edges.getAt(i)->value.second = secondEdge.second;
-
-                // Because new edge was inserted, increment j
-                j++;
-                // Delete overlapping edge
-                outline.edges.deleteAt(j);
-
-                // Insert vertices of shorter edge as intersections
-                this->_addIntersectionIfNeeded(intersections, secondEdge.second);
-                this->_addIntersectionIfNeeded(intersections, secondEdge.first);
-
-                // Make sure the next edge is the one after deleted edge
-                j--;
-                // Update first edge, it should be the first segment of splitted edge
-                firstEdge = Edge{outline.edges.getAt(i)->value.first, outline.edges.getAt(i)->value.second};
-            } else if (this->_isEdgeOnEdge(firstEdge, secondEdge)) {
-                // First edge fully lies on second edge
-
-                // Update edges so that overlapped part is deleted
-                outline.edges.insertAt(Edge{firstEdge.first, secondEdge.second}, j + 1);
-                outline.edges.getAt(j)->value.second = firstEdge.second;
-
-                // Delete overlapping edge
-                outline.edges.deleteAt(i);
-
-                // Insert vertices of shorter edge as intersections
-                this->_addIntersectionIfNeeded(intersections, firstEdge.second);
-                this->_addIntersectionIfNeeded(intersections, firstEdge.first);
-
-                // First edge was deleted, start comparing edge after deleted edge
-                i--;
-                break;
-            }
-        }
+bool PolygonOperator::_hasOverlappingEdges(const std::vector<Outline> &polygon) {
+    std::vector<uint32_t> loops;
+    for (const Outline &outline : polygon) {
+        loops.push_back(this->_edges.addLoop(outline));
     }
 
-    // Handle normal intersections
-    for (unsigned int i = 0; i < outline.edges.size(); i++) {
-        Edge firstEdge{outline.edges.getAt(i)->value.first, outline.edges.getAt(i)->value.second};
-
-        for (unsigned int j = i + 2; j < outline.edges.size(); j++) {
-            Edge secondEdge{outline.edges.getAt(j)->value.first, outline.edges.getAt(j)->value.second};
-
-            // Skip edges that share at least one vertex
-            if (firstEdge.first == secondEdge.first || firstEdge.first == secondEdge.second ||
-                firstEdge.second == secondEdge.first || firstEdge.second == secondEdge.second) {
-                continue;
-            }
-
-            glm::vec2 intersection{0, 0};
-            if (this->_intersect(firstEdge, secondEdge, intersection)) {
-                if (glm::distance(intersection, this->_vertices.at(firstEdge.first)) <= this->_epsilon) {
-                    // Polygons have intersection at start vertex of first edge
-
-                    // Update second polygon if neccessary
-                    if (secondEdge.first != firstEdge.first && secondEdge.second != firstEdge.first) {
-                        outline.edges.getAt(j)->value.second = firstEdge.first;
-                        outline.edges.insertAt(Edge{firstEdge.first, secondEdge.second}, j + 1);
-                    }
-                } else if (glm::distance(intersection, this->_vertices.at(firstEdge.second)) <= this->_epsilon) {
-                    // Polygons have intersection at end vertex of first edge
-
-                    // Update second polygon if neccessary
-                    if (secondEdge.first != firstEdge.second && secondEdge.second != firstEdge.second) {
-                        outline.edges.getAt(j)->value.second = firstEdge.second;
-                        outline.edges.insertAt(Edge{firstEdge.second, secondEdge.second}, j + 1);
-                    }
-                } else if (glm::distance(intersection, this->_vertices.at(secondEdge.first)) <= this->_epsilon) {
-                    // Polygons have intersection at start vertex of second edge
-
-                    // Update first polygon if neccessary
-                    if (firstEdge.first != secondEdge.first && firstEdge.second != secondEdge.first) {
-                        outline.edges.getAt(i)->value.second = secondEdge.first;
-                        outline.edges.insertAt(Edge{secondEdge.first, firstEdge.second}, i + 1);
-
-                        firstEdge = Edge{outline.edges.getAt(i)->value.first, outline.edges.getAt(i)->value.second};
-                    }
-                } else if (glm::distance(intersection, this->_vertices.at(secondEdge.second)) <= this->_epsilon) {
-                    // Polygons have intersection at end vertex of second edge
-
-                    // Update first polygon if neccessary
-                    if (firstEdge.first != secondEdge.second && firstEdge.second != secondEdge.second) {
-                        outline.edges.getAt(i)->value.second = secondEdge.second;
-                        outline.edges.insertAt(Edge{secondEdge.second, firstEdge.second}, i + 1);
-
-                        firstEdge = Edge{outline.edges.getAt(i)->value.first, outline.edges.getAt(i)->value.second};
-                    }
-                } else {
-                    // Normal intersection
-
-                    // Add intersection to vertices
-                    uint32_t vertex = this->_vertices.size();
-                    this->_vertices.push_back(intersection);
-
-                    // Update first edge
-                    outline.edges.insertAt(Edge{vertex, firstEdge.second}, i + 1);
-                    outline.edges.getAt(i)->value.second = vertex;
-
-                    // Because new edge was inserted, increment j
-                    j++;
-
-                    // Update second edge
-                    outline.edges.insertAt(Edge{vertex, secondEdge.second}, j + 1);
-                    outline.edges.getAt(j)->value.second = vertex;
+    EdgeBroadPhase broadPhase{2 * this->_epsilon};
+    broadPhase.build(this->_vertices, this->_edges, loops);
 
-                    // Insert intersection
-                    this->_addIntersectionIfNeeded(intersections, vertex);
-
-                    firstEdge = Edge{outline.edges.getAt(i)->value.first, outline.edges.getAt(i)->value.second};
-                }
-            }
+    for (const auto &[first, second] : broadPhase.getOverlappingPairs()) {
+        if (this->_doEdgesOverlap(this->_edges[first.edge].value, this->_edges[second.edge].value)) {
+            return true;
         }
     }
 
-    this->_removeUnwantedIntersections(intersections, {Contour{false, outline}});
+    return false;
+}
 
-    if (intersections.size() == 0) {
-        return {outline};
+/**
+ * @brief Check whether two edges have any common point other than the vertex joining consecutive edges
+ *
+ * @param first First edge
+ * @param second Second edge
+ *
+ * @return True if edges intersect, touch or overlap
+ */
+bool PolygonOperator::_doEdgesOverlap(const Edge &first, const Edge &second) {
+    bool isFirstFollowed = first.second == second.first;
+    bool isSecondFollowed = second.second == first.first;
+    if (isFirstFollowed || isSecondFollowed) {
+        // Consecutive edges overlap only if they are collinear and one turns back along the other
+        const Edge &previous = isFirstFollowed ? first : second;
+        const Edge &next = isFirstFollowed ? second : first;
+        return (isFirstFollowed && isSecondFollowed) ||
+               this->_isPointOnEdge(this->_vertices.at(previous.first), next) ||
+               this->_isPointOnEdge(this->_vertices.at(next.second), previous);
     }
 
-    // Walk contours
-    uint32_t startVertex = 0;  // Starting vertex of current contour
-    uint32_t endVertex = 0;    // Last processed vertex of current contour
-    unsigned int contourIndex = 0;
-    std::vector<Outline> output;
-    unsigned int intersectionCount = intersections.size();
-    unsigned int processedIntersections = 0;
-
-    // Process all intersections
-    while (intersections.size() > 0) {
-        uint32_t intersectionVertex;  // Vertex from which to start traversing contour
+    // Contour passing through the same vertex twice touches itself
+    if (first.first == second.first || first.second == second.second) {
+        return true;
+    }
 
-        if (startVertex == endVertex) {
-            // Start processing new contour
-            intersectionVertex = intersections.front();
-            intersections.pop_front();
+    glm::vec2 intersection{0, 0};
+    return this->_intersect(first, second, intersection) ||
+           this->_isPointOnEdge(this->_vertices.at(first.first), second) ||
+           this->_isPointOnEdge(this->_vertices.at(first.second), second) ||
+           this->_isPointOnEdge(this->_vertices.at(second.first), first) ||
+           this->_isPointOnEdge(this->_vertices.at(second.second), first);
+}
 
-            startVertex = intersectionVertex;
+/**
+ * @brief Keep contours which do not overlap if they separate filled and empty area according to the nonzero fill
+ * rule. Winding numbers do not change along such contours, so one ray is cast for each contour
+ *
+ * @param polygon Contours of polygon, they do not overlap
+ */
+void PolygonOperator::_selectNonzeroContours(const std::vector<Outline> &polygon) {
+    std::vector<Segment> segments;
+    for (const Outline &outline : polygon) {
+        for (const Edge &edge : outline.edges) {
+            segments.push_back(Segment{edge.first, edge.second, 1});
+        }
+    }
 
-            output.push_back(Outline{});
-        } else {
-            // Contour is not yet fully processed (closed)
-            intersectionVertex = endVertex;
-            intersections.remove(intersectionVertex);
+    SegmentBands horizontalRays = this->_createSegmentBands(segments, 0);
+
+    uint32_t firstSegment = 0;
+    for (const Outline &outline : polygon) {
+        // Contour without any vertical extent has no area
+        auto edge = std::find_if(outline.edges.begin(), outline.edges.end(), [this](const Edge &edge) {
+            return this->_vertices.at(edge.first).y != this->_vertices.at(edge.second).y;
+        });
+        if (edge == outline.edges.end()) {
+            firstSegment += outline.edges.size();
+            continue;
         }
 
-        // Get all edges starting at selected intersection
-        std::vector<CircularDLL<Edge>::Node *> edges;
-        CircularDLL<Edge>::Node *edge = outline.edges.getFirst();
-        for (unsigned int i = 0; i < outline.edges.size(); i++) {
-            if (edge->value.first == intersectionVertex) {
-                edges.push_back(edge);
-            }
+        glm::dvec2 start{this->_vertices.at(edge->first)};
+        glm::dvec2 end{this->_vertices.at(edge->second)};
+        uint32_t segment = firstSegment + (edge - outline.edges.begin());
+        firstSegment += outline.edges.size();
 
-            edge = edge->next;
+        int rightWinding = this->_getWindingNumber(0.5 * (start + end), segments, horizontalRays, segment);
+        if (end.y < start.y) {
+            rightWinding--;
         }
+        int leftWinding = rightWinding + 1;
 
-        if (edges.size() == 0) {
-            throw std::runtime_error("PolygonOperator::_resolveSelfIntersections(): No edges starting at intersection");
+        if ((leftWinding != 0) == (rightWinding != 0)) {
+            continue;
         }
 
-        // Select the start edge
-        unsigned int selectedEdgeIndex = 0;
-        for (unsigned int i = 1; i < edges.size(); i++) {
-            bool isOnLeftSide = this->_isOnLeftSide(this->_vertices.at(edges[selectedEdgeIndex]->value.first),
-                                                    this->_vertices.at(edges[selectedEdgeIndex]->value.second),
-                                                    this->_vertices.at(edges[i]->value.second));
-
-            if (this->_getOrientationOfSubcontour(outline, edges[selectedEdgeIndex]) == Outline::Orientation::CW &&
-                this->_getOrientationOfSubcontour(outline, edges[i]) == Outline::Orientation::CW) {
-                // Both subcontours define a filled area
-                if (isOnLeftSide) {
-                    selectedEdgeIndex = i;
-                }
-            } else if (this->_getOrientationOfSubcontour(outline, edges[selectedEdgeIndex]) ==
-                           Outline::Orientation::CCW &&
-                       this->_getOrientationOfSubcontour(outline, edges[i]) == Outline::Orientation::CCW) {
-                // Both subcontours define a hole
-                if (!isOnLeftSide) {
-                    selectedEdgeIndex = i;
-                }
-            } else {
-                if (processedIntersections < intersectionCount) {
-                    // First select the right-most edge
-                    if (!isOnLeftSide) {
-                        selectedEdgeIndex = i;
-                    }
-
-                    // Later select the left-most edge
-                    intersections.push_back(intersectionVertex);
-                } else {
-                    // Now select the left-most edge
-                    if (isOnLeftSide) {
-                        selectedEdgeIndex = i;
-                    }
-                }
+        // Output contours have filled area on their right side
+        Outline kept{};
+        if (rightWinding != 0) {
+            kept.edges = outline.edges;
+        } else {
+            for (auto it = outline.edges.rbegin(); it != outline.edges.rend(); it++) {
+                kept.edges.push_back(Edge{it->second, it->first});
             }
         }
 
-        // Process edges starting from selected edge
-        CircularDLL<Edge>::Node *startEdge = edges[selectedEdgeIndex];
-
-        // Process edges until intersection or starting vertex
-        while (
-            std::find(intersections.begin(), intersections.end(), startEdge->value.second) ==
-                intersections.end()  // End of current edge is a intersection
-            &&
-            (output[contourIndex].edges.size() == 0 ||
-             startEdge->value.second !=
-                 output[contourIndex].edges.getFirst()->value.first)  // End of edge is contour start (closed contour)
-        ) {
-            // Move to next edge
-            output[contourIndex].edges.insertLast(startEdge->value);
-            startEdge = startEdge->next;
-        }
-        // Add edge ending at intersection or start to output
-        output[contourIndex].edges.insertLast(startEdge->value);
-
-        endVertex = startEdge->value.second;
-        processedIntersections++;
-        if (endVertex == startVertex) {
-            // Contour is closed, set orientation of contour
-            output[contourIndex].orientation =
-                this->_getOrientationOfSubcontour(output[contourIndex], output[contourIndex].edges.getFirst());
-            contourIndex++;
-        }
+        Contour contour{false, this->_edges.addLoop(kept), Outline::Orientation::CW};
+        contour.orientation =
+            this->_signedAreaOfContour(contour) >= 0 ? Outline::Orientation::CCW : Outline::Orientation::CW;
+        this->_output.push_back(contour);
     }
-
-    return output;
 }
 
 /**
- * @brief Resolve overlapping edges between the first and second polygon
+ * @brief Find vertices closer to each other than epsilon, so they can be replaced by one vertex
+ *
+ * @return Index of vertex replacing each vertex, it is the vertex itself if it is not replaced
  */
-void PolygonOperator::_resolveOverlappingEdges() {
-    for (Contour &firstPolygonContour : this->_first) {
-        for (unsigned int i = 0; i < firstPolygonContour.outline.edges.size(); i++) {
-            Edge firstPolygonEdge{firstPolygonContour.outline.edges.getAt(i)->value.first,
-                                  firstPolygonContour.outline.edges.getAt(i)->value.second};
-            bool wasFirstPolygonEdgeChanged = false;
-
-            for (Contour &secondPolygonContour : this->_second) {
-                for (unsigned int j = 0; j < secondPolygonContour.outline.edges.size(); j++) {
-                    Edge secondPolygonEdge{secondPolygonContour.outline.edges.getAt(j)->value.first,
-                                           secondPolygonContour.outline.edges.getAt(j)->value.second};
-
-                    if (glm::distance(this->_vertices.at(firstPolygonEdge.first),
-                                      this->_vertices.at(secondPolygonEdge.second)) <= this->_epsilon &&
-                        glm::distance(this->_vertices.at(firstPolygonEdge.second),
-                                      this->_vertices.at(secondPolygonEdge.first)) <= this->_epsilon) {
-                        // Fully overlapped edges (inverse edges)
-                        // First edge is A -> B, second is B -> A
-
-                        // Delete both edges
-                        firstPolygonContour.outline.edges.deleteAt(i);
-                        secondPolygonContour.outline.edges.deleteAt(j);
-
-                        // Insert vertices of overlapped edges as intersections
-                        this->_addIntersectionIfNeeded(this->_intersections, firstPolygonEdge.first);
-                        this->_addIntersectionIfNeeded(this->_intersections, firstPolygonEdge.second);
-
-                        i--;  // Decrement because edge from first polygon was deleted
-                        wasFirstPolygonEdgeChanged = true;
-                        break;
-                    } else if (this->_isEdgeOnEdge(secondPolygonEdge, firstPolygonEdge)) {
-                        // Second edge fully lies on first edge
-
-                        // Update edges in first polygon so that overlapped part is deleted
-                        firstPolygonContour.outline.edges.insertAt(
-                            Edge{secondPolygonEdge.first, firstPolygonEdge.second}, i + 1);
-                        firstPolygonContour.outline.edges.getAt(i)->value.second = secondPolygonEdge.second;
-
-                        // Delete overlapping edge in second polygon
-                        secondPolygonContour.outline.edges.deleteAt(j);
+std::vector<uint32_t> PolygonOperator::_weldVertices() {
+    std::vector<uint32_t> order(this->_vertices.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [this](uint32_t first, uint32_t second) {
+        return std::tie(this->_vertices[first].x, this->_vertices[first].y) <
+               std::tie(this->_vertices[second].x, this->_vertices[second].y);
+    });
 
-                        // Insert vertices of shorter edge as intersections
-                        this->_addIntersectionIfNeeded(this->_intersections, secondPolygonEdge.second);
-                        this->_addIntersectionIfNeeded(this->_intersections, secondPolygonEdge.first);
+    // Vertices are swept along x axis, only vertices which are not replaced themselves can replace other vertices
+    std::vector<uint32_t> replacement(this->_vertices.size());
+    for (unsigned int i = 0; i < order.size(); i++) {
+        const glm::vec2 &vertex = this->_vertices[order[i]];
+        replacement[order[i]] = order[i];
+
+        for (unsigned int j = i; j > 0 && vertex.x - this->_vertices[order[j - 1]].x <= this->_epsilon; j--) {
+            uint32_t candidate = order[j - 1];
+            if (replacement[candidate] == candidate &&
+                glm::distance(vertex, this->_vertices[candidate]) <= this->_epsilon) {
+                replacement[order[i]] = candidate;
+                break;
+            }
+        }
+    }
 
-                        wasFirstPolygonEdgeChanged = true;
-                        break;
-                    } else if (this->_isEdgeOnEdge(firstPolygonEdge, secondPolygonEdge)) {
-                        // First edge fully lies on second edge
+    return replacement;
+}
 
-                        // Update edges in second polygon so that overlapped part is deleted
-                        secondPolygonContour.outline.edges.insertAt(
-                            Edge{firstPolygonEdge.first, secondPolygonEdge.second}, j + 1);
-                        secondPolygonContour.outline.edges.getAt(j)->value.second = firstPolygonEdge.second;
+/**
+ * @brief Split edges of all contours at points where they intersect or touch other edges
+ *
+ * @param polygon Contours of polygon
+ *
+ * @return Split edges, they only meet at their vertices
+ */
+std::vector<Edge> PolygonOperator::_splitAtIntersections(const std::vector<Outline> &polygon) {
+    std::vector<uint32_t> loops;
+    std::vector<unsigned int> offsets;  // Index of the first edge of each loop in the list of all edges
+    unsigned int edgeCount = 0;
+    for (const Outline &outline : polygon) {
+        loops.push_back(this->_edges.addLoop(outline));
+        offsets.push_back(edgeCount);
+        edgeCount += outline.edges.size();
+    }
 
-                        // Delete overlapping edge in second polygon
-                        firstPolygonContour.outline.edges.deleteAt(i);
+    // Only edges with overlapping bounding boxes are tested
+    EdgeBroadPhase broadPhase{2 * this->_epsilon};
+    broadPhase.build(this->_vertices, this->_edges, loops);
 
-                        // Insert vertices of shorter edge as intersections
-                        this->_addIntersectionIfNeeded(this->_intersections, firstPolygonEdge.second);
-                        this->_addIntersectionIfNeeded(this->_intersections, firstPolygonEdge.first);
+    // Parameter along edge and vertex of every point where edge is split
+    std::vector<std::vector<std::pair<double, uint32_t>>> splits(edgeCount);
+    for (const auto &[first, second] : broadPhase.getOverlappingPairs()) {
+        this->_splitEdges(first.edge, second.edge, splits[offsets[first.loopIndex] + first.edgeIndex],
+                          splits[offsets[second.loopIndex] + second.edgeIndex]);
+    }
 
-                        i--;  // Decrement because edge from first polygon was deleted
-                        wasFirstPolygonEdgeChanged = true;
-                        break;
-                    }
+    // Replace edges by parts between split points
+    std::vector<Edge> edges;
+    for (unsigned int i = 0; i < loops.size(); i++) {
+        uint32_t edge = this->_edges.getFirst(loops[i]);
+        for (unsigned int j = 0; j < this->_edges.getSize(loops[i]); j++) {
+            std::vector<std::pair<double, uint32_t>> &edgeSplits = splits[offsets[i] + j];
+            std::sort(edgeSplits.begin(), edgeSplits.end());
+
+            uint32_t start = this->_edges[edge].value.first;
+            for (const std::pair<double, uint32_t> &split : edgeSplits) {
+                if (split.second != start) {
+                    edges.push_back(Edge{start, split.second});
+                    start = split.second;
                 }
+            }
 
-                if (wasFirstPolygonEdgeChanged) {
-                    break;
-                }
+            if (this->_edges[edge].value.second != start) {
+                edges.push_back(Edge{start, this->_edges[edge].value.second});
             }
+
+            edge = this->_edges[edge].next;
         }
     }
+
+    return edges;
 }
 
 /**
- * @brief Resolve normal intersections and intersections at shared vertex between the first and second polygon
+ * @brief Find points where two edges intersect or where vertex of one edge lies on the other edge
+ *
+ * @param first Index of first edge in edge pool
+ * @param second Index of second edge in edge pool
+ * @param firstSplits Split points of first edge
+ * @param secondSplits Split points of second edge
  */
-void PolygonOperator::_resolveIntersectingEdges() {
-    for (Contour &firstPolygonContour : this->_first) {
-        for (unsigned int i = 0; i < firstPolygonContour.outline.edges.size(); i++) {
-            Edge firstPolygonEdge{firstPolygonContour.outline.edges.getAt(i)->value.first,
-                                  firstPolygonContour.outline.edges.getAt(i)->value.second};
-            bool wasFirstPolygonEdgeChanged = false;
-
-            for (Contour &secondPolygonContour : this->_second) {
-                for (unsigned int j = 0; j < secondPolygonContour.outline.edges.size(); j++) {
-                    Edge secondPolygonEdge{secondPolygonContour.outline.edges.getAt(j)->value.first,
-                                           secondPolygonContour.outline.edges.getAt(j)->value.second};
-
-                    // Skip edges that share at least one vertex
-                    if (firstPolygonEdge.first == secondPolygonEdge.first ||
-                        firstPolygonEdge.first == secondPolygonEdge.second ||
-                        firstPolygonEdge.second == secondPolygonEdge.first ||
-                        firstPolygonEdge.second == secondPolygonEdge.second) {
-                        continue;
-                    }
+void PolygonOperator::_splitEdges(uint32_t first,
+                                  uint32_t second,
+                                  std::vector<std::pair<double, uint32_t>> &firstSplits,
+                                  std::vector<std::pair<double, uint32_t>> &secondSplits) {
+    Edge firstEdge = this->_edges[first].value;
+    Edge secondEdge = this->_edges[second].value;
+
+    // Vertex of one edge lying on the other edge, this also splits overlapping edges
+    bool wasSplit = this->_splitEdgeAtVertex(firstEdge, secondEdge.first, firstSplits);
+    wasSplit = this->_splitEdgeAtVertex(firstEdge, secondEdge.second, firstSplits) || wasSplit;
+    wasSplit = this->_splitEdgeAtVertex(secondEdge, firstEdge.first, secondSplits) || wasSplit;
+    wasSplit = this->_splitEdgeAtVertex(secondEdge, firstEdge.second, secondSplits) || wasSplit;
+
+    // Edges that touch or share a vertex can not intersect anywhere else
+    if (wasSplit || firstEdge.first == secondEdge.first || firstEdge.first == secondEdge.second ||
+        firstEdge.second == secondEdge.first || firstEdge.second == secondEdge.second) {
+        return;
+    }
 
-                    // Check if edges intersect
-                    glm::vec2 intersection{0, 0};
-                    if (this->_intersect(firstPolygonEdge, secondPolygonEdge, intersection)) {
-                        if (glm::distance(intersection, this->_vertices.at(firstPolygonEdge.first)) <= this->_epsilon) {
-                            // Polygons have intersection at start vertex of first edge
-
-                            // Insert shared vertex as intersection
-                            this->_addIntersectionIfNeeded(this->_intersections, firstPolygonEdge.first);
-
-                            // Update second polygon if neccessary
-                            if (secondPolygonEdge.first != firstPolygonEdge.first &&
-                                secondPolygonEdge.second != firstPolygonEdge.first) {
-                                secondPolygonContour.outline.edges.getAt(j)->value.second = firstPolygonEdge.first;
-                                secondPolygonContour.outline.edges.insertAt(
-                                    Edge{firstPolygonEdge.first, secondPolygonEdge.second}, j + 1);
-                            }
-                        } else if (glm::distance(intersection, this->_vertices.at(firstPolygonEdge.second)) <=
-                                   this->_epsilon) {
-                            // Polygons have intersection at end vertex of first edge
-
-                            // Insert shared vertex as intersection
-                            this->_addIntersectionIfNeeded(this->_intersections, firstPolygonEdge.second);
-
-                            // Update second polygon if neccessary
-                            if (secondPolygonEdge.first != firstPolygonEdge.second &&
-                                secondPolygonEdge.second != firstPolygonEdge.second) {
-                                secondPolygonContour.outline.edges.getAt(j)->value.second = firstPolygonEdge.second;
-                                secondPolygonContour.outline.edges.insertAt(
-                                    Edge{firstPolygonEdge.second, secondPolygonEdge.second}, j + 1);
-                            }
-                        } else if (glm::distance(intersection, this->_vertices.at(secondPolygonEdge.first)) <=
-                                   this->_epsilon) {
-                            // Polygons have intersection at start vertex of second edge
-
-                            // Insert shared vertex as intersection
-                            this->_addIntersectionIfNeeded(this->_intersections, secondPolygonEdge.first);
-
-                            // Update first polygon if neccessary
-                            if (firstPolygonEdge.first != secondPolygonEdge.first &&
-                                firstPolygonEdge.second != secondPolygonEdge.first) {
-                                firstPolygonContour.outline.edges.getAt(i)->value.second = secondPolygonEdge.first;
-                                firstPolygonContour.outline.edges.insertAt(
-                                    Edge{secondPolygonEdge.first, firstPolygonEdge.second}, i + 1);
-
-                                wasFirstPolygonEdgeChanged = true;
-                                break;
-                            }
-                        } else if (glm::distance(intersection, this->_vertices.at(secondPolygonEdge.second)) <=
-                                   this->_epsilon) {
-                            // Polygons have intersection at end vertex of second edge
-
-                            // Insert shared vertex as intersection
-                            this->_addIntersectionIfNeeded(this->_intersections, secondPolygonEdge.second);
-
-                            // Update first polygon if neccessary
-                            if (firstPolygonEdge.first != secondPolygonEdge.second &&
-                                firstPolygonEdge.second != secondPolygonEdge.second) {
-                                firstPolygonContour.outline.edges.getAt(i)->value.second = secondPolygonEdge.second;
-                                firstPolygonContour.outline.edges.insertAt(
-                                    Edge{secondPolygonEdge.second, firstPolygonEdge.second}, i + 1);
-
-                                wasFirstPolygonEdgeChanged = true;
-                                break;
-                            }
-                        } else {
-                            // Normal intersection
-
-                            // Add intersection to vertices
-                            uint32_t vertex = this->_vertices.size();
-                            this->_vertices.push_back(intersection);
-
-                            // Update first polygon
-                            firstPolygonContour.outline.edges.getAt(i)->value.second = vertex;
-                            firstPolygonContour.outline.edges.insertAt(Edge{vertex, firstPolygonEdge.second}, i + 1);
-
-                            // Update second polygon
-                            secondPolygonContour.outline.edges.getAt(j)->value.second = vertex;
-                            secondPolygonContour.outline.edges.insertAt(Edge{vertex, secondPolygonEdge.second}, j + 1);
-
-                            // Insert intersection
-                            this->_addIntersectionIfNeeded(this->_intersections, vertex);
-
-                            wasFirstPolygonEdgeChanged = true;
-                            break;
-                        }
-                    }
-                }
+    glm::vec2 intersection{0, 0};
+    if (!this->_intersect(firstEdge, secondEdge, intersection)) {
+        return;
+    }
 
-                if (wasFirstPolygonEdgeChanged) {
-                    // Make sure that the next selected edge is the first one of changed edges
-                    // In some cases there may be another intersection
-                    i--;
-                    break;
-                }
+    // Intersections at vertices are found above
+    for (uint32_t vertex : {firstEdge.first, firstEdge.second, secondEdge.first, secondEdge.second}) {
+        if (glm::distance(intersection, this->_vertices.at(vertex)) <= this->_epsilon) {
+            return;
+        }
+    }
+
+    // Reuse intersection found with another edge if more edges intersect at the same point
+    uint32_t intersectionVertex = this->_vertices.size();
+    for (const std::vector<std::pair<double, uint32_t>> *splits : {&firstSplits, &secondSplits}) {
+        for (const std::pair<double, uint32_t> &split : *splits) {
+            if (glm::distance(intersection, this->_vertices.at(split.second)) <= this->_epsilon) {
+                intersectionVertex = split.second;
             }
         }
     }
+
+    if (intersectionVertex == this->_vertices.size()) {
+        this->_vertices.push_back(intersection);
+    }
+
+    this->_addSplit(firstEdge, intersectionVertex, firstSplits);
+    this->_addSplit(secondEdge, intersectionVertex, secondSplits);
 }
 
 /**
- * @brief Check if edges intersect
+ * @brief Split edge at given vertex if vertex lies on edge between its end points
  *
- * @param first First edge
- * @param second Second edge
- * @param intersection Sets the point of intesection if exists
+ * @param edge Edge
+ * @param vertex Index of vertex
+ * @param splits Split points of edge, the vertex is added to them
  *
- * @return True if edges intersect
+ * @return True if vertex lies on edge
  */
-bool PolygonOperator::_intersect(Edge first, Edge second, glm::vec2 &intersection) {
-    double x1 = this->_vertices.at(first.first).x;
-    double y1 = this->_vertices.at(first.first).y;
-    double x2 = this->_vertices.at(first.second).x;
-    double y2 = this->_vertices.at(first.second).y;
-    double x3 = this->_vertices.at(second.first).x;
-    double y3 = this->_vertices.at(second.first).y;
-    double x4 = this->_vertices.at(second.second).x;
-    double y4 = this->_vertices.at(second.second).y;
-
-    double det1 = this->_determinant(x1 - x2, y1 - y2, x3 - x4, y3 - y4);
-    double det2 = this->_determinant(x1 - x3, y1 - y3, x3 - x4, y3 - y4);
-
-    // Check if edges are parallel
-    if (std::fabs(det1) < this->_epsilon || std::fabs(det2) < this->_epsilon) {
+bool PolygonOperator::_splitEdgeAtVertex(const Edge &edge,
+                                         uint32_t vertex,
+                                         std::vector<std::pair<double, uint32_t>> &splits) {
+    const glm::vec2 &point = this->_vertices.at(vertex);
+    const glm::vec2 &start = this->_vertices.at(edge.first);
+    const glm::vec2 &end = this->_vertices.at(edge.second);
+
+    if (vertex == edge.first || vertex == edge.second || glm::distance(point, start) <= this->_epsilon ||
+        glm::distance(point, end) <= this->_epsilon || !this->_isPointOnEdge(point, edge)) {
         return false;
     }
 
-    intersection.x =
-        this->_determinant(this->_determinant(x1, y1, x2, y2), x1 - x2, this->_determinant(x3, y3, x4, y4), x3 - x4) /
-        det1;
-    intersection.y =
-        this->_determinant(this->_determinant(x1, y1, x2, y2), y1 - y2, this->_determinant(x3, y3, x4, y4), y3 - y4) /
-        det1;
+    this->_addSplit(edge, vertex, splits);
 
-    // Check if intersection is in the boundaries of both edges
-    if (((intersection.x >= std::min(x1, x2) && intersection.x <= std::max(x1, x2)) &&
-         (intersection.y >= std::min(y1, y2) && intersection.y <= std::max(y1, y2))) &&
-        ((intersection.x >= std::min(x3, x4) && intersection.x <= std::max(x3, x4)) &&
-         (intersection.y >= std::min(y3, y4) && intersection.y <= std::max(y3, y4)))) {
-        return true;
-    }
-
-    return false;
+    return true;
 }
 
 /**
- * @brief Traverse both polygons to construct the output polygon
+ * @brief Add split point to edge if the vertex is not already one of its split points
+ *
+ * @param edge Edge
+ * @param vertex Index of vertex lying on edge
+ * @param splits Split points of edge
  */
-void PolygonOperator::_walkContours() {
-    uint32_t startVertex = 0;  // Starting vertex of current contour
-    uint32_t endVertex = 0;    // Last processed vertex of current contour
-    unsigned int contourIndex = 0;
-    unsigned int intersectionCount = this->_intersections.size();
-    unsigned int processedIntersections = 0;
+void PolygonOperator::_addSplit(const Edge &edge, uint32_t vertex, std::vector<std::pair<double, uint32_t>> &splits) {
+    if (std::find_if(splits.begin(), splits.end(), [vertex](const std::pair<double, uint32_t> &split) {
+            return split.second == vertex;
+        }) != splits.end()) {
+        return;
+    }
+
+    // Split points are ordered by their parameter along edge
+    glm::dvec2 start{this->_vertices.at(edge.first)};
+    glm::dvec2 direction = glm::dvec2{this->_vertices.at(edge.second)} - start;
+    double t = glm::dot(glm::dvec2{this->_vertices.at(vertex)} - start, direction) / glm::dot(direction, direction);
 
-    // Process intersections
-    while (this->_intersections.size() > 0) {
-        uint32_t intersectionVertex;  // Vertex from which to start traversing contour
+    splits.push_back({t, vertex});
+}
 
-        if (startVertex == endVertex) {
-            // Start processing new contour
-            intersectionVertex = this->_intersections.front();
-            this->_intersections.pop_front();
+/**
+ * @brief Select edges lying on the boundary of area filled according to the nonzero fill rule
+ *
+ * @param edges Edges of polygon that only meet at their vertices
+ *
+ * @return Boundary edges oriented so that filled area lies on their right side
+ */
+std::vector<Edge> PolygonOperator::_selectNonzeroBoundary(const std::vector<Edge> &edges) {
+    // Merge overlapping edges, edges going in opposite directions cancel out
+    std::vector<Segment> merged;
+    for (const Edge &edge : edges) {
+        merged.push_back(edge.first < edge.second ? Segment{edge.first, edge.second, 1}
+                                                  : Segment{edge.second, edge.first, -1});
+    }
 
-            startVertex = intersectionVertex;
+    std::sort(merged.begin(), merged.end(), [](const Segment &first, const Segment &second) {
+        return std::tie(first.start, first.end) < std::tie(second.start, second.end);
+    });
 
-            this->_output.push_back(Outline{});
+    std::vector<Segment> segments;
+    for (const Segment &segment : merged) {
+        if (!segments.empty() && segments.back().start == segment.start && segments.back().end == segment.end) {
+            segments.back().multiplicity += segment.multiplicity;
         } else {
-            // Contour is not yet fully processed (closed)
-            intersectionVertex = endVertex;
-            this->_intersections.remove(intersectionVertex);
+            segments.push_back(segment);
         }
+    }
+
+    std::erase_if(segments, [this](const Segment &segment) {
+        return segment.multiplicity == 0 || this->_vertices.at(segment.start) == this->_vertices.at(segment.end);
+    });
 
-        // Get all edges starting at selected intersection
-        std::vector<CircularDLL<Edge>::Node *> edges = this->_getEdgesStartingAt(intersectionVertex);
-        if (edges.size() == 0) {
-            throw std::runtime_error("PolygonOperator::_walkContours(): No edges starting at intersection");
+    // Vertices shared by exactly two segments, winding numbers do not change when passing through them
+    std::vector<unsigned int> degrees(this->_vertices.size(), 0);
+    std::vector<std::pair<uint32_t, uint32_t>> neighbours(this->_vertices.size(), {EdgePool::NONE, EdgePool::NONE});
+    for (uint32_t i = 0; i < segments.size(); i++) {
+        for (uint32_t vertex : {segments[i].start, segments[i].end}) {
+            (degrees[vertex]++ == 0 ? neighbours[vertex].first : neighbours[vertex].second) = i;
         }
+    }
 
-        // Select the next edge
-        unsigned int selectedEdgeIndex = 0;
-        for (unsigned int i = 1; i < edges.size(); i++) {
-            bool isOnLeftSide = this->_isOnLeftSide(this->_vertices.at(edges[selectedEdgeIndex]->value.first),
-                                                    this->_vertices.at(edges[selectedEdgeIndex]->value.second),
-                                                    this->_vertices.at(edges[i]->value.second));
-            if (this->_getContourOfEdge(edges[selectedEdgeIndex]).outline.orientation == Outline::Orientation::CW &&
-                this->_getContourOfEdge(edges[i]).outline.orientation == Outline::Orientation::CW) {
-                // Both contours define a filled area
-                if (isOnLeftSide) {
-                    selectedEdgeIndex = i;
-                }
-            } else if (this->_getContourOfEdge(edges[selectedEdgeIndex]).outline.orientation ==
-                           Outline::Orientation::CCW &&
-                       this->_getContourOfEdge(edges[i]).outline.orientation == Outline::Orientation::CCW) {
-                // Both contours define a hole
-                if (!isOnLeftSide) {
-                    selectedEdgeIndex = i;
-                }
-            } else {
-                // Check if area of filled area is bigger than hole
-                if (this->_getContourOfEdge(edges[selectedEdgeIndex]).outline.orientation == Outline::Orientation::CW &&
-                        std::abs(
-                            this->_signedAreaOfContour(this->_getContourOfEdge(edges[selectedEdgeIndex]).outline)) >
-                            std::abs(this->_signedAreaOfContour(this->_getContourOfEdge(edges[i]).outline)) ||
-                    this->_getContourOfEdge(edges[i]).outline.orientation == Outline::Orientation::CW &&
-                        std::abs(this->_signedAreaOfContour(this->_getContourOfEdge(edges[i]).outline)) >
-                            std::abs(this->_signedAreaOfContour(
-                                this->_getContourOfEdge(edges[selectedEdgeIndex]).outline))) {
-                    // First select the right-most edge
-                    if (!isOnLeftSide) {
-                        selectedEdgeIndex = i;
-                    }
-                } else {
-                    // Select the left-most edge
-                    if (isOnLeftSide) {
-                        selectedEdgeIndex = i;
+    // Rays are cast along x axis, segments of horizontal chains cast rays along y axis
+    SegmentBands horizontalRays = this->_createSegmentBands(segments, 0);
+    SegmentBands verticalRays{};
+
+    std::vector<int> rightWindings(segments.size(), 0);
+    std::vector<bool> isResolved(segments.size(), false);
+    for (bool castsHorizontalRays : {true, false}) {
+        for (uint32_t i = 0; i < segments.size(); i++) {
+            const Segment &segment = segments[i];
+            glm::dvec2 start{this->_vertices.at(segment.start)};
+            glm::dvec2 end{this->_vertices.at(segment.end)};
+            bool isHorizontal = start.y == end.y;
+            if (isResolved[i] || isHorizontal == castsHorizontalRays) {
+                continue;
+            }
+
+            if (isHorizontal && verticalRays.bands.empty()) {
+                verticalRays = this->_createSegmentBands(segments, 1);
+            }
+
+            // Winding number on the side of segment where the cast ray starts, the other side also includes the segment
+            int winding = this->_getWindingNumber(0.5 * (start + end), segments,
+                                                  isHorizontal ? verticalRays : horizontalRays, i);
+            if ((isHorizontal && end.x > start.x) || (!isHorizontal && end.y < start.y)) {
+                winding -= segment.multiplicity;
+            }
+
+            rightWindings[i] = winding;
+            isResolved[i] = true;
+
+            // Propagate winding number along the chain of segments in both directions from the segment
+            for (uint32_t vertex : {segment.start, segment.end}) {
+                uint32_t current = i;
+                while (degrees[vertex] == 2) {
+                    uint32_t next = neighbours[vertex].first == current ? neighbours[vertex].second
+                                                                        : neighbours[vertex].first;
+                    // Filled side is kept if one segment ends where the other starts, otherwise sides are swapped
+                    bool isReversed = (segments[current].end == vertex) != (segments[next].start == vertex);
+                    int multiplicity = isReversed ? -segments[next].multiplicity : segments[next].multiplicity;
+                    if (isResolved[next] || multiplicity != segments[current].multiplicity) {
+                        break;
                     }
+
+                    rightWindings[next] =
+                        isReversed ? rightWindings[current] + segments[current].multiplicity : rightWindings[current];
+                    isResolved[next] = true;
+
+                    current = next;
+                    vertex = segments[next].start == vertex ? segments[next].end : segments[next].start;
                 }
             }
         }
-
-        // Mark selected contour as visited
-        this->_markContourAsVisited(edges[selectedEdgeIndex]);
-
-        // Process edges starting from selected left-most edge
-        endVertex = this->_walkUntilIntersectionOrStart(edges[selectedEdgeIndex], contourIndex);
-        processedIntersections++;
-        if (endVertex == startVertex) {
-            // Contour is closed, set orientation of contour
-            this->_output[contourIndex].orientation = this->_getOrientationOfSubcontour(
-                this->_output[contourIndex], this->_output[contourIndex].edges.getFirst());
-            contourIndex++;
-        }
     }
 
-    // Add unvisited contours from first polygon to ouput
-    for (const Contour &contour : this->_first) {
-        if (!contour.visited && contour.outline.edges.size() > 0) {
-            this->_output.push_back(contour.outline);
+    std::vector<Edge> boundary;
+    for (uint32_t i = 0; i < segments.size(); i++) {
+        int rightWinding = rightWindings[i];
+        int leftWinding = rightWinding + segments[i].multiplicity;
+        if ((leftWinding != 0) != (rightWinding != 0)) {
+            boundary.push_back(rightWinding != 0 ? Edge{segments[i].start, segments[i].end}
+                                                 : Edge{segments[i].end, segments[i].start});
         }
     }
 
-    // Add unvisited contours from second polygon to ouput
-    for (const Contour &contour : this->_second) {
-        if (!contour.visited && contour.outline.edges.size() > 0) {
-            this->_output.push_back(contour.outline);
-        }
-    }
+    return boundary;
 }
 
 /**
- * @brief Traverse given contour until start of currently processed contour or until intersection
+ * @brief Group segments into bands, so rays cast from a point only test segments in the band of the point
  *
- * @param start Starting edge
- * @param contourIndex Index of currently processed contour
+ * @param segments Segments of polygon
+ * @param axis Axis along which rays are cast, 0 for x and 1 for y
  *
- * @return Index of vertex where traversal ended
+ * @return Bands perpendicular to rays
  */
-uint32_t PolygonOperator::_walkUntilIntersectionOrStart(CircularDLL<Edge>::Node *start, unsigned int contourIndex) {
-    while (std::find(this->_intersections.begin(), this->_intersections.end(), start->value.second) ==
-               this->_intersections.end()  // End of current edge is a intersection
-           &&
-           (this->_output[contourIndex].edges.size() == 0 ||
-            start->value.second != this->_output[contourIndex].edges.getFirst()->value.first)  // End of edge is contour
-                                                                                               // start (closed contour)
-    ) {
-        // Move to next edge
-        this->_output[contourIndex].edges.insertLast(start->value);
-        start = start->next;
-    }
-
-    // Add edge ending at intersection or start to output
-    this->_output[contourIndex].edges.insertLast(start->value);
-
-    return start->value.second;
-}
+PolygonOperator::SegmentBands PolygonOperator::_createSegmentBands(const std::vector<Segment> &segments,
+                                                                   unsigned int axis) {
+    SegmentBands bands{};
+    bands.axis = axis;
+    if (segments.empty()) {
+        return bands;
+    }
 
-/**
- * @brief Mark contour with given edge as visited
- *
- * @param edge Edge of polygon
- */
-void PolygonOperator::_markContourAsVisited(CircularDLL<Edge>::Node *edge) {
-    // Search in first polygon
-    for (Contour &contour : this->_first) {
-        for (unsigned int i = 0; i < contour.outline.edges.size(); i++) {
-            if (edge == contour.outline.edges.getAt(i)) {
-                // Found contour including vertex
-                contour.visited = true;
-                return;
-            }
-        }
+    // Bands split the axis perpendicular to rays
+    unsigned int other = 1 - axis;
+    double min = std::numeric_limits<double>::max();
+    double max = std::numeric_limits<double>::lowest();
+    for (const Segment &segment : segments) {
+        min = std::min({min, static_cast<double>(this->_vertices.at(segment.start)[other]),
+                        static_cast<double>(this->_vertices.at(segment.end)[other])});
+        max = std::max({max, static_cast<double>(this->_vertices.at(segment.start)[other]),
+                        static_cast<double>(this->_vertices.at(segment.end)[other])});
     }
 
-    // Search in second polygon
-    for (Contour &contour : this->_second) {
-        for (unsigned int i = 0; i < contour.outline.edges.size(); i++) {
-            if (edge == contour.outline.edges.getAt(i)) {
-                // Found contour including vertex
-                contour.visited = true;
-                return;
-            }
+    unsigned int bandCount = std::max(1u, static_cast<unsigned int>(std::sqrt(segments.size())));
+    bands.start = min;
+    bands.size = max > min ? (max - min) / bandCount : 1;
+    bands.bands.resize(bandCount);
+
+    auto getBand = [&](double coordinate) {
+        return std::clamp(static_cast<int>(std::floor((coordinate - bands.start) / bands.size)), 0,
+                          static_cast<int>(bandCount) - 1);
+    };
+
+    for (uint32_t i = 0; i < segments.size(); i++) {
+        double start = this->_vertices.at(segments[i].start)[other];
+        double end = this->_vertices.at(segments[i].end)[other];
+        for (int band = getBand(std::min(start, end)); band <= getBand(std::max(start, end)); band++) {
+            bands.bands[band].push_back(i);
         }
     }
+
+    return bands;
 }
 
 /**
- * @brief Add point of intersection to list if not already in list
+ * @brief Compute nonzero winding number of point by casting a ray from point in the positive direction of axis
  *
- * @param intersections List of intersections
- * @param intersection Index of vertex at intersection
+ * @param point Point
+ * @param segments Segments of polygon
+ * @param bands Segments grouped into bands perpendicular to ray
+ * @param skippedSegment Index of segment which is not counted, the point lies on it
+ *
+ * @return Winding number, positive for points inside counter clockwise contours
  */
-void PolygonOperator::_addIntersectionIfNeeded(std::list<uint32_t> &intersections, uint32_t intersection) {
-    if (std::find(intersections.begin(), intersections.end(), intersection) == intersections.end()) {
-        intersections.push_back(intersection);
+int PolygonOperator::_getWindingNumber(const glm::dvec2 &point,
+                                       const std::vector<Segment> &segments,
+                                       const SegmentBands &bands,
+                                       uint32_t skippedSegment) {
+    if (bands.bands.empty()) {
+        return 0;
     }
-}
 
-/**
- * @brief Remove vertices from list of intersections if no edges start at intersection
- *
- * @param intersections List of intersections
- * @param contours List of contours containing edges to search
- */
-void PolygonOperator::_removeUnwantedIntersections(std::list<uint32_t> &intersections,
-                                                   const std::vector<Contour> &contours) {
-    std::erase_if(intersections, [&](uint32_t intersection) {
-        for (const Contour &contour : contours) {
-            for (unsigned int i = 0; i < contour.outline.edges.size(); i++) {
-                if (contour.outline.edges.getAt(i)->value.first == intersection ||
-                    contour.outline.edges.getAt(i)->value.second == intersection) {
-                    return false;  // Valid intersection
-                }
-            }
-        }
+    unsigned int axis = bands.axis;
+    unsigned int other = 1 - axis;
+    int band = std::clamp(static_cast<int>(std::floor((point[other] - bands.start) / bands.size)), 0,
+                          static_cast<int>(bands.bands.size()) - 1);
 
-        return true;  // No edges starting or ending at intersection
-    });
-}
+    int winding = 0;
+    for (uint32_t i : bands.bands[band]) {
+        if (i == skippedSegment) {
+            continue;
+        }
 
-/**
- * @brief Get edges from first and second polygon that start at given vertex
- *
- * @param vertex Vertex
- *
- * @return Edges starting at vertex
- */
-std::vector<CircularDLL<Edge>::Node *> PolygonOperator::_getEdgesStartingAt(uint32_t vertex) {
-    std::vector<CircularDLL<Edge>::Node *> edges;
-
-    // Search in first polygon
-    for (Contour &contour : this->_first) {
-        CircularDLL<Edge>::Node *edge = contour.outline.edges.getFirst();
-        for (unsigned int i = 0; i < contour.outline.edges.size(); i++) {
-            if (edge->value.first == vertex) {
-                edges.push_back(edge);
-            }
+        glm::dvec2 start{this->_vertices.at(segments[i].start)};
+        glm::dvec2 end{this->_vertices.at(segments[i].end)};
 
-            edge = edge->next;
+        // Half open test, so rays passing through a vertex count only one of its segments
+        if ((start[other] <= point[other]) == (end[other] <= point[other])) {
+            continue;
         }
-    }
 
-    // Search in second polygon
-    for (Contour &contour : this->_second) {
-        CircularDLL<Edge>::Node *edge = contour.outline.edges.getFirst();
-        for (unsigned int i = 0; i < contour.outline.edges.size(); i++) {
-            if (edge->value.first == vertex) {
-                edges.push_back(edge);
-            }
-
-            edge = edge->next;
+        double crossing =
+            start[axis] + (point[other] - start[other]) * (end[axis] - start[axis]) / (end[other] - start[other]);
+        if (crossing <= point[axis]) {
+            continue;
         }
+
+        // Counter clockwise contours cross rays along x upwards and rays along y to the left
+        bool isPositive = axis == 0 ? end[other] > start[other] : end[other] < start[other];
+        winding += isPositive ? segments[i].multiplicity : -segments[i].multiplicity;
     }
 
-    return edges;
+    return winding;
 }
 
 /**
- * @brief Get the contour containing specified edge
- *
- * @param edge Specified edge
+ * @brief Link boundary edges into closed contours of output polygon
  *
- * @return Contout containing edge
+ * @param edges Boundary edges
  */
-const Contour &PolygonOperator::_getContourOfEdge(CircularDLL<Edge>::Node *edge) {
-    // Search in first polygon
-    for (const Contour &contour : this->_first) {
-        CircularDLL<Edge>::Node *contourEdge = contour.outline.edges.getFirst();
-        for (unsigned int i = 0; i < contour.outline.edges.size(); i++) {
-            if (edge == contourEdge) {
-                return contour;
+void PolygonOperator::_linkBoundary(const std::vector<Edge> &edges) {
+    // Edges grouped by their start vertex, each vertex remembers the first of its outgoing edges that may be unused
+    std::vector<unsigned int> offsets(this->_vertices.size() + 1, 0);
+    for (const Edge &edge : edges) {
+        offsets[edge.first + 1]++;
+    }
+    std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+    std::vector<uint32_t> outgoing(edges.size());
+    std::vector<unsigned int> nextOutgoing(offsets.begin(), offsets.end() - 1);
+    for (uint32_t i = 0; i < edges.size(); i++) {
+        outgoing[nextOutgoing[edges[i].first]++] = i;
+    }
+    std::copy(offsets.begin(), offsets.end() - 1, nextOutgoing.begin());
+
+    std::vector<bool> isUsed(edges.size(), false);
+    auto getUnusedEdgeStartingAt = [&](uint32_t vertex) {
+        for (; nextOutgoing[vertex] < offsets[vertex + 1]; nextOutgoing[vertex]++) {
+            if (!isUsed[outgoing[nextOutgoing[vertex]]]) {
+                return outgoing[nextOutgoing[vertex]];
             }
+        }
+
+        return EdgePool::NONE;
+    };
 
-            contourEdge = contourEdge->next;
+    for (uint32_t i = 0; i < edges.size(); i++) {
+        if (isUsed[i]) {
+            continue;
         }
-    }
 
-    // Search in second polygon
-    for (const Contour &contour : this->_second) {
-        CircularDLL<Edge>::Node *contourEdge = contour.outline.edges.getFirst();
-        for (unsigned int i = 0; i < contour.outline.edges.size(); i++) {
-            if (edge == contourEdge) {
-                return contour;
+        // Follow edges until the contour is closed, contour stays open only if boundary is broken by rounding errors
+        Contour contour{false, this->_edges.addLoop(), Outline::Orientation::CW};
+        uint32_t edge = i;
+        while (edge != EdgePool::NONE) {
+            isUsed[edge] = true;
+            this->_edges.insertLast(contour.loop, edges[edge]);
+
+            if (edges[edge].second == edges[i].first) {
+                break;
             }
 
-            contourEdge = contourEdge->next;
+            edge = getUnusedEdgeStartingAt(edges[edge].second);
         }
-    }
 
-    throw std::runtime_error("PolygonOperator::_getContourOfEdge(): Edge does not belong to any polygon");
+        contour.orientation =
+            this->_signedAreaOfContour(contour) >= 0 ? Outline::Orientation::CCW : Outline::Orientation::CW;
+        this->_output.push_back(contour);
+    }
 }
 
 /**
- * @brief Get orientation for a part of a contour. The part starts and ends in the same vertex.
+ * @brief Check if edges intersect
  *
- * @param outline Full contour
- * @param start Starting edge of subcontour
+ * @param first First edge
+ * @param second Second edge
+ * @param intersection Sets the point of intesection if exists
  *
- * @return Orienatation of subcontour
+ * @return True if edges intersect
  */
-Outline::Orientation PolygonOperator::_getOrientationOfSubcontour(const Outline &outline,
-                                                                  CircularDLL<Edge>::Node *start) {
-    CircularDLL<Edge>::Node *current = start;
-    double area = 0;
-    bool isPartOfSubcontour = true;
-
-    do {
-        if (isPartOfSubcontour) {
-            area += this->_vertices[current->value.first].x * this->_vertices[current->value.second].y -
-                    this->_vertices[current->value.second].x * this->_vertices[current->value.first].y;
-        }
+bool PolygonOperator::_intersect(Edge first, Edge second, glm::vec2 &intersection) {
+    double x1 = this->_vertices.at(first.first).x;
+    double y1 = this->_vertices.at(first.first).y;
+    double x2 = this->_vertices.at(first.second).x;
+    double y2 = this->_vertices.at(first.second).y;
+    double x3 = this->_vertices.at(second.first).x;
+    double y3 = this->_vertices.at(second.first).y;
+    double x4 = this->_vertices.at(second.second).x;
+    double y4 = this->_vertices.at(second.second).y;
 
-        // Move to next edge
-        current = current->next;
+    double det1 = this->_determinant(x1 - x2, y1 - y2, x3 - x4, y3 - y4);
+    double det2 = this->_determinant(x1 - x3, y1 - y3, x3 - x4, y3 - y4);
 
-        // Get all edges starting at current vertex
-        std::vector<CircularDLL<Edge>::Node *> edges;
-        CircularDLL<Edge>::Node *edge = outline.edges.getFirst();
-        for (unsigned int i = 0; i < outline.edges.size(); i++) {
-            if (edge->value.first == current->value.first) {
-                edges.push_back(edge);
-            }
+    // Check if edges are parallel
+    if (std::fabs(det1) < this->_epsilon || std::fabs(det2) < this->_epsilon) {
+        return false;
+    }
 
-            edge = edge->next;
-        }
+    intersection.x =
+        this->_determinant(this->_determinant(x1, y1, x2, y2), x1 - x2, this->_determinant(x3, y3, x4, y4), x3 - x4) /
+        det1;
+    intersection.y =
+        this->_determinant(this->_determinant(x1, y1, x2, y2), y1 - y2, this->_determinant(x3, y3, x4, y4), y3 - y4) /
+        det1;
 
-        // Skip edges that are not part of subcontour
-        if (edges.size() >= 2) {
-            isPartOfSubcontour = !isPartOfSubcontour;
-        }
-    } while (current != start);
+    // Check if intersection is in the boundaries of both edges
+    if (((intersection.x >= std::min(x1, x2) && intersection.x <= std::max(x1, x2)) &&
+         (intersection.y >= std::min(y1, y2) && intersection.y <= std::max(y1, y2))) &&
+        ((intersection.x >= std::min(x3, x4) && intersection.x <= std::max(x3, x4)) &&
+         (intersection.y >= std::min(y3, y4) && intersection.y <= std::max(y3, y4)))) {
+        return true;
+    }
 
-    return area >= 0 ? Outline::Orientation::CCW : Outline::Orientation::CW;
+    return false;
 }
 
 /**
  * @brief Get the signed area of contour
  *
- * @param outline Contour
+ * @param contour Contour
  *
  * @return Signed area
  */
-double PolygonOperator::_signedAreaOfContour(const Outline &outline) {
-    CircularDLL<Edge>::Node *current = outline.edges.getFirst();
+double PolygonOperator::_signedAreaOfContour(const Contour &contour) {
+    uint32_t current = this->_edges.getFirst(contour.loop);
     double area = 0;
 
-    for (unsigned int i = 0; i < outline.edges.size(); i++) {
-        area += this->_vertices[current->value.first].x * this->_vertices[current->value.second].y -
-                this->_vertices[current->value.second].x * this->_vertices[current->value.first].y;
-        current = current->next;
+    for (unsigned int i = 0; i < this->_edges.getSize(contour.loop); i++) {
+        const Edge &edge = this->_edges[current].value;
+        area += this->_vertices[edge.first].x * this->_vertices[edge.second].y -
+                this->_vertices[edge.second].x * this->_vertices[edge.first].y;
+        current = this->_edges[current].next;
     }
 
     return area;
 }
 
-/**
- * @brief Check whether point lies on the left side of line
- *
- * @param lineStartingPoint Line start
- * @param lineEndingPoint Line end
- * @param point Point to check
- *
- * @return True if point lies on the left of line
- */
-bool PolygonOperator::_isOnLeftSide(glm::vec2 lineStartingPoint, glm::vec2 lineEndingPoint, glm::vec2 point) {
-    float a = lineEndingPoint.y - lineStartingPoint.y;
-    float b = lineStartingPoint.x - lineEndingPoint.x;
-    float c = lineEndingPoint.x * lineStartingPoint.y - lineStartingPoint.x * lineEndingPoint.y;
-    float d = a * point.x + b * point.y + c;
-
-    return d < 0;
-}
-
 /**
  * @brief Calculates the determinant of a 2x2 matrix
  *
@@ -944,19 +723,6 @@ double PolygonOperator::_determinant(double a, double b, double c, double d) {
     return (a * d) - (b * c);
 }
 
-/**
- * @brief Checks whether the second edge fully lies on first edge
- *
- * @param first First edge
- * @param second Second edge
- *
- * @return True if second edge fully lies on second edge
- */
-bool PolygonOperator::_isEdgeOnEdge(Edge first, Edge second) {
-    return this->_isPointOnEdge(this->_vertices.at(first.first), second) &&
-           this->_isPointOnEdge(this->_vertices.at(first.second), second);
-}
-
 /**
  * @brief Check whether a point lies on edge
  *
@@ -999,7 +765,13 @@ void PolygonOperator::setEpsilon(double epsilon) {
  * @return Output polygon
  */
 std::vector<Outline> PolygonOperator::getPolygon() {
-    return this->_output;
+    std::vector<Outline> polygon;
+    polygon.reserve(this->_output.size());
+    for (const Contour &contour : this->_output) {
+        polygon.push_back(this->_edges.getOutline(contour.loop, contour.orientation));
+    }
+
+    return polygon;
 }
 
 /**
@@ -1012,4 +784,14 @@ std::vector<glm::vec2> PolygonOperator::getVertices() {
     return this->_vertices;
 }
 
+/**
+ * @brief Check whether contours of the polygon passed to the last unite() intersected, touched or overlapped, if they
+ * did not, their union was skipped
+ *
+ * @return True if contours overlapped
+ */
+bool PolygonOperator::hasOverlappingContours() const {
+    return this->_hasOverlappingContours;
+}
+
 }  // namespace vft
@@ -19,29 +19,32 @@ SdfTessellator::SdfTessellator() {}
  * @param font Font of glyph
  * @param fontSize Font size of glyph
  */
-Glyph SdfTessellator::composeGlyph(uint32_t glyphId, std::shared_ptr<vft::Font> font, unsigned int fontSize) {
-    // SDFs in font atlas have size 64
-    font->setPixelSize(64);
+Glyph SdfTessellator::composeGlyph(uint32_t glyphId, std::shared_ptr<vft::Font> font, unsigned int fontSize) const {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    // SDFs in font atlas have size 64, only the face of current thread is resized
+    FT_Face face = font->getThreadFace();
+    FT_Set_Pixel_Sizes(face, 64, 64);
 
     // Get glyph from .ttf file
-    if (FT_Load_Glyph(font->getFace(), glyphId, FT_LOAD_RENDER)) {
+    if (FT_Load_Glyph(face, glyphId, FT_LOAD_RENDER)) {
         throw std::runtime_error("SdfTessellator::composeGlyph(): Error loading glyph");
     }
-    if (FT_Render_Glyph(font->getFace()->glyph, FT_RENDER_MODE_SDF)) {
+    if (FT_Render_Glyph(face->glyph, FT_RENDER_MODE_SDF)) {
         throw std::runtime_error("FontAtlas::FontAtlas(): Error rasterizing sdf bitmap");
     }
-    FT_GlyphSlot slot = font->getFace()->glyph;
+    FT_GlyphSlot slot = face->glyph;
     const FT_Bitmap &bitmap = slot->bitmap;
 
     // Set glyph metrics (save in font units)
-    glm::vec2 scale = font->getScalingVector(font->getPixelSize());
-    this->_currentGlyph = Glyph{};
-    this->_currentGlyph.setWidth(bitmap.width / scale.x);
-    this->_currentGlyph.setHeight(bitmap.rows / scale.y);
-    this->_currentGlyph.setBearingX(slot->bitmap_left / scale.x);
-    this->_currentGlyph.setBearingY(slot->bitmap_top / scale.y);
-    this->_currentGlyph.setAdvanceX(slot->advance.x / scale.x);
-    this->_currentGlyph.setAdvanceY(slot->advance.y / scale.y);
+    glm::vec2 scale = font->getScalingVector(64);
+    Glyph glyph{};
+    glyph.setWidth(bitmap.width / scale.x);
+    glyph.setHeight(bitmap.rows / scale.y);
+    glyph.setBearingX(slot->bitmap_left / scale.x);
+    glyph.setBearingY(slot->bitmap_top / scale.y);
+    glyph.setAdvanceX(slot->advance.x / scale.x);
+    glyph.setAdvanceY(slot->advance.y / scale.y);
 
     std::vector<glm::vec2> vertices;
     std::vector<uint32_t> boundingBoxIndices;
@@ -49,7 +52,7 @@ Glyph SdfTessellator::composeGlyph(uint32_t glyphId, std::shared_ptr<vft::Font>
     // Add vertices and indices of bounding box only if glyph has at least one vertex
     if (slot->outline.n_points > 0) {
         // Add bounding box vertices
-        std::array<glm::vec2, 4> boundingBox = this->_currentGlyph.getBoundingBox();
+        std::array<glm::vec2, 4> boundingBox = glyph.getBoundingBox();
         vertices.insert(vertices.end(), boundingBox.begin(), boundingBox.end());
 
         // Create bounding box indices that form two triangles
@@ -62,10 +65,32 @@ Glyph SdfTessellator::composeGlyph(uint32_t glyphId, std::shared_ptr<vft::Font>
         boundingBoxIndices = {0, 3, 1, 2, 1, 3};
     }
 
-    GlyphMesh mesh{vertices, {boundingBoxIndices}};
-    this->_currentGlyph.mesh = mesh;
+    glyph.mesh = GlyphMesh{vertices, {boundingBoxIndices}};
+
+    this->_recordStats(start, glyph, 0);
+
+    return glyph;
+}
+
+/**
+ * @brief Get algorithm used by this tessellator
+ *
+ * @return Tessellation strategy
+ */
+TessellationStrategy SdfTessellator::getStrategy() const {
+    return TessellationStrategy::SDF;
+}
+
+/**
+ * @brief Create a new tessellator of the same type, which records statistics together with this tessellator
+ *
+ * @return New tessellator
+ */
+std::unique_ptr<Tessellator> SdfTessellator::clone() const {
+    std::unique_ptr<Tessellator> tessellator = std::make_unique<SdfTessellator>();
+    this->_shareStats(*tessellator);
 
-    return this->_currentGlyph;
+    return tessellator;
 }
 
 }  // namespace vft
@@ -1,4 +1,4 @@
-﻿/**
+/**
  * @file sdf_text_renderer.cpp
  * @author Christian Saloň
  */
@@ -15,20 +15,22 @@ namespace vft {
  */
 SdfTextRenderer::SdfTextRenderer(float softEdgeMin, float softEdgeMax)
     : _useSoftEdges{true}, _softEdgeMin{softEdgeMin}, _softEdgeMax{softEdgeMax} {
-    this->_tessellator = std::make_unique<SdfTessellator>();
+    this->_tessellator = std::make_shared<SdfTessellator>();
 }
 
 /**
  * @brief Initialize sdf text renderer, does not use antialiasing
  */
 SdfTextRenderer::SdfTextRenderer() {
-    this->_tessellator = std::make_unique<SdfTessellator>();
+    this->_tessellator = std::make_shared<SdfTessellator>();
 }
 
 /**
  * @brief Recreates vertex and index buffers for all characters in text block
  */
 void SdfTextRenderer::update() {
+    this->_resetCompositionBudget();
+
     this->_vertices.clear();
     this->_boundingBoxIndices.clear();
     this->_offsets.clear();
@@ -36,22 +38,22 @@ void SdfTextRenderer::update() {
     uint32_t vertexCount = 0;
     uint32_t boundingBoxIndexCount = 0;
 
+    // Glyphs missing in font atlases (key: font family, value: font and glyph ids)
+    std::unordered_map<std::string, std::pair<std::shared_ptr<Font>, std::vector<uint32_t>>> missingGlyphs{};
+    // Font atlas and glyph id of every bounding box in vertex buffer
+    std::vector<std::pair<FontAtlas *, uint32_t>> boundingBoxGlyphs{};
+
     for (unsigned int i = 0; i < this->_textBlocks.size(); i++) {
         for (const Character &character : this->_textBlocks[i]->getCharacters()) {
-            GlyphKey key{character.getFont()->getFontFamily(), character.getGlyphId(), 0};
+            GlyphKey key = this->_getGlyphKey(character);
 
             if (!this->_offsets.contains(key)) {
-                // Insert glyph into cache
-                if (!this->_cache->exists(key)) {
-                    this->_cache->setGlyph(key,
-                                           this->_tessellator->composeGlyph(character.getGlyphId(), character.getFont(),
-                                                                            character.getFontSize()));
-                }
+                // Get glyph from cache, compose it if it is missing
+                std::shared_ptr<const Glyph> glyph = this->_getGlyph(key, character);
 
                 // Check if glyph has geometry
-                const Glyph &glyph = this->_cache->getGlyph(key);
-                if (glyph.mesh.getVertexCount() == 0 ||
-                    glyph.mesh.getIndexCount(SdfTessellator::GLYPH_MESH_BOUNDING_BOX_BUFFER_INDEX) == 0) {
+                if (glyph->mesh.getVertexCount() == 0 ||
+                    glyph->mesh.getIndexCount(SdfTessellator::GLYPH_MESH_BOUNDING_BOX_BUFFER_INDEX) == 0) {
                     this->_offsets.insert({key, GlyphInfo{0, 0}});
                     continue;
                 }
@@ -59,52 +61,67 @@ void SdfTextRenderer::update() {
                 // Compute buffer offsets
                 this->_offsets.insert(
                     {key, GlyphInfo{boundingBoxIndexCount,
-                                    glyph.mesh.getIndexCount(SdfTessellator::GLYPH_MESH_BOUNDING_BOX_BUFFER_INDEX)}});
-
-                // Get uv coordinnates from font atlas
-                if (!this->_fontAtlases.contains(character.getFont()->getFontFamily())) {
-                    throw std::runtime_error("VulkanSdfTextRenderer::update(): Font atlas for font " +
-                                             character.getFont()->getFontFamily() + " was not found");
+                                    glyph->mesh.getIndexCount(SdfTessellator::GLYPH_MESH_BOUNDING_BOX_BUFFER_INDEX)}});
+
+                // Create font atlas on demand if it was not added, glyphs missing in it are added after all glyphs
+                // are collected, so the atlas is grown and uploaded only once
+                std::string fontFamily = character.getFont()->getFontFamily();
+                if (!this->_fontAtlases.contains(fontFamily)) {
+                    this->_fontAtlases.insert(
+                        {fontFamily,
+                         FontAtlas{character.getFont(), FontAtlas::SDF_GLYPH_SIZE, std::vector<uint32_t>{}}});
                 }
 
-                FontAtlas::GlyphInfo glyphInfo =
-                    this->_fontAtlases.at(character.getFont()->getFontFamily()).getGlyph(character.getGlyphId());
-                glm::vec2 uvTopLeft = glyphInfo.uvTopLeft;
-                glm::vec2 uvBottomRight = glyphInfo.uvBottomRight;
-                glm::vec2 uvTopRight{uvBottomRight.x, uvTopLeft.y};
-                glm::vec2 uvBottomLeft{uvTopLeft.x, uvBottomRight.y};
-
-                // Insert bounding box vertices to vertex buffer
-                this->_vertices.push_back(Vertex{glyph.mesh.getVertices().at(0), uvBottomLeft});
-                this->_vertices.push_back(Vertex{glyph.mesh.getVertices().at(1), uvTopLeft});
-                this->_vertices.push_back(Vertex{glyph.mesh.getVertices().at(2), uvTopRight});
-                this->_vertices.push_back(Vertex{glyph.mesh.getVertices().at(3), uvBottomRight});
-
-                // Insert bounding box indices to index buffer
-                this->_boundingBoxIndices.insert(
-                    this->_boundingBoxIndices.end(),
-                    glyph.mesh.getIndices(SdfTessellator::GLYPH_MESH_BOUNDING_BOX_BUFFER_INDEX).begin(),
-                    glyph.mesh.getIndices(SdfTessellator::GLYPH_MESH_BOUNDING_BOX_BUFFER_INDEX).end());
-
-                // Add an offset to bounding box indices of current character
-                for (unsigned int j = boundingBoxIndexCount; j < this->_boundingBoxIndices.size(); j++) {
-                    this->_boundingBoxIndices[j] += vertexCount;
+                FontAtlas &atlas = this->_fontAtlases.at(fontFamily);
+                if (!atlas.contains(character.getGlyphId())) {
+                    missingGlyphs[fontFamily].first = character.getFont();
+                    missingGlyphs[fontFamily].second.push_back(character.getGlyphId());
                 }
+                boundingBoxGlyphs.push_back({&atlas, character.getGlyphId()});
+
+                // Insert bounding box vertices to vertex buffer, uvs are set when all glyphs are in font atlases
+                this->_vertices.push_back(Vertex{glyph->mesh.getVertex(0), glm::vec2{0, 0}});
+                this->_vertices.push_back(Vertex{glyph->mesh.getVertex(1), glm::vec2{0, 0}});
+                this->_vertices.push_back(Vertex{glyph->mesh.getVertex(2), glm::vec2{0, 0}});
+                this->_vertices.push_back(Vertex{glyph->mesh.getVertex(3), glm::vec2{0, 0}});
 
-                vertexCount += glyph.mesh.getVertexCount();
-                boundingBoxIndexCount += glyph.mesh.getIndexCount(SdfTessellator::GLYPH_MESH_BOUNDING_BOX_BUFFER_INDEX);
+                // Insert bounding box indices to index buffer, offset indices by vertices of previous glyphs
+                glyph->mesh.appendIndices(SdfTessellator::GLYPH_MESH_BOUNDING_BOX_BUFFER_INDEX,
+                                          this->_boundingBoxIndices, vertexCount);
+
+                vertexCount += glyph->mesh.getVertexCount();
+                boundingBoxIndexCount +=
+                    glyph->mesh.getIndexCount(SdfTessellator::GLYPH_MESH_BOUNDING_BOX_BUFFER_INDEX);
             }
         }
     }
+
+    // Add missing glyphs to font atlases, atlases may grow, so uvs are computed afterwards
+    for (auto &[fontFamily, glyphs] : missingGlyphs) {
+        this->_fontAtlases.at(fontFamily).addGlyphs(glyphs.first, glyphs.second);
+    }
+
+    // Get uv coordinates from font atlases
+    for (std::size_t i = 0; i < boundingBoxGlyphs.size(); i++) {
+        FontAtlas::GlyphInfo glyphInfo = boundingBoxGlyphs[i].first->getGlyph(boundingBoxGlyphs[i].second);
+        glm::vec2 uvTopLeft = glyphInfo.uvTopLeft;
+        glm::vec2 uvBottomRight = glyphInfo.uvBottomRight;
+
+        this->_vertices[4 * i].uv = glm::vec2{uvTopLeft.x, uvBottomRight.y};
+        this->_vertices[4 * i + 1].uv = uvTopLeft;
+        this->_vertices[4 * i + 2].uv = glm::vec2{uvBottomRight.x, uvTopLeft.y};
+        this->_vertices[4 * i + 3].uv = uvBottomRight;
+    }
 }
 
 /**
- * @brief Add font atlas used for rendering glyphs
+ * @brief Add font atlas used for rendering glyphs, font atlases of fonts without one are created on demand. Replaces
+ * the font atlas of the same font family, including one created on demand, uvs refer to it after the next update
  *
  * @param atlas Font atlas to add
  */
 void SdfTextRenderer::addFontAtlas(const FontAtlas &atlas) {
-    this->_fontAtlases.insert({atlas.getFontFamily(), atlas});
+    this->_fontAtlases.insert_or_assign(atlas.getFontFamily(), atlas);
 }
 
 }  // namespace vft
@@ -40,8 +40,8 @@ std::vector<std::vector<ShapedCharacter>> Shaper::shape(std::u32string text,
     }
     newLines.push_back(text.size());
 
-    // Create font objects
-    hb_face_t *hbFace = hb_ft_face_create(font->getFace(), 0);
+    // Create font objects, harfbuzz reads font tables through the face of current thread
+    hb_face_t *hbFace = hb_ft_face_create(font->getThreadFace(), 0);
     hb_font_t *hbFont = hb_font_create(hbFace);
 
     // Construct shaping output for all glyphs
@@ -0,0 +1,191 @@
+/**
+ * @file skyline_packer.cpp
+ * @author Christian Saloň
+ */
+
+#include "skyline_packer.h"
+
+namespace vft {
+
+/**
+ * @brief SkylinePacker constructor, the skyline is initially one segment at the top of packing area
+ *
+ * @param width Width of packing area
+ */
+SkylinePacker::SkylinePacker(unsigned int width) : _width{width} {
+    this->_skyline.push_back(Node{0, 0, width});
+}
+
+/**
+ * @brief Find position where rectangle would be placed by insert without placing it, the position does not depend on
+ * the height of rectangle
+ *
+ * @param width Width of rectangle
+ *
+ * @return Position of top left corner of rectangle, std::nullopt if rectangle is wider than packing area
+ */
+std::optional<glm::uvec2> SkylinePacker::findPosition(unsigned int width) const {
+    glm::uvec2 position{0, 0};
+    if (!this->_findNode(width, position).has_value()) {
+        return std::nullopt;
+    }
+
+    return position;
+}
+
+/**
+ * @brief Place rectangle on skyline at the position where its bottom edge is the lowest
+ *
+ * @param width Width of rectangle
+ * @param height Height of rectangle
+ *
+ * @return Position of top left corner of rectangle, std::nullopt if rectangle is wider than packing area
+ */
+std::optional<glm::uvec2> SkylinePacker::insert(unsigned int width, unsigned int height) {
+    glm::uvec2 position{0, 0};
+    std::optional<std::size_t> nodeIndex = this->_findNode(width, position);
+    if (!nodeIndex.has_value()) {
+        return std::nullopt;
+    }
+
+    this->_addNode(nodeIndex.value(), position, width, height);
+    this->_height = std::max(this->_height, position.y + height);
+
+    return position;
+}
+
+/**
+ * @brief Widen packing area, the added area is empty at all heights, so packed rectangles keep their positions
+ *
+ * @param width New width of packing area
+ *
+ * @throws std::invalid_argument if new width is smaller than the current width
+ */
+void SkylinePacker::setWidth(unsigned int width) {
+    if (width < this->_width) {
+        throw std::invalid_argument("SkylinePacker::setWidth(): Packing area can not be narrowed");
+    }
+    if (width == this->_width) {
+        return;
+    }
+
+    if (!this->_skyline.empty() && this->_skyline.back().y == 0) {
+        this->_skyline.back().width += width - this->_width;
+    } else {
+        this->_skyline.push_back(Node{this->_width, 0, width - this->_width});
+    }
+
+    this->_width = width;
+}
+
+/**
+ * @brief Getter for width of packing area
+ *
+ * @return Width of packing area
+ */
+unsigned int SkylinePacker::getWidth() const {
+    return this->_width;
+}
+
+/**
+ * @brief Get height of packed rectangles, which is the height of the lowest point of skyline
+ *
+ * @return Height of packed rectangles
+ */
+unsigned int SkylinePacker::getHeight() const {
+    return this->_height;
+}
+
+/**
+ * @brief Find skyline segment where rectangle is placed, its bottom edge is the lowest there
+ *
+ * @param width Width of rectangle
+ * @param position Position of top left corner of rectangle
+ *
+ * @return Index of skyline segment where rectangle starts, std::nullopt if rectangle is wider than packing area
+ */
+std::optional<std::size_t> SkylinePacker::_findNode(unsigned int width, glm::uvec2 &position) const {
+    std::optional<std::size_t> bestNodeIndex{std::nullopt};
+
+    for (std::size_t i = 0; i < this->_skyline.size(); i++) {
+        std::optional<unsigned int> y = this->_fit(i, width);
+        if (!y.has_value()) {
+            continue;
+        }
+
+        // Nodes are ordered from left to right, so the leftmost position is kept on ties
+        if (!bestNodeIndex.has_value() || y.value() < position.y) {
+            bestNodeIndex = i;
+            position = glm::uvec2{this->_skyline[i].x, y.value()};
+        }
+    }
+
+    return bestNodeIndex;
+}
+
+/**
+ * @brief Get y coordinate of rectangle whose left edge starts at given skyline segment. The rectangle lies on the
+ * highest segment it spans
+ *
+ * @param nodeIndex Index of skyline segment
+ * @param width Width of rectangle
+ *
+ * @return Y coordinate of top edge of rectangle, std::nullopt if rectangle exceeds packing area
+ */
+std::optional<unsigned int> SkylinePacker::_fit(std::size_t nodeIndex, unsigned int width) const {
+    if (this->_skyline[nodeIndex].x + width > this->_width) {
+        return std::nullopt;
+    }
+
+    unsigned int y = 0;
+    unsigned int remainingWidth = width;
+    for (std::size_t i = nodeIndex; remainingWidth > 0; i++) {
+        y = std::max(y, this->_skyline[i].y);
+        remainingWidth -= std::min(remainingWidth, this->_skyline[i].width);
+    }
+
+    return y;
+}
+
+/**
+ * @brief Raise skyline under placed rectangle, segments covered by the rectangle are shrunk or removed and neighbouring
+ * segments of the same height are merged
+ *
+ * @param nodeIndex Index of skyline segment where rectangle starts
+ * @param position Position of top left corner of rectangle
+ * @param width Width of rectangle
+ * @param height Height of rectangle
+ */
+void SkylinePacker::_addNode(std::size_t nodeIndex,
+                             const glm::uvec2 &position,
+                             unsigned int width,
+                             unsigned int height) {
+    this->_skyline.insert(this->_skyline.begin() + nodeIndex, Node{position.x, position.y + height, width});
+
+    // Remove parts of segments covered by new segment
+    unsigned int right = position.x + width;
+    std::size_t i = nodeIndex + 1;
+    while (i < this->_skyline.size() && this->_skyline[i].x < right) {
+        unsigned int nodeRight = this->_skyline[i].x + this->_skyline[i].width;
+        if (nodeRight <= right) {
+            this->_skyline.erase(this->_skyline.begin() + i);
+            continue;
+        }
+
+        this->_skyline[i].width = nodeRight - right;
+        this->_skyline[i].x = right;
+        break;
+    }
+
+    // Merge segments of the same height
+    for (std::size_t j = 0; j + 1 < this->_skyline.size();) {
+        if (this->_skyline[j].y == this->_skyline[j + 1].y) {
+            this->_skyline[j].width += this->_skyline[j + 1].width;
+            this->_skyline.erase(this->_skyline.begin() + j + 1);
+        } else {
+            j++;
+        }
+    }
+}
+
+}  // namespace vft
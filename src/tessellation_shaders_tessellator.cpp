@@ -3,8 +3,6 @@
  * @author Christian Saloň
  */
 
-#include "CDT.h"
-
 #include "tessellation_shaders_tessellator.h"
 
 namespace vft {
@@ -14,120 +12,100 @@ namespace vft {
  */
 TessellationShadersTessellator::TessellationShadersTessellator() {
     this->_moveToFunc = [](const FT_Vector *to, void *user) {
-        TessellationShadersTessellator *pThis = reinterpret_cast<TessellationShadersTessellator *>(user);
-
-        // Assign orientation of contour to second polygon
-        pThis->_secondPolygon[0].orientation = pThis->area >= 0 ? Outline::Orientation::CCW : Outline::Orientation::CW;
-
-        if (pThis->contourCount >= 2) {
-            // Perform union of contours
-            PolygonOperator polygonOperator{};
-            polygonOperator.join(pThis->_currentGlyph.mesh.getVertices(), pThis->_firstPolygon, pThis->_secondPolygon);
-            pThis->_currentGlyph.mesh.setVertices(polygonOperator.getVertices());
-            pThis->_firstPolygon = polygonOperator.getPolygon();
-            pThis->_secondPolygon = {Outline{}};
-
-            pThis->vertexIndex = pThis->_currentGlyph.mesh.getVertexCount();
-        } else if (pThis->contourCount == 1) {
-            pThis->_firstPolygon = pThis->_secondPolygon;
-            pThis->_secondPolygon = {Outline{}};
-        }
+        Context *context = static_cast<Context *>(reinterpret_cast<Tessellator::Context *>(user));
+
+        // Start new contour, all contours are joined at once when the glyph is composed
+        context->contours.push_back(Outline{});
 
         // Process contour starting vertex
         glm::vec2 vertex{static_cast<float>(to->x), static_cast<float>(to->y)};
-        uint32_t vertexIndex = pThis->_getVertexIndex(vertex);
-        if (vertexIndex == pThis->vertexIndex) {
-            pThis->_currentGlyph.mesh.addVertex(vertex);
-            pThis->vertexIndex++;
+        uint32_t vertexIndex = context->getVertexIndex(vertex);
+        if (vertexIndex == context->vertexIndex) {
+            context->vertices.push_back(vertex);
+            context->vertexIndex++;
         }
 
         // Update glyph data
-        pThis->contourStartVertexIndex = vertexIndex;
-        pThis->lastVertex = vertex;
-        pThis->lastVertexIndex = vertexIndex;
-        pThis->contourCount++;
-        pThis->area = 0;
+        context->contourStartVertexIndex = vertexIndex;
+        context->lastVertex = vertex;
+        context->lastVertexIndex = vertexIndex;
+        context->contourCount++;
 
         return 0;
     };
 
     this->_lineToFunc = [](const FT_Vector *to, void *user) {
-        TessellationShadersTessellator *pThis = reinterpret_cast<TessellationShadersTessellator *>(user);
+        Context *context = static_cast<Context *>(reinterpret_cast<Tessellator::Context *>(user));
 
         // Process line end vertex
         glm::vec2 endVertex{static_cast<float>(to->x), static_cast<float>(to->y)};
-        uint32_t endVertexIndex = pThis->_getVertexIndex(endVertex);
-        if (endVertexIndex == pThis->vertexIndex) {
-            pThis->_currentGlyph.mesh.addVertex(endVertex);
-            pThis->vertexIndex++;
+        uint32_t endVertexIndex = context->getVertexIndex(endVertex);
+        if (endVertexIndex == context->vertexIndex) {
+            context->vertices.push_back(endVertex);
+            context->vertexIndex++;
         }
 
-        Edge edge{pThis->lastVertexIndex, endVertexIndex};
+        Edge edge{context->lastVertexIndex, endVertexIndex};
         if (edge.first != edge.second) {
             // Create line segment
-            pThis->_currentGlyph.addLineSegment(edge);
+            context->lineSegments.push_back(edge);
             // Add edge to polygon
-            pThis->_secondPolygon[0].edges.insertLast(edge);
-            // Update signed area of polygon
-            pThis->area += pThis->lastVertex.x * endVertex.y - endVertex.x * pThis->lastVertex.y;
+            context->contours.back().edges.push_back(edge);
         }
 
         // Update glyph data
-        pThis->lastVertex = endVertex;
-        pThis->lastVertexIndex = endVertexIndex;
+        context->lastVertex = endVertex;
+        context->lastVertexIndex = endVertexIndex;
 
         return 0;
     };
 
     this->_conicToFunc = [](const FT_Vector *control, const FT_Vector *to, void *user) {
-        TessellationShadersTessellator *pThis = reinterpret_cast<TessellationShadersTessellator *>(user);
+        Context *context = static_cast<Context *>(reinterpret_cast<Tessellator::Context *>(user));
 
-        glm::vec2 startPoint = pThis->lastVertex;
-        uint32_t startPointVertexIndex = pThis->lastVertexIndex;
+        glm::vec2 startPoint = context->lastVertex;
+        uint32_t startPointVertexIndex = context->lastVertexIndex;
 
         // Process curve control point
         glm::vec2 controlPoint{static_cast<float>(control->x), static_cast<float>(control->y)};
-        uint32_t controlPointVertexIndex = pThis->_getVertexIndex(controlPoint);
-        if (controlPointVertexIndex == pThis->vertexIndex) {
-            pThis->_currentGlyph.mesh.addVertex(controlPoint);
-            pThis->vertexIndex++;
+        uint32_t controlPointVertexIndex = context->getVertexIndex(controlPoint);
+        if (controlPointVertexIndex == context->vertexIndex) {
+            context->vertices.push_back(controlPoint);
+            context->vertexIndex++;
         }
 
         // Process curve end point
         glm::vec2 endPoint{static_cast<float>(to->x), static_cast<float>(to->y)};
-        uint32_t endPointVertexIndex = pThis->_getVertexIndex(endPoint);
-        if (endPointVertexIndex == pThis->vertexIndex) {
-            pThis->_currentGlyph.mesh.addVertex(endPoint);
-            pThis->vertexIndex++;
+        uint32_t endPointVertexIndex = context->getVertexIndex(endPoint);
+        if (endPointVertexIndex == context->vertexIndex) {
+            context->vertices.push_back(endPoint);
+            context->vertexIndex++;
         }
 
         // Create curve segment
-        pThis->_currentGlyph.addCurveSegment(
+        context->curveSegments.push_back(
             Curve{startPointVertexIndex, controlPointVertexIndex, endPointVertexIndex});
 
-        if (pThis->_isOnLeftSide(startPoint, endPoint, controlPoint)) {
+        if (TessellationShadersTessellator::_isOnLeftSide(startPoint, endPoint, controlPoint)) {
             // Add only edge from start point to end point
             if (startPointVertexIndex != endPointVertexIndex) {
-                pThis->_secondPolygon[0].edges.insertLast(Edge{startPointVertexIndex, endPointVertexIndex});
-                pThis->area += startPoint.x * endPoint.y - endPoint.x * startPoint.y;
+                context->contours.back().edges.push_back(Edge{startPointVertexIndex, endPointVertexIndex});
             }
         } else {
             // Add edge from start to control point
             if (startPointVertexIndex != controlPointVertexIndex) {
-                pThis->_secondPolygon[0].edges.insertLast(Edge{startPointVertexIndex, controlPointVertexIndex});
-                pThis->area += startPoint.x * controlPoint.y - controlPoint.x * startPoint.y;
+                context->contours.back().edges.push_back(Edge{startPointVertexIndex, controlPointVertexIndex});
             }
 
             // Add edge from control to end point
             if (controlPointVertexIndex != endPointVertexIndex) {
-                pThis->_secondPolygon[0].edges.insertLast(Edge{controlPointVertexIndex, endPointVertexIndex});
-                pThis->area += controlPoint.x * endPoint.y - endPoint.x * controlPoint.y;
+                context->contours.back().edges.push_back(Edge{controlPointVertexIndex, endPointVertexIndex});
             }
         }
 
         // Update glyph data
-        pThis->lastVertex = endPoint;
-        pThis->lastVertexIndex = endPointVertexIndex;
+        context->lastVertex = endPoint;
+        context->lastVertexIndex = endPointVertexIndex;
 
         return 0;
     };
@@ -142,65 +120,68 @@ TessellationShadersTessellator::TessellationShadersTessellator() {
  */
 Glyph TessellationShadersTessellator::composeGlyph(uint32_t glyphId,
                                                    std::shared_ptr<vft::Font> font,
-                                                   unsigned int fontSize) {
-    // Initialize polygons
-    this->_firstPolygon = {Outline{}};
-    this->_secondPolygon = {Outline{}};
+                                                   unsigned int fontSize) const {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    Context context{};
 
     GlyphKey key{font->getFontFamily(), glyphId, 0};
-    Glyph glyph = TessellationShadersTessellator::_composeGlyph(glyphId, font);
+    Glyph glyph = TessellationShadersTessellator::_composeGlyph(glyphId, font, context);
 
     std::vector<glm::vec2> vertices;
-    std::vector<Edge> edges;
     std::vector<uint32_t> triangles;
 
-    if (this->contourCount >= 1) {
-        // Assign orientation of contour to second polygon
-        this->_secondPolygon[0].orientation = this->area >= 0 ? Outline::Orientation::CCW : Outline::Orientation::CW;
-
-        // Perform union of contours
+    if (context.contourCount >= 1) {
+        // Perform union of all contours
         PolygonOperator polygonOperator{};
-        polygonOperator.join(this->_currentGlyph.mesh.getVertices(), this->_firstPolygon, this->_secondPolygon);
+        polygonOperator.unite(context.vertices, context.contours);
+        if (!polygonOperator.hasOverlappingContours()) {
+            this->_recordSkippedUnion();
+        }
         vertices = polygonOperator.getVertices();
         std::vector<Outline> polygon = polygonOperator.getPolygon();
 
-        // Create edges for triangulation
-        for (Outline &outline : polygon) {
-            for (unsigned int i = 0; i < outline.edges.size(); i++) {
-                uint32_t startVertexIndex = outline.edges.getAt(i)->value.first;
-                uint32_t endVertexIndex = outline.edges.getAt(i)->value.second;
-
-                edges.push_back(Edge{startVertexIndex, endVertexIndex});
-            }
-        }
-
-        // Remove duplicate vertices
-        CDT::DuplicatesInfo info = CDT::RemoveDuplicatesAndRemapEdges<float>(
-            vertices, [](const glm::vec2 &p) { return p.x; }, [](const glm::vec2 &p) { return p.y; }, edges.begin(),
-            edges.end(), [](const Edge &e) { return e.first; }, [](const Edge &e) { return e.second; },
-            [](uint32_t i1, uint32_t i2) -> Edge {
-                return Edge{i1, i2};
-            });
-
         // Triangulation of inner triangles
-        triangles = GlyphCompositor::triangulate(vertices, edges);
+        triangles = GlyphCompositor::triangulate(vertices, polygon);
     }
 
     // Index buffer for curve segments
     std::vector<uint32_t> curveIndices;
-    for (Curve curve : glyph.getCurveSegmentsIndices()) {
+    for (Curve curve : context.curveSegments) {
         curveIndices.push_back(curve.start);
         curveIndices.push_back(curve.control);
         curveIndices.push_back(curve.end);
     }
 
     // Set vertex and index buffer for composed glyph
-    GlyphMesh mesh{vertices, {triangles, curveIndices}};
-    glyph.mesh = mesh;
+    glyph.mesh = GlyphMesh{vertices, {triangles, curveIndices}};
+
+    this->_recordStats(start, glyph, context.lineSegments.size() + context.curveSegments.size());
 
     return glyph;
 }
 
+/**
+ * @brief Get algorithm used by this tessellator
+ *
+ * @return Tessellation strategy
+ */
+TessellationStrategy TessellationShadersTessellator::getStrategy() const {
+    return TessellationStrategy::TESSELLATION_SHADERS;
+}
+
+/**
+ * @brief Create a new tessellator of the same type, which records statistics together with this tessellator
+ *
+ * @return New tessellator
+ */
+std::unique_ptr<Tessellator> TessellationShadersTessellator::clone() const {
+    std::unique_ptr<Tessellator> tessellator = std::make_unique<TessellationShadersTessellator>();
+    this->_shareStats(*tessellator);
+
+    return tessellator;
+}
+
 /**
  * @brief Check whether point lies on the left side of line
  *
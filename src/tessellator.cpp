@@ -12,68 +12,68 @@ namespace vft {
  */
 Tessellator::Tessellator() {
     this->_moveToFunc = [](const FT_Vector *to, void *user) {
-        Tessellator *pThis = reinterpret_cast<Tessellator *>(user);
+        Context *context = reinterpret_cast<Context *>(user);
 
         // Start processing new contour
         glm::vec2 newVertex{static_cast<float>(to->x), static_cast<float>(to->y)};
-        uint32_t newVertexIndex = pThis->_getVertexIndex(newVertex);
-        if (newVertexIndex == pThis->vertexIndex) {
-            pThis->_currentGlyph.mesh.addVertex(newVertex);
-            pThis->vertexIndex++;
+        uint32_t newVertexIndex = context->getVertexIndex(newVertex);
+        if (newVertexIndex == context->vertexIndex) {
+            context->vertices.push_back(newVertex);
+            context->vertexIndex++;
         }
 
         // Update glyph data
-        pThis->lastVertex = newVertex;
-        pThis->lastVertexIndex = newVertexIndex;
-        pThis->contourStartVertexIndex = newVertexIndex;
-        pThis->contourCount++;
+        context->lastVertex = newVertex;
+        context->lastVertexIndex = newVertexIndex;
+        context->contourStartVertexIndex = newVertexIndex;
+        context->contourCount++;
 
         return 0;
     };
 
     this->_lineToFunc = [](const FT_Vector *to, void *user) {
-        Tessellator *pThis = reinterpret_cast<Tessellator *>(user);
+        Context *context = reinterpret_cast<Context *>(user);
 
         glm::vec2 newVertex{static_cast<float>(to->x), static_cast<float>(to->y)};
-        uint32_t newVertexIndex = pThis->_getVertexIndex(newVertex);
-        if (newVertexIndex == pThis->vertexIndex) {
-            pThis->_currentGlyph.mesh.addVertex(newVertex);
-            pThis->vertexIndex++;
+        uint32_t newVertexIndex = context->getVertexIndex(newVertex);
+        if (newVertexIndex == context->vertexIndex) {
+            context->vertices.push_back(newVertex);
+            context->vertexIndex++;
         }
 
         // Add line segment
-        pThis->_currentGlyph.addLineSegment(Edge{pThis->lastVertexIndex, newVertexIndex});
+        context->lineSegments.push_back(Edge{context->lastVertexIndex, newVertexIndex});
 
         // Update glyph data
-        pThis->lastVertex = newVertex;
-        pThis->lastVertexIndex = newVertexIndex;
+        context->lastVertex = newVertex;
+        context->lastVertexIndex = newVertexIndex;
 
         return 0;
     };
 
     this->_conicToFunc = [](const FT_Vector *control, const FT_Vector *to, void *user) {
-        Tessellator *pThis = reinterpret_cast<Tessellator *>(user);
+        Context *context = reinterpret_cast<Context *>(user);
 
         glm::vec2 controlPoint{static_cast<float>(control->x), static_cast<float>(control->y)};
-        uint32_t controlPointIndex = pThis->_getVertexIndex(controlPoint);
-        if (controlPointIndex == pThis->vertexIndex) {
-            pThis->_currentGlyph.mesh.addVertex(controlPoint);
-            pThis->vertexIndex++;
+        uint32_t controlPointIndex = context->getVertexIndex(controlPoint);
+        if (controlPointIndex == context->vertexIndex) {
+            context->vertices.push_back(controlPoint);
+            context->vertexIndex++;
         }
 
         glm::vec2 endPoint{static_cast<float>(to->x), static_cast<float>(to->y)};
-        uint32_t endPointIndex = pThis->_getVertexIndex(endPoint);
-        if (endPointIndex == pThis->vertexIndex) {
-            pThis->_currentGlyph.mesh.addVertex(endPoint);
-            pThis->vertexIndex++;
+        uint32_t endPointIndex = context->getVertexIndex(endPoint);
+        if (endPointIndex == context->vertexIndex) {
+            context->vertices.push_back(endPoint);
+            context->vertexIndex++;
         }
 
         // Add quadratic bezier curve segment
-        pThis->_currentGlyph.addCurveSegment(Curve{pThis->lastVertexIndex, controlPointIndex, endPointIndex});
+        context->curveSegments.push_back(Curve{context->lastVertexIndex, controlPointIndex, endPointIndex});
 
         // Update glyph data
-        pThis->lastVertex = endPoint;
-        pThis->lastVertexIndex = endPointIndex;
+        context->lastVertex = endPoint;
+        context->lastVertexIndex = endPointIndex;
 
         return 0;
     };
@@ -89,21 +89,17 @@ Tessellator::Tessellator() {
  *
  * @param glyphId Id of glyph to compose
  * @param font Font of glyph
+ * @param context State of this composition passed to freetype outline decompose functions
+ *
+ * @return Glyph metrics, vertices and segments are stored in context
  */
-Glyph Tessellator::_composeGlyph(uint32_t glyphId, std::shared_ptr<Font> font) {
-    // Get glyph from .ttf file
-    if (FT_Load_Glyph(font->getFace(), glyphId, FT_LOAD_NO_SCALE)) {
+Glyph Tessellator::_composeGlyph(uint32_t glyphId, std::shared_ptr<Font> font, Context &context) const {
+    // Get glyph from .ttf file, use face of current thread because loading a glyph changes the glyph slot
+    FT_Face face = font->getThreadFace();
+    if (FT_Load_Glyph(face, glyphId, FT_LOAD_NO_SCALE)) {
         throw std::runtime_error("Tessellator::_composeGlyph(): Error loading glyph");
     }
-    FT_GlyphSlot slot = font->getFace()->glyph;
-
-    // Initialize member variables
-    this->vertexIndex = 0;
-    this->lastVertex = glm::vec2{0, 0};
-    this->lastVertexIndex = 0;
-    this->contourStartVertexIndex = 0;
-    this->contourCount = 0;
-    this->_currentGlyph = Glyph{};
+    FT_GlyphSlot slot = face->glyph;
 
     // Decompose outlines to vertices and vertex indices
     FT_Outline_Funcs outlineFunctions{.move_to = this->_moveToFunc,
@@ -112,38 +108,205 @@ Glyph Tessellator::_composeGlyph(uint32_t glyphId, std::shared_ptr<Font> font) {
                                       .cubic_to = this->_cubicToFunc,
                                       .shift = 0,
                                       .delta = 0};
-    FT_Outline_Decompose(&(slot->outline), &outlineFunctions, this);
+    FT_Outline_Decompose(&(slot->outline), &outlineFunctions, &context);
 
     // Set composed glyph metrics
-    this->_currentGlyph.setWidth(slot->metrics.width);
-    this->_currentGlyph.setHeight(slot->metrics.height);
-    this->_currentGlyph.setBearingX(slot->metrics.horiBearingX);
-    this->_currentGlyph.setBearingY(slot->metrics.horiBearingY);
-    this->_currentGlyph.setAdvanceX(slot->advance.x);
-    this->_currentGlyph.setAdvanceY(slot->advance.y);
-
-    return this->_currentGlyph;
+    context.glyph.setWidth(slot->metrics.width);
+    context.glyph.setHeight(slot->metrics.height);
+    context.glyph.setBearingX(slot->metrics.horiBearingX);
+    context.glyph.setBearingY(slot->metrics.horiBearingY);
+    context.glyph.setAdvanceX(slot->advance.x);
+    context.glyph.setAdvanceY(slot->advance.y);
+
+    return context.glyph;
 }
 
 /**
- * @brief Get index of given vertex from vertices of currently composed glyph
+ * @brief Compose several glyphs in parallel on given thread pool
+ *
+ * Must not be called from a task of the same thread pool, the calling thread waits until all glyphs are composed
+ *
+ * @param requests Glyphs to compose
+ * @param threadPool Thread pool on which glyphs are composed
+ *
+ * @return Composed glyphs in the order of requests
+ *
+ * @throws First exception thrown while composing glyphs
+ */
+std::vector<Glyph> Tessellator::composeGlyphs(std::span<const GlyphRequest> requests, ThreadPool &threadPool) const {
+    std::vector<Glyph> glyphs(requests.size());
+    if (requests.empty()) {
+        return glyphs;
+    }
+
+    // Split requests into a few chunks per worker, so that a thread does not compose a long run of complex glyphs alone
+    std::size_t chunkCount = std::min<std::size_t>(requests.size(), threadPool.getThreadCount() * 4);
+    std::size_t chunkSize = (requests.size() + chunkCount - 1) / chunkCount;
+    chunkCount = (requests.size() + chunkSize - 1) / chunkSize;
+
+    std::latch chunksFinished{static_cast<std::ptrdiff_t>(chunkCount)};
+    std::exception_ptr error{nullptr};
+    std::mutex errorMutex;
+
+    for (std::size_t start = 0; start < requests.size(); start += chunkSize) {
+        std::size_t end = std::min(start + chunkSize, requests.size());
+
+        threadPool.submit([this, requests, &glyphs, &chunksFinished, &error, &errorMutex, start, end]() {
+            try {
+                for (std::size_t i = start; i < end; i++) {
+                    glyphs[i] = this->composeGlyph(requests[i].glyphId, requests[i].font, requests[i].fontSize);
+                }
+            } catch (...) {
+                std::lock_guard lock{errorMutex};
+                if (error == nullptr) {
+                    error = std::current_exception();
+                }
+            }
+
+            chunksFinished.count_down();
+        });
+    }
+
+    chunksFinished.wait();
+
+    if (error != nullptr) {
+        std::rethrow_exception(error);
+    }
+
+    return glyphs;
+}
+
+/**
+ * @brief Get index of given vertex from vertices of currently composed glyph. Vertices closer than one font unit are
+ * welded, the vertex with the lowest index is used if there are more of them
  *
  * @param vertex Given vertex
  *
- * @return Index of given vertex
+ * @return Index of given vertex, vertexIndex if vertex is not in vertices of glyph
  */
-uint32_t Tessellator::_getVertexIndex(const glm::vec2 &vertex) {
-    uint32_t i = 0;
+uint32_t Tessellator::Context::getVertexIndex(const glm::vec2 &vertex) {
+    auto getCellKey = [](int64_t x, int64_t y) {
+        return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) | static_cast<uint32_t>(y);
+    };
+
+    // Add vertices pushed since the last call into grid
+    for (uint32_t i = this->vertexGridNext.size(); i < this->vertices.size(); i++) {
+        uint64_t key = getCellKey(static_cast<int64_t>(std::floor(this->vertices[i].x)),
+                                  static_cast<int64_t>(std::floor(this->vertices[i].y)));
+
+        auto it = this->vertexGrid.find(key);
+        this->vertexGridNext.push_back(it == this->vertexGrid.end() ? UINT32_MAX : it->second);
+        this->vertexGrid[key] = i;
+    }
+
+    // Vertices within the weld tolerance of one font unit lie in the cell of vertex or in one of its neighbours
+    int64_t cellX = static_cast<int64_t>(std::floor(vertex.x));
+    int64_t cellY = static_cast<int64_t>(std::floor(vertex.y));
+    uint32_t vertexIndex = UINT32_MAX;
 
-    for (const glm::vec2 &glyphVertex : this->_currentGlyph.mesh.getVertices()) {
-        if (glm::distance(vertex, glyphVertex) <= 1.f) {
-            return i;
+    for (int64_t x = cellX - 1; x <= cellX + 1; x++) {
+        for (int64_t y = cellY - 1; y <= cellY + 1; y++) {
+            auto it = this->vertexGrid.find(getCellKey(x, y));
+            if (it == this->vertexGrid.end()) {
+                continue;
+            }
+
+            for (uint32_t i = it->second; i != UINT32_MAX; i = this->vertexGridNext[i]) {
+                if (i < vertexIndex && glm::distance(vertex, this->vertices[i]) <= 1.f) {
+                    vertexIndex = i;
+                }
+            }
         }
+    }
+
+    return vertexIndex == UINT32_MAX ? this->vertexIndex : vertexIndex;
+}
+
+/**
+ * @brief Get identifier of tessellator settings that change composed glyphs. Glyphs of different variants are not
+ * interchangeable, so persistent caches store the variant together with the strategy
+ *
+ * @return Variant of composed glyphs, 0 for tessellators without such settings
+ */
+uint32_t Tessellator::getVariant() const {
+    return 0;
+}
+
+/**
+ * @brief Enable or disable collecting statistics of composed glyphs
+ *
+ * @param enabled True to collect statistics
+ */
+void Tessellator::setStatsEnabled(bool enabled) {
+    this->_stats->enabled = enabled;
+}
+
+/**
+ * @brief Get statistics of glyphs composed since the last reset
+ *
+ * @return Snapshot of statistics
+ */
+Tessellator::Stats Tessellator::getStats() const {
+    return Stats{this->getStrategy(), this->_stats->composeTime.getSnapshot(), this->_stats->vertexCount.getSnapshot(),
+                 this->_stats->indexCount.getSnapshot(), this->_stats->segmentCount.getSnapshot(),
+                 this->_stats->skippedUnionCount.load()};
+}
+
+/**
+ * @brief Reset all statistics
+ */
+void Tessellator::resetStats() {
+    this->_stats->composeTime.reset();
+    this->_stats->vertexCount.reset();
+    this->_stats->indexCount.reset();
+    this->_stats->segmentCount.reset();
+    this->_stats->skippedUnionCount = 0;
+}
 
-        i++;
+/**
+ * @brief Make given tessellator record its statistics together with this tessellator
+ *
+ * @param tessellator Copy of this tessellator
+ */
+void Tessellator::_shareStats(Tessellator &tessellator) const {
+    tessellator._stats = this->_stats;
+}
+
+/**
+ * @brief Record time spent composing glyph and size of composed glyph if statistics are enabled
+ *
+ * @param start Time when composing of glyph started
+ * @param glyph Composed glyph
+ * @param segmentCount Number of line and curve segments of composed glyph
+ */
+void Tessellator::_recordStats(std::chrono::steady_clock::time_point start,
+                               const Glyph &glyph,
+                               std::size_t segmentCount) const {
+    if (!this->_stats->enabled) {
+        return;
     }
 
-    return this->vertexIndex;
+    std::chrono::microseconds duration =
+        std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+
+    uint64_t indexCount = 0;
+    for (unsigned int i = 0; i < glyph.mesh.getDrawCount(); i++) {
+        indexCount += glyph.mesh.getIndexCount(i);
+    }
+
+    this->_stats->composeTime.record(duration.count());
+    this->_stats->vertexCount.record(glyph.mesh.getVertexCount());
+    this->_stats->indexCount.record(indexCount);
+    this->_stats->segmentCount.record(segmentCount);
+}
+
+/**
+ * @brief Count glyph whose contours did not overlap, so they were triangulated without computing their union
+ */
+void Tessellator::_recordSkippedUnion() const {
+    if (this->_stats->enabled) {
+        this->_stats->skippedUnionCount++;
+    }
 }
 
 }  // namespace vft
@@ -65,4 +65,308 @@ void TextRenderer::setCache(std::shared_ptr<GlyphCache> cache) {
     this->_cache = cache;
 }
 
+/**
+ * @brief Enable or disable collecting statistics of glyph cache and tessellator
+ *
+ * @param enabled True to collect statistics
+ */
+void TextRenderer::setStatsEnabled(bool enabled) {
+    this->_cache->setStatsEnabled(enabled);
+    this->_tessellator->setStatsEnabled(enabled);
+}
+
+/**
+ * @brief Get statistics of glyph cache used by renderer
+ *
+ * @return Snapshot of glyph cache statistics
+ */
+GlyphCache::Stats TextRenderer::getCacheStats() const {
+    return this->_cache->getStats();
+}
+
+/**
+ * @brief Get statistics of glyphs composed by renderer's tessellator
+ *
+ * @return Snapshot of tessellator statistics
+ */
+Tessellator::Stats TextRenderer::getTessellatorStats() const {
+    return this->_tessellator->getStats();
+}
+
+/**
+ * @brief Reset statistics of glyph cache and tessellator
+ */
+void TextRenderer::resetStats() {
+    this->_cache->resetStats();
+    this->_tessellator->resetStats();
+}
+
+/**
+ * @brief Enable or disable asynchronous composition of glyphs missing in the glyph cache
+ *
+ * @param enabled True to compose glyphs on worker threads once the synchronous composition budget is spent
+ * @param threadCount Number of worker threads, 0 uses the number of hardware threads
+ */
+void TextRenderer::setAsyncComposition(bool enabled, unsigned int threadCount) {
+    // Destroying the pool discards queued glyphs and waits for glyphs that are being composed
+    this->_threadPool.reset();
+
+    {
+        std::lock_guard lock{this->_asyncState->mutex};
+        this->_asyncState->queued.clear();
+    }
+
+    if (enabled) {
+        this->_threadPool = std::make_unique<ThreadPool>(threadCount);
+    }
+}
+
+/**
+ * @brief Set time each update can spend composing glyphs synchronously when asynchronous composition is enabled
+ *
+ * @param budget Synchronous composition budget, zero composes all missing glyphs asynchronously
+ */
+void TextRenderer::setSyncCompositionBudget(std::chrono::microseconds budget) {
+    this->_syncCompositionBudget = budget;
+}
+
+/**
+ * @brief Set callback called by worker thread after a glyph is composed asynchronously. The callback should only
+ * schedule a call to updateComposedGlyphs() on the rendering thread
+ *
+ * @param callback Callback function
+ */
+void TextRenderer::setOnGlyphsComposed(std::function<void()> callback) {
+    std::lock_guard lock{this->_asyncState->mutex};
+    this->_asyncState->onGlyphsComposed = callback;
+}
+
+/**
+ * @brief Update renderer if glyphs were composed asynchronously since the last call, so placeholders are replaced by
+ * composed glyphs. Must be called from the rendering thread
+ *
+ * @return True if renderer was updated
+ */
+bool TextRenderer::updateComposedGlyphs() {
+    if (!this->_asyncState->composed.exchange(false)) {
+        return false;
+    }
+
+    this->update();
+    return true;
+}
+
+/**
+ * @brief Compose glyphs of font in parallel and store them in glyph cache, so they are not composed during update.
+ * Should be called at load time, e.g. behind a loading screen
+ *
+ * @param font Font of glyphs
+ * @param fontSizes Font sizes in which glyphs will be rendered
+ * @param glyphIds Glyph indices in font
+ * @param threadCount Number of worker threads, 0 uses the number of hardware threads
+ * @param onProgress Called after each glyph with the number of processed glyphs and total number of glyphs, calls are
+ * serialized but can come from any worker thread
+ *
+ * @return Number of glyphs stored in glyph cache
+ */
+unsigned int TextRenderer::prewarm(std::shared_ptr<Font> font,
+                                   std::vector<unsigned int> fontSizes,
+                                   std::vector<uint32_t> glyphIds,
+                                   unsigned int threadCount,
+                                   std::function<void(unsigned int, unsigned int)> onProgress) {
+    if (font == nullptr) {
+        throw std::invalid_argument("TextRenderer::prewarm(): Font must not be nullptr");
+    }
+
+    // Keys depend on renderer, e.g. font size independent renderers store one glyph for all font sizes
+    std::vector<GlyphKey> keys;
+    for (unsigned int fontSize : fontSizes) {
+        for (uint32_t glyphId : glyphIds) {
+            keys.push_back(this->_getGlyphKey(Character{glyphId, 0, font, fontSize}));
+        }
+    }
+
+    return this->_cache->prewarm(font, keys, *this->_tessellator, threadCount, onProgress);
+}
+
+/**
+ * @brief Compose glyphs of unicode code points in selected ranges and store them in glyph cache
+ *
+ * @param font Font of glyphs
+ * @param fontSizes Font sizes in which glyphs will be rendered
+ * @param characterRanges Ranges of unicode code points
+ * @param threadCount Number of worker threads, 0 uses the number of hardware threads
+ * @param onProgress Called after each glyph with the number of processed glyphs and total number of glyphs
+ *
+ * @return Number of glyphs stored in glyph cache
+ */
+unsigned int TextRenderer::prewarm(std::shared_ptr<Font> font,
+                                   std::vector<unsigned int> fontSizes,
+                                   std::vector<FontAtlas::CharacterRange> characterRanges,
+                                   unsigned int threadCount,
+                                   std::function<void(unsigned int, unsigned int)> onProgress) {
+    if (font == nullptr) {
+        throw std::invalid_argument("TextRenderer::prewarm(): Font must not be nullptr");
+    }
+
+    std::vector<uint32_t> glyphIds;
+    FT_Face face = font->getThreadFace();
+
+    for (const FontAtlas::CharacterRange &range : characterRanges) {
+        for (char32_t codePoint = range.start; codePoint <= range.end; codePoint++) {
+            glyphIds.push_back(FT_Get_Char_Index(face, codePoint));
+        }
+    }
+
+    return this->prewarm(font, fontSizes, glyphIds, threadCount, onProgress);
+}
+
+/**
+ * @brief Compose glyphs of utf-32 encoded characters and store them in glyph cache
+ *
+ * @param font Font of glyphs
+ * @param fontSizes Font sizes in which glyphs will be rendered
+ * @param characters Utf-32 encoded characters
+ * @param threadCount Number of worker threads, 0 uses the number of hardware threads
+ * @param onProgress Called after each glyph with the number of processed glyphs and total number of glyphs
+ *
+ * @return Number of glyphs stored in glyph cache
+ */
+unsigned int TextRenderer::prewarm(std::shared_ptr<Font> font,
+                                   std::vector<unsigned int> fontSizes,
+                                   std::u32string characters,
+                                   unsigned int threadCount,
+                                   std::function<void(unsigned int, unsigned int)> onProgress) {
+    if (font == nullptr) {
+        throw std::invalid_argument("TextRenderer::prewarm(): Font must not be nullptr");
+    }
+
+    std::vector<uint32_t> glyphIds;
+    FT_Face face = font->getThreadFace();
+
+    for (char32_t character : characters) {
+        glyphIds.push_back(FT_Get_Char_Index(face, character));
+    }
+
+    return this->prewarm(font, fontSizes, glyphIds, threadCount, onProgress);
+}
+
+/**
+ * @brief Get key of character's glyph in glyph cache. Glyphs are stored in font units and do not depend on font size
+ * by default
+ *
+ * @param character Character
+ *
+ * @return Key of glyph in cache
+ */
+GlyphKey TextRenderer::_getGlyphKey(const Character &character) const {
+    return GlyphKey{character.getFont()->getFontFamily(), character.getGlyphId(), 0};
+}
+
+/**
+ * @brief Get glyph of character from cache, compose it using the tessellator if it is missing. The glyph is composed
+ * for the font size stored in key, which can differ from the font size of character.
+ *
+ * With asynchronous composition enabled and synchronous composition budget spent, or glyph being composed by another
+ * thread, missing glyph is queued for composition and an empty placeholder glyph is returned
+ *
+ * @param key Key of glyph in cache
+ * @param character Character whose glyph is requested
+ *
+ * @return Glyph of character
+ */
+std::shared_ptr<const Glyph> TextRenderer::_getGlyph(const GlyphKey &key, const Character &character) {
+    // Hashing font content is only needed to look glyph up on disk
+    std::optional<GlyphDiskCache::Key> diskKey = std::nullopt;
+    if (this->_cache->getDiskCache() != nullptr) {
+        diskKey = GlyphDiskCache::Key{character.getFont()->getContentHash(), key.glyphId, key.fontSize,
+                                      this->_tessellator->getStrategy(), this->_tessellator->getVariant()};
+    }
+
+    auto compose = [&]() {
+        return this->_tessellator->composeGlyph(character.getGlyphId(), character.getFont(), key.fontSize);
+    };
+
+    if (this->_threadPool == nullptr) {
+        return this->_cache->getOrComposeGlyph(key, compose, diskKey);
+    }
+
+    std::shared_ptr<const Glyph> glyph = this->_cache->findGlyph(key);
+    if (glyph != nullptr) {
+        return glyph;
+    }
+
+    // Glyph composed by a worker is not waited for, that could block for the whole composition
+    bool pending = this->_cache->isPending(key);
+    if (!pending && this->_syncCompositionTime < this->_syncCompositionBudget) {
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        glyph = this->_cache->getOrComposeGlyph(key, compose, diskKey);
+        this->_syncCompositionTime +=
+            std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+
+        return glyph;
+    }
+
+    this->_composeGlyphAsync(key, character, diskKey);
+
+    static const std::shared_ptr<const Glyph> placeholder = std::make_shared<const Glyph>();
+    return placeholder;
+}
+
+/**
+ * @brief Queue glyph for composition on a worker thread unless it is already queued
+ *
+ * @param key Key of glyph in cache
+ * @param character Character whose glyph is composed
+ * @param diskKey Key of glyph in disk cache, std::nullopt if glyph cache has no disk cache
+ */
+void TextRenderer::_composeGlyphAsync(const GlyphKey &key,
+                                      const Character &character,
+                                      const std::optional<GlyphDiskCache::Key> &diskKey) {
+    {
+        std::lock_guard lock{this->_asyncState->mutex};
+        if (!this->_asyncState->queued.insert(key).second) {
+            return;
+        }
+    }
+
+    // Task owns everything it uses, so it does not depend on the renderer or character
+    std::shared_ptr<GlyphCache> cache = this->_cache;
+    std::shared_ptr<const Tessellator> tessellator = this->_tessellator;
+    std::shared_ptr<Font> font = character.getFont();
+    uint32_t glyphId = character.getGlyphId();
+    std::shared_ptr<AsyncCompositionState> state = this->_asyncState;
+
+    this->_threadPool->submit([cache, tessellator, font, glyphId, key, diskKey, state]() {
+        bool composed = true;
+        try {
+            cache->getOrComposeGlyph(
+                key, [&]() { return tessellator->composeGlyph(glyphId, font, key.fontSize); }, diskKey);
+        } catch (...) {
+            composed = false;
+        }
+
+        std::function<void()> callback;
+        {
+            std::lock_guard lock{state->mutex};
+            state->queued.erase(key);
+            callback = state->onGlyphsComposed;
+        }
+
+        if (composed) {
+            state->composed = true;
+            if (callback) {
+                callback();
+            }
+        }
+    });
+}
+
+/**
+ * @brief Reset time spent composing glyphs synchronously, called at the start of update
+ */
+void TextRenderer::_resetCompositionBudget() {
+    this->_syncCompositionTime = std::chrono::microseconds{0};
+}
+
 }  // namespace vft
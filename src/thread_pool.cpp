@@ -0,0 +1,116 @@
+/**
+ * @file thread_pool.cpp
+ * @author Christian Saloň
+ */
+
+#include "thread_pool.h"
+
+namespace vft {
+
+/**
+ * @brief ThreadPool constructor, starts worker threads
+ *
+ * @param threadCount Number of worker threads, 0 uses the number of hardware threads
+ */
+ThreadPool::ThreadPool(unsigned int threadCount) {
+    if (threadCount == 0) {
+        threadCount = std::max(std::thread::hardware_concurrency(), 1u);
+    }
+
+    for (unsigned int i = 0; i < threadCount; i++) {
+        this->_threads.emplace_back(&ThreadPool::_work, this);
+    }
+}
+
+/**
+ * @brief ThreadPool destructor, discards tasks that were not started and waits for running tasks
+ */
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard lock{this->_mutex};
+        this->_stopping = true;
+        this->_tasks = {};
+    }
+
+    this->_taskAvailable.notify_all();
+    for (std::thread &thread : this->_threads) {
+        thread.join();
+    }
+}
+
+/**
+ * @brief Add task to the queue. Exceptions thrown by tasks are ignored, tasks must report errors themselves
+ *
+ * @param task Task to execute on a worker thread
+ */
+void ThreadPool::submit(std::function<void()> task) {
+    {
+        std::lock_guard lock{this->_mutex};
+        this->_tasks.push(std::move(task));
+    }
+
+    this->_taskAvailable.notify_one();
+}
+
+/**
+ * @brief Block until all submitted tasks are executed
+ */
+void ThreadPool::wait() {
+    std::unique_lock lock{this->_mutex};
+    this->_tasksFinished.wait(lock, [this]() { return this->_tasks.empty() && this->_activeTaskCount == 0; });
+}
+
+/**
+ * @brief Get number of worker threads
+ *
+ * @return Thread count
+ */
+unsigned int ThreadPool::getThreadCount() const {
+    return this->_threads.size();
+}
+
+/**
+ * @brief Get number of tasks that are queued or being executed
+ *
+ * @return Task count
+ */
+unsigned int ThreadPool::getPendingTaskCount() const {
+    std::lock_guard lock{this->_mutex};
+    return this->_tasks.size() + this->_activeTaskCount;
+}
+
+/**
+ * @brief Main loop of worker thread, executes tasks until the pool stops
+ */
+void ThreadPool::_work() {
+    while (true) {
+        std::function<void()> task;
+
+        {
+            std::unique_lock lock{this->_mutex};
+            this->_taskAvailable.wait(lock, [this]() { return this->_stopping || !this->_tasks.empty(); });
+            if (this->_stopping) {
+                return;
+            }
+
+            task = std::move(this->_tasks.front());
+            this->_tasks.pop();
+            this->_activeTaskCount++;
+        }
+
+        try {
+            task();
+        } catch (...) {
+        }
+
+        {
+            std::lock_guard lock{this->_mutex};
+            this->_activeTaskCount--;
+            if (this->_tasks.empty() && this->_activeTaskCount == 0) {
+                this->_tasksFinished.notify_all();
+            }
+        }
+    }
+}
+
+}  // namespace vft
@@ -3,8 +3,6 @@
  * @author Christian Saloň
  */
 
-#include "CDT.h"
-
 #include "triangulation_tessellator.h"
 
 namespace vft {
@@ -14,251 +12,343 @@ namespace vft {
  */
 TriangulationTessellator::TriangulationTessellator() {
     this->_moveToFunc = [](const FT_Vector *to, void *user) {
-        TriangulationTessellator *pThis = reinterpret_cast<TriangulationTessellator *>(user);
-
-        // Assign orientation of contour to second polygon
-        pThis->_secondPolygon[0].orientation = pThis->area >= 0 ? Outline::Orientation::CCW : Outline::Orientation::CW;
-
-        if (pThis->contourCount >= 2) {
-            // Perform union of contours
-            PolygonOperator polygonOperator{};
-            polygonOperator.join(pThis->_currentGlyph.mesh.getVertices(), pThis->_firstPolygon, pThis->_secondPolygon);
-            pThis->_currentGlyph.mesh.setVertices(polygonOperator.getVertices());
-            pThis->_firstPolygon = polygonOperator.getPolygon();
-            pThis->_secondPolygon = {Outline{}};
-
-            pThis->vertexIndex = pThis->_currentGlyph.mesh.getVertexCount();
-        } else if (pThis->contourCount == 1) {
-            pThis->_firstPolygon = pThis->_secondPolygon;
-            pThis->_secondPolygon = {Outline{}};
-        }
+        Context *context = static_cast<Context *>(reinterpret_cast<Tessellator::Context *>(user));
+
+        // Start new contour, all contours are joined at once when the glyph is composed
+        context->outline.push_back(std::vector<Segment>{});
 
         // Process contour starting vertex
         glm::vec2 vertex{static_cast<float>(to->x), static_cast<float>(to->y)};
-        uint32_t vertexIndex = pThis->_getVertexIndex(vertex);
-        if (vertexIndex == pThis->vertexIndex) {
-            pThis->_currentGlyph.mesh.addVertex(vertex);
-            pThis->vertexIndex++;
+        uint32_t vertexIndex = context->getVertexIndex(vertex);
+        if (vertexIndex == context->vertexIndex) {
+            context->vertices.push_back(vertex);
+            context->vertexIndex++;
         }
 
         // Update glyph data
-        pThis->contourStartVertexIndex = vertexIndex;
-        pThis->lastVertex = vertex;
-        pThis->lastVertexIndex = vertexIndex;
-        pThis->contourCount++;
-        pThis->area = 0;
+        context->contourStartVertexIndex = vertexIndex;
+        context->lastVertex = vertex;
+        context->lastVertexIndex = vertexIndex;
+        context->contourCount++;
 
         return 0;
     };
 
     this->_lineToFunc = [](const FT_Vector *to, void *user) {
-        TriangulationTessellator *pThis = reinterpret_cast<TriangulationTessellator *>(user);
+        Context *context = static_cast<Context *>(reinterpret_cast<Tessellator::Context *>(user));
 
         // Process line end vertex
         glm::vec2 endVertex{static_cast<float>(to->x), static_cast<float>(to->y)};
-        uint32_t endVertexIndex = pThis->_getVertexIndex(endVertex);
-        if (endVertexIndex == pThis->vertexIndex) {
-            pThis->_currentGlyph.mesh.addVertex(endVertex);
-            pThis->vertexIndex++;
+        uint32_t endVertexIndex = context->getVertexIndex(endVertex);
+        if (endVertexIndex == context->vertexIndex) {
+            context->vertices.push_back(endVertex);
+            context->vertexIndex++;
         }
 
-        Edge edge{pThis->lastVertexIndex, endVertexIndex};
+        Edge edge{context->lastVertexIndex, endVertexIndex};
         if (edge.first != edge.second) {
             // Create line segment
-            pThis->_currentGlyph.addLineSegment(edge);
-            // Add edge to polygon
-            pThis->_secondPolygon[0].edges.insertLast(edge);
-            // Update signed area of polygon
-            pThis->area += pThis->lastVertex.x * endVertex.y - endVertex.x * pThis->lastVertex.y;
+            context->lineSegments.push_back(edge);
+            // Add line to contour
+            context->outline.back().push_back(Segment{Curve{edge.first, edge.first, edge.second}, false});
         }
 
         // Update glyph data
-        pThis->lastVertex = endVertex;
-        pThis->lastVertexIndex = endVertexIndex;
+        context->lastVertex = endVertex;
+        context->lastVertexIndex = endVertexIndex;
 
         return 0;
     };
 
     this->_conicToFunc = [](const FT_Vector *control, const FT_Vector *to, void *user) {
-        TriangulationTessellator *pThis = reinterpret_cast<TriangulationTessellator *>(user);
-
-        glm::vec2 startPoint = pThis->lastVertex;
+        Context *context = static_cast<Context *>(reinterpret_cast<Tessellator::Context *>(user));
 
         // Process curve control vertex
         glm::vec2 controlPoint{static_cast<float>(control->x), static_cast<float>(control->y)};
-        uint32_t controlPointVertexIndex = pThis->_getVertexIndex(controlPoint);
-        if (controlPointVertexIndex == pThis->vertexIndex) {
-            pThis->_currentGlyph.mesh.addVertex(controlPoint);
-            pThis->vertexIndex++;
+        uint32_t controlPointVertexIndex = context->getVertexIndex(controlPoint);
+        if (controlPointVertexIndex == context->vertexIndex) {
+            context->vertices.push_back(controlPoint);
+            context->vertexIndex++;
         }
 
         // Process curve end vertex
         glm::vec2 endPoint{static_cast<float>(to->x), static_cast<float>(to->y)};
-        uint32_t endPointVertexIndex = pThis->_getVertexIndex(endPoint);
-        if (endPointVertexIndex == pThis->vertexIndex) {
-            pThis->_currentGlyph.mesh.addVertex(endPoint);
-            pThis->vertexIndex++;
+        uint32_t endPointVertexIndex = context->getVertexIndex(endPoint);
+        if (endPointVertexIndex == context->vertexIndex) {
+            context->vertices.push_back(endPoint);
+            context->vertexIndex++;
         }
 
-        // Create curve segment
-        pThis->_currentGlyph.addCurveSegment(
-            Curve{pThis->lastVertexIndex, controlPointVertexIndex, endPointVertexIndex});
-
-        // Adaptive subdivision of quadratic bezier curve
-        std::array<glm::vec2, 3> curve{pThis->_font->getScalingVector(pThis->_fontSize) * startPoint,
-                                       pThis->_font->getScalingVector(pThis->_fontSize) * controlPoint,
-                                       pThis->_font->getScalingVector(pThis->_fontSize) * endPoint};
-        std::set<float> newVertices = pThis->_subdivideQuadraticBezier(curve);
-
-        glm::vec2 lastVertex = pThis->lastVertex;
-        uint32_t lastVertexIndex = pThis->lastVertexIndex;
-        for (float t : newVertices) {
-            if (t == 0) {
-                continue;
-            }
-
-            glm::vec2 newVertex{(1 - t) * (1 - t) * startPoint + 2 * (1 - t) * t * controlPoint + (t * t) * endPoint};
-            uint32_t newVertexIndex = pThis->_getVertexIndex(newVertex);
-            if (newVertexIndex == pThis->vertexIndex) {
-                pThis->_currentGlyph.mesh.addVertex(newVertex);
-                pThis->vertexIndex++;
-            }
-
-            Edge edge{lastVertexIndex, newVertexIndex};
-            if (edge.first != edge.second) {
-                // Add edge to polygon
-                pThis->_secondPolygon[0].edges.insertLast(edge);
-                // Update signed area of contour
-                pThis->area += lastVertex.x * newVertex.y - newVertex.x * lastVertex.y;
-            }
-
-            lastVertex = newVertex;
-            lastVertexIndex = newVertexIndex;
-        }
+        // Create curve segment, it is flattened separately for every level of detail
+        Curve curve{context->lastVertexIndex, controlPointVertexIndex, endPointVertexIndex};
+        context->curveSegments.push_back(curve);
+        context->outline.back().push_back(Segment{curve, true});
 
         // Update glyph data
-        pThis->lastVertex = endPoint;
-        pThis->lastVertexIndex = endPointVertexIndex;
+        context->lastVertex = endPoint;
+        context->lastVertexIndex = endPointVertexIndex;
 
         return 0;
     };
 }
 
 /**
- * @brief Composes a glyph ready for rendering
+ * @brief Composes a glyph ready for rendering. The outline is decomposed once and its curves are flattened with the
+ * tolerance of NOMINAL_LEVEL_OF_DETAIL. With levels of detail enabled, the glyph's mesh contains LEVEL_OF_DETAIL_COUNT
+ * triangulations of the outline flattened with increasing tolerance, all of them stored in one vertex buffer
  *
  * @param glyphId Id of glyph to compose
  * @param font Font of glyph
  * @param fontSize Font size of glyph
  */
-Glyph TriangulationTessellator::composeGlyph(uint32_t glyphId, std::shared_ptr<vft::Font> font, unsigned int fontSize) {
-    this->_font = font;
-    this->_fontSize = fontSize;
+Glyph TriangulationTessellator::composeGlyph(uint32_t glyphId,
+                                             std::shared_ptr<vft::Font> font,
+                                             unsigned int fontSize) const {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
 
-    // Initialize polygons
-    this->_firstPolygon = {Outline{}};
-    this->_secondPolygon = {Outline{}};
+    Context context{};
+    context.tessellator = this;
+    context.font = font;
+    context.fontSize = fontSize;
 
-    GlyphKey key{font->getFontFamily(), glyphId, fontSize};
-    Glyph glyph = this->_composeGlyph(glyphId, font);
+    Glyph glyph = this->_composeGlyph(glyphId, font, context);
+
+    bool useLevelsOfDetail = this->_useLevelsOfDetail;
+    unsigned int levelCount = useLevelsOfDetail ? TriangulationTessellator::LEVEL_OF_DETAIL_COUNT : 1;
 
     std::vector<glm::vec2> vertices;
-    std::vector<Edge> edges;
-    std::vector<uint32_t> triangles;
-
-    if (this->contourCount >= 1) {
-        // Assign orientation of contour to second polygon
-        this->_secondPolygon[0].orientation = this->area >= 0 ? Outline::Orientation::CCW : Outline::Orientation::CW;
-
-        // Perform union of contours
-        PolygonOperator polygonOperator{};
-        polygonOperator.join(this->_currentGlyph.mesh.getVertices(), this->_firstPolygon, this->_secondPolygon);
-        vertices = polygonOperator.getVertices();
-        std::vector<Outline> polygon = polygonOperator.getPolygon();
-
-        // Create edges for triangulation
-        for (Outline &outline : polygon) {
-            for (unsigned int i = 0; i < outline.edges.size(); i++) {
-                uint32_t startVertexIndex = outline.edges.getAt(i)->value.first;
-                uint32_t endVertexIndex = outline.edges.getAt(i)->value.second;
-
-                edges.push_back(Edge{startVertexIndex, endVertexIndex});
+    std::vector<std::vector<uint32_t>> triangles(TriangulationTessellator::GLYPH_MESH_TRIANGLE_BUFFER_INDEX +
+                                                 levelCount);
+
+    // Vertices of all levels in vertex buffer (key: bits of vertex coordinates, value: vertex index), vertices shared
+    // by levels, e.g. the ends of segments, are stored once
+    std::unordered_map<uint64_t, uint32_t> vertexIndices;
+    std::vector<unsigned int> previousCurveSegmentCounts;
+    bool isUnionSkipped = false;
+
+    for (unsigned int i = 0; i < levelCount; i++) {
+        unsigned int level = useLevelsOfDetail ? i : TriangulationTessellator::NOMINAL_LEVEL_OF_DETAIL;
+        unsigned int triangleBufferIndex = TriangulationTessellator::GLYPH_MESH_TRIANGLE_BUFFER_INDEX + i;
+
+        // Flatten curves of decomposed outline
+        Context levelContext = context;
+        std::vector<unsigned int> curveSegmentCounts = TriangulationTessellator::_flattenOutline(
+            levelContext, TriangulationTessellator::getLevelOfDetailTolerance(level));
+
+        // Outline is the same as in the previous level if all curves are split into the same number of segments, the
+        // level's index buffer is left empty
+        if (i == 0 || curveSegmentCounts != previousCurveSegmentCounts) {
+            previousCurveSegmentCounts = std::move(curveSegmentCounts);
+
+            if (levelContext.contourCount >= 1) {
+                // Perform union of all contours
+                PolygonOperator polygonOperator{};
+                polygonOperator.unite(levelContext.vertices, levelContext.contours);
+                isUnionSkipped = !polygonOperator.hasOverlappingContours();
+                std::vector<glm::vec2> levelVertices = polygonOperator.getVertices();
+                std::vector<Outline> polygon = polygonOperator.getPolygon();
+
+                // Triangulation, indices are mapped to vertices stored by all levels
+                triangles[triangleBufferIndex] = GlyphCompositor::triangulate(levelVertices, polygon);
+
+                std::vector<uint32_t> levelVertexIndices(levelVertices.size());
+                for (std::size_t j = 0; j < levelVertices.size(); j++) {
+                    uint64_t key = (static_cast<uint64_t>(std::bit_cast<uint32_t>(levelVertices[j].x)) << 32) |
+                                   std::bit_cast<uint32_t>(levelVertices[j].y);
+                    auto [it, isInserted] = vertexIndices.try_emplace(key, static_cast<uint32_t>(vertices.size()));
+                    if (isInserted) {
+                        vertices.push_back(levelVertices[j]);
+                    }
+                    levelVertexIndices[j] = it->second;
+                }
+                for (uint32_t &index : triangles[triangleBufferIndex]) {
+                    index = levelVertexIndices[index];
+                }
             }
         }
 
-        // Remove duplicate vertices
-        CDT::DuplicatesInfo info = CDT::RemoveDuplicatesAndRemapEdges<float>(
-            vertices, [](const glm::vec2 &p) { return p.x; }, [](const glm::vec2 &p) { return p.y; }, edges.begin(),
-            edges.end(), [](const Edge &e) { return e.first; }, [](const Edge &e) { return e.second; },
-            [](uint32_t i1, uint32_t i2) -> Edge {
-                return Edge{i1, i2};
-            });
-
-        // Triangulation
-        triangles = GlyphCompositor::triangulate(vertices, edges);
+        // Statistics describe the nominal level of detail
+        if (level == TriangulationTessellator::NOMINAL_LEVEL_OF_DETAIL && isUnionSkipped) {
+            this->_recordSkippedUnion();
+        }
     }
 
-    GlyphMesh mesh{vertices, {triangles}};
-    glyph.mesh = mesh;
+    glyph.mesh = GlyphMesh{vertices, triangles};
 
-    // Cleanup
-    this->_firstPolygon.clear();
-    this->_secondPolygon.clear();
+    this->_recordStats(start, glyph, context.lineSegments.size() + context.curveSegments.size());
 
     return glyph;
 }
 
 /**
- * @brief Computes vertices of a quadratic bezier curve with adaptive level of detail
+ * @brief Get algorithm used by this tessellator
  *
- * @param curve Bezier curve start, control and end points
+ * @return Tessellation strategy
  */
-std::set<float> TriangulationTessellator::_subdivideQuadraticBezier(const std::array<glm::vec2, 3> curve) {
-    std::set<float> newVertices{0.f, 1.f};
-    this->_subdivide(curve, 0.5f, 0.5f, newVertices);
+TessellationStrategy TriangulationTessellator::getStrategy() const {
+    return TessellationStrategy::TRIANGULATION;
+}
 
-    return newVertices;
+/**
+ * @brief Get variant of composed glyphs, glyphs with and without levels of detail are stored separately on disk
+ *
+ * @return LEVELS_OF_DETAIL_VARIANT if levels of detail are enabled, else 0
+ */
+uint32_t TriangulationTessellator::getVariant() const {
+    return this->_useLevelsOfDetail ? TriangulationTessellator::LEVELS_OF_DETAIL_VARIANT : 0;
+}
+
+/**
+ * @brief Create a new tessellator of the same type, which records statistics together with this tessellator
+ *
+ * @return New tessellator
+ */
+std::unique_ptr<Tessellator> TriangulationTessellator::clone() const {
+    std::unique_ptr<TriangulationTessellator> tessellator = std::make_unique<TriangulationTessellator>();
+    tessellator->setLevelsOfDetailEnabled(this->_useLevelsOfDetail);
+    this->_shareStats(*tessellator);
+
+    return tessellator;
+}
+
+/**
+ * @brief Enable or disable composing glyphs with levels of detail. Levels of detail multiply the cost of triangulation
+ * and the size of meshes of glyphs with curves, so they should be enabled only when text is viewed at varying scales.
+ * Glyphs composed before the change keep their levels of detail. Glyphs in disk caches and glyph packs are stored with
+ * the variant returned by getVariant(), so glyphs composed with other settings are not loaded
+ *
+ * @param enabled True to compose LEVEL_OF_DETAIL_COUNT levels of detail, false to compose only NOMINAL_LEVEL_OF_DETAIL
+ */
+void TriangulationTessellator::setLevelsOfDetailEnabled(bool enabled) {
+    this->_useLevelsOfDetail = enabled;
+}
+
+/**
+ * @brief Check whether glyphs are composed with levels of detail
+ *
+ * @return True if glyphs are composed with levels of detail
+ */
+bool TriangulationTessellator::isLevelsOfDetailEnabled() const {
+    return this->_useLevelsOfDetail;
+}
+
+/**
+ * @brief Get flattening tolerance of one level of detail, the tolerance grows LEVEL_OF_DETAIL_TOLERANCE_RATIO times
+ * with every level and equals FLATTENING_TOLERANCE at NOMINAL_LEVEL_OF_DETAIL
+ *
+ * @param levelOfDetail Level of detail, 0 is the most detailed
+ *
+ * @return Max distance in pixels between curves and line segments approximating them
+ */
+double TriangulationTessellator::getLevelOfDetailTolerance(unsigned int levelOfDetail) {
+    int exponent = static_cast<int>(levelOfDetail) - TriangulationTessellator::NOMINAL_LEVEL_OF_DETAIL;
+    return TriangulationTessellator::FLATTENING_TOLERANCE *
+           std::pow(TriangulationTessellator::LEVEL_OF_DETAIL_TOLERANCE_RATIO, exponent);
+}
+
+/**
+ * @brief Flatten curves of decomposed outline into line segments and store the flattened contours in context
+ *
+ * @param context Context containing decomposed outline, points of curves are added to its vertices
+ * @param tolerance Max distance in pixels between curves and line segments approximating them
+ *
+ * @return Number of line segments approximating each curve in the order of curves in outline
+ */
+std::vector<unsigned int> TriangulationTessellator::_flattenOutline(Context &context, double tolerance) {
+    std::vector<unsigned int> curveSegmentCounts;
+    glm::vec2 scale = context.font->getScalingVector(context.fontSize);
+
+    context.contours.clear();
+    for (const std::vector<Segment> &contour : context.outline) {
+        context.contours.push_back(Outline{});
+
+        for (const Segment &segment : contour) {
+            if (!segment.isCurve) {
+                // Add edge to polygon
+                context.contours.back().edges.push_back(Edge{segment.curve.start, segment.curve.end});
+                continue;
+            }
+
+            // Flatten quadratic bezier curve, number of line segments is given by the curve's size in pixels and
+            // tolerance
+            std::array<glm::vec2, 3> curve{context.vertices[segment.curve.start],
+                                           context.vertices[segment.curve.control],
+                                           context.vertices[segment.curve.end]};
+            TriangulationTessellator::_flattenQuadraticBezier({scale * curve[0], scale * curve[1], scale * curve[2]},
+                                                              tolerance, context.curveParameters);
+            TriangulationTessellator::_evaluateQuadraticBezier(curve, context.curveParameters, context.curvePoints);
+            curveSegmentCounts.push_back(context.curveParameters.size());
+
+            uint32_t lastVertexIndex = segment.curve.start;
+            for (const glm::vec2 &newVertex : context.curvePoints) {
+                uint32_t newVertexIndex = context.getVertexIndex(newVertex);
+                if (newVertexIndex == context.vertexIndex) {
+                    context.vertices.push_back(newVertex);
+                    context.vertexIndex++;
+                }
+
+                Edge edge{lastVertexIndex, newVertexIndex};
+                if (edge.first != edge.second) {
+                    // Add edge to polygon
+                    context.contours.back().edges.push_back(edge);
+                }
+
+                lastVertexIndex = newVertexIndex;
+            }
+        }
+    }
+
+    return curveSegmentCounts;
+}
+
+/**
+ * @brief Compute parameters of points dividing a quadratic bezier curve into line segments whose distance from the
+ * curve is at most tolerance. The number of segments is given in closed form by Wang's formula, the distance
+ * of a segment spanning parameter interval dt is bounded by dt^2 / 4 * |start - 2 * control + end|
+ *
+ * @param curve Bezier curve start, control and end points in pixels
+ * @param tolerance Max distance in pixels between the curve and line segments
+ * @param parameters Parameters of points dividing the curve in increasing order, the last one is 1
+ */
+void TriangulationTessellator::_flattenQuadraticBezier(const std::array<glm::vec2, 3> &curve,
+                                                       double tolerance,
+                                                       std::vector<float> &parameters) {
+    parameters.clear();
+
+    double secondDifference = glm::length(glm::dvec2{curve[0]} - 2.0 * glm::dvec2{curve[1]} + glm::dvec2{curve[2]});
+    double exactCount = std::ceil(std::sqrt(secondDifference / (4 * tolerance)));
+    unsigned int segmentCount = static_cast<unsigned int>(
+        std::clamp(exactCount, 1.0, static_cast<double>(TriangulationTessellator::MAX_CURVE_SEGMENT_COUNT)));
+
+    parameters.resize(segmentCount);
+    for (unsigned int i = 0; i < segmentCount; i++) {
+        parameters[i] = static_cast<float>(i + 1) / segmentCount;
+    }
 }
 
 /**
- * @brief Subdivides a quadratic bezier curve until there is no loss of quality
+ * @brief Evaluate points of a quadratic bezier curve for a batch of parameters. The curve is evaluated in its
+ * polynomial form in one loop over flat buffers, which the compiler vectorizes
  *
  * @param curve Bezier curve start, control and end points
- * @param t Parameter for the position on the bezier curve (t = <0, 1>)
- * @param delta Indicates distance between current point and computed points in the previous step
- * @param newVertices T parameters created by dividing bezier curve into line segments
+ * @param parameters Parameters of evaluated points
+ * @param points Buffer of evaluated points, it is resized to the number of parameters
  */
-void TriangulationTessellator::_subdivide(const std::array<glm::vec2, 3> curve,
-                                          float t,
-                                          float delta,
-                                          std::set<float> &newVertices) {
-    // Get bezier curve points
-    glm::vec2 startPoint = curve.at(0);
-    glm::vec2 controlPoint = curve.at(1);
-    glm::vec2 endPoint = curve.at(2);
-
-    // Add current point
-    glm::vec2 newVertex{(1 - t) * (1 - t) * startPoint + 2 * (1 - t) * t * controlPoint + (t * t) * endPoint};
-    newVertices.insert(t);
-
-    // Compute points around the current point with the given delta
-    glm::vec2 left{(1 - (t - delta)) * (1 - (t - delta)) * startPoint +
-                   2 * (1 - (t - delta)) * (t - delta) * controlPoint + (t - delta) * (t - delta) * endPoint};
-    glm::vec2 right{(1 - (t + delta)) * (1 - (t + delta)) * startPoint +
-                    2 * (1 - (t + delta)) * (t + delta) * controlPoint + (t + delta) * (t + delta) * endPoint};
-
-    // Check if distance between curve(t - delta) and curve(t) is less than one pixel
-    // or if points can be connected by a line without losing quality
-    if (glm::length(newVertex - left) >= 1.f && newVertex.x != left.x && newVertex.y != left.y) {
-        // The segment curve(t - delta) and curve(t) should be subdivided
-        this->_subdivide(curve, t - delta / 2.f, delta / 2.f, newVertices);
+void TriangulationTessellator::_evaluateQuadraticBezier(const std::array<glm::vec2, 3> &curve,
+                                                        const std::vector<float> &parameters,
+                                                        std::vector<glm::vec2> &points) {
+    points.resize(parameters.size());
+
+    // B(t) = start + t * (2 * (control - start) + t * (start - 2 * control + end))
+    glm::vec2 firstDerivative = 2.f * (curve[1] - curve[0]);
+    glm::vec2 secondDerivative = curve[0] - 2.f * curve[1] + curve[2];
+    for (std::size_t i = 0; i < parameters.size(); i++) {
+        points[i] = curve[0] + parameters[i] * (firstDerivative + parameters[i] * secondDerivative);
     }
 
-    // Check if distance between curve(t) and curve(t + delta) is less than one pixel
-    // or if points can be connected by a line without losing quality
-    if (glm::length(newVertex - right) >= 1.f && newVertex.x != right.x && newVertex.y != right.y) {
-        // The segment curve(t) and curve(t + delta) should be subdivided
-        this->_subdivide(curve, t + delta / 2.f, delta / 2.f, newVertices);
+    // Last point is exactly the end point, so curves sharing it share the vertex as well
+    if (!points.empty() && parameters.back() == 1.f) {
+        points.back() = curve[2];
     }
 }
 
@@ -11,13 +11,15 @@ namespace vft {
  * @brief Initialize triangulation text renderer
  */
 TriangulationTextRenderer::TriangulationTextRenderer() {
-    this->_tessellator = std::make_unique<TriangulationTessellator>();
+    this->_tessellator = std::make_shared<TriangulationTessellator>();
 }
 
 /**
  * @brief Recreates vertex and index buffers for all characters in text block
  */
 void TriangulationTextRenderer::update() {
+    this->_resetCompositionBudget();
+
     this->_vertices.clear();
     this->_indices.clear();
     this->_offsets.clear();
@@ -27,40 +29,141 @@ void TriangulationTextRenderer::update() {
 
     for (unsigned int i = 0; i < this->_textBlocks.size(); i++) {
         for (const Character &character : this->_textBlocks[i]->getCharacters()) {
-            GlyphKey key{character.getFont()->getFontFamily(), character.getGlyphId(), character.getFontSize()};
+            GlyphKey key = this->_getGlyphKey(character);
 
             if (!this->_offsets.contains(key)) {
-                // Insert glyph into cache
-                if (!this->_cache->exists(key)) {
-                    this->_cache->setGlyph(key,
-                                           this->_tessellator->composeGlyph(character.getGlyphId(), character.getFont(),
-                                                                            character.getFontSize()));
-                }
+                // Get glyph from cache, compose it if it is missing
+                std::shared_ptr<const Glyph> glyph = this->_getGlyph(key, character);
+
+                // Insert all levels of detail into index buffer. Meshes composed without levels of detail contain
+                // only the nominal level, which is used for all levels, and an empty index buffer of a level means
+                // that it is the same as the previous level
+                bool hasLevelsOfDetail =
+                    glyph->mesh.getDrawCount() >= TriangulationTessellator::GLYPH_MESH_TRIANGLE_BUFFER_INDEX +
+                                                      TriangulationTessellator::LEVEL_OF_DETAIL_COUNT;
+                GlyphInfo info{};
+                for (unsigned int level = 0; level < TriangulationTessellator::LEVEL_OF_DETAIL_COUNT; level++) {
+                    unsigned int drawIndex =
+                        TriangulationTessellator::GLYPH_MESH_TRIANGLE_BUFFER_INDEX + (hasLevelsOfDetail ? level : 0);
+                    if (level > 0 && (!hasLevelsOfDetail || glyph->mesh.getIndexCount(drawIndex) == 0)) {
+                        info.indicesOffset[level] = info.indicesOffset[level - 1];
+                        info.indicesCount[level] = info.indicesCount[level - 1];
+                        continue;
+                    }
 
-                // Compute buffer offsets
-                const Glyph &glyph = this->_cache->getGlyph(key);
-                this->_offsets.insert(
-                    {key, GlyphInfo{indexCount, glyph.mesh.getIndexCount(
-                                                    TriangulationTessellator::GLYPH_MESH_TRIANGLE_BUFFER_INDEX)}});
-
-                // Insert glyph mesh into vertex and index buffer
-                this->_vertices.insert(this->_vertices.end(), glyph.mesh.getVertices().begin(),
-                                       glyph.mesh.getVertices().end());
-                this->_indices.insert(
-                    this->_indices.end(),
-                    glyph.mesh.getIndices(TriangulationTessellator::GLYPH_MESH_TRIANGLE_BUFFER_INDEX).begin(),
-                    glyph.mesh.getIndices(TriangulationTessellator::GLYPH_MESH_TRIANGLE_BUFFER_INDEX).end());
-
-                // Add an offset to line segment indices of current character
-                for (int j = indexCount; j < this->_indices.size(); j++) {
-                    this->_indices.at(j) += vertexCount;
+                    // Offset indices by vertices of previous glyphs
+                    info.indicesOffset[level] = indexCount;
+                    info.indicesCount[level] = glyph->mesh.getIndexCount(drawIndex);
+                    glyph->mesh.appendIndices(drawIndex, this->_indices, vertexCount);
+
+                    indexCount += info.indicesCount[level];
                 }
+                this->_offsets.insert({key, info});
 
-                vertexCount += glyph.mesh.getVertexCount();
-                indexCount += glyph.mesh.getIndexCount(TriangulationTessellator::GLYPH_MESH_TRIANGLE_BUFFER_INDEX);
+                glyph->mesh.appendVertices(this->_vertices);
+                vertexCount += glyph->mesh.getVertexCount();
             }
         }
     }
 }
 
+/**
+ * @brief Enable or disable levels of detail of glyph meshes, the level is selected for every character from its
+ * projected size. Glyphs already in the glyph cache keep their levels of detail
+ *
+ * @param enabled True to compose glyphs with levels of detail
+ */
+void TriangulationTextRenderer::setLevelsOfDetailEnabled(bool enabled) {
+    // Tessellator is always created by this renderer
+    static_cast<TriangulationTessellator &>(*this->_tessellator).setLevelsOfDetailEnabled(enabled);
+    this->_useLevelsOfDetail = enabled;
+}
+
+/**
+ * @brief Check whether levels of detail of glyph meshes are enabled
+ *
+ * @return True if levels of detail are enabled
+ */
+bool TriangulationTextRenderer::isLevelsOfDetailEnabled() const {
+    return this->_useLevelsOfDetail;
+}
+
+/**
+ * @brief Set how font sizes are grouped into buckets, glyphs are triangulated once for each bucket
+ *
+ * @param fontSizeBucketing Font size bucketing
+ */
+void TriangulationTextRenderer::setFontSizeBucketing(FontSizeBucketing fontSizeBucketing) {
+    this->_fontSizeBucketing = fontSizeBucketing;
+    this->update();
+}
+
+/**
+ * @brief Getter for font size bucketing
+ *
+ * @return Font size bucketing
+ */
+FontSizeBucketing TriangulationTextRenderer::getFontSizeBucketing() const {
+    return this->_fontSizeBucketing;
+}
+
+/**
+ * @brief Get key of character's glyph. Glyph meshes are in font units, so the mesh triangulated for the upper bound of
+ * the font size bucket is shared by all font sizes in the bucket
+ *
+ * @param character Character
+ *
+ * @return Key of glyph in cache
+ */
+GlyphKey TriangulationTextRenderer::_getGlyphKey(const Character &character) const {
+    return GlyphKey{character.getFont()->getFontFamily(), character.getGlyphId(),
+                    this->_fontSizeBucketing.getBucketFontSize(character.getFontSize())};
+}
+
+/**
+ * @brief Select level of detail of character's mesh from its projected size, so the distance between rendered line
+ * segments and curves of the outline stays within FLATTENING_TOLERANCE pixels on screen. The nominal level is used if
+ * levels of detail are disabled
+ *
+ * @param character Character
+ *
+ * @return Level of detail, 0 is the most detailed
+ */
+unsigned int TriangulationTextRenderer::_selectLevelOfDetail(const Character &character) const {
+    if (!this->_useLevelsOfDetail || this->_viewportWidth == 0 || this->_viewportHeight == 0) {
+        return TriangulationTessellator::NOMINAL_LEVEL_OF_DETAIL;
+    }
+
+    // Mesh is flattened in pixels of the bucket font size, project one such pixel from character's origin to screen
+    unsigned int bucketFontSize = this->_fontSizeBucketing.getBucketFontSize(character.getFontSize());
+    glm::vec2 scale = character.getFont()->getScalingVector(bucketFontSize);
+    glm::vec2 pixelSize{1.f / scale.x, 1.f / scale.y};
+    glm::mat4 transform = this->_ubo.projection * this->_ubo.view * character.getModelMatrix();
+
+    std::array<glm::vec4, 3> clip{transform * glm::vec4{0.f, 0.f, 0.f, 1.f},
+                                  transform * glm::vec4{pixelSize.x, 0.f, 0.f, 1.f},
+                                  transform * glm::vec4{0.f, pixelSize.y, 0.f, 1.f}};
+    if (clip[0].w <= 0 || clip[1].w <= 0 || clip[2].w <= 0) {
+        // Character is behind the camera
+        return TriangulationTessellator::LEVEL_OF_DETAIL_COUNT - 1;
+    }
+
+    glm::vec2 viewport{this->_viewportWidth, this->_viewportHeight};
+    std::array<glm::vec2, 3> screen{};
+    for (unsigned int i = 0; i < clip.size(); i++) {
+        screen[i] = glm::vec2{clip[i].x, clip[i].y} / clip[i].w * 0.5f * viewport;
+    }
+    float screenScale = std::max(glm::length(screen[1] - screen[0]), glm::length(screen[2] - screen[0]));
+
+    // Select the least detailed level whose tolerance scaled to screen pixels is within the nominal tolerance
+    unsigned int level = 0;
+    while (level + 1 < TriangulationTessellator::LEVEL_OF_DETAIL_COUNT &&
+           TriangulationTessellator::getLevelOfDetailTolerance(level + 1) * screenScale <=
+               TriangulationTessellator::FLATTENING_TOLERANCE) {
+        level++;
+    }
+
+    return level;
+}
+
 }  // namespace vft
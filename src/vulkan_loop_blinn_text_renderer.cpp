@@ -0,0 +1,268 @@
+/**
+ * @file vulkan_loop_blinn_text_renderer.cpp
+ * @author Christian Saloň
+ */
+
+#include "vulkan_loop_blinn_text_renderer.h"
+
+namespace vft {
+
+/**
+ * @brief Initialize vulkan text renderer
+ * 
+ * @param physicalDevice Vulkan physical device
+ * @param logicalDevice Vulkan logical device
+ * @param graphicsQueue Vulkan graphics queue
+ * @param commandPool Vulkan command pool
+ * @param renderPass Vulkan render pass
+ * @param msaaSampleCount Number of samples used for multisampling
+ * @param commandBuffer Vulkan command buffer
+ */
+VulkanLoopBlinnTextRenderer::VulkanLoopBlinnTextRenderer(VkPhysicalDevice physicalDevice,
+                                                         VkDevice logicalDevice,
+                                                         VkQueue graphicsQueue,
+                                                         VkCommandPool commandPool,
+                                                         VkRenderPass renderPass,
+                                                         VkSampleCountFlagBits msaaSampleCount,
+                                                         VkCommandBuffer commandBuffer)
+    : VulkanTextRenderer{physicalDevice, logicalDevice,   graphicsQueue, commandPool,
+                         renderPass,     msaaSampleCount, commandBuffer} {
+    this->_initialize();
+
+    this->_createPipeline();
+}
+
+/**
+ * @brief Deallocate memory and destroy vulkan text renderer
+ */
+VulkanLoopBlinnTextRenderer::~VulkanLoopBlinnTextRenderer() {
+    // Destroy vulkan buffers
+    if (this->_indexBuffer != nullptr)
+        this->_destroyBuffer(this->_indexBuffer, this->_indexBufferMemory);
+    if (this->_vertexBuffer != nullptr)
+        this->_destroyBuffer(this->_vertexBuffer, this->_vertexBufferMemory);
+
+    // Destroy pipeline
+    if (this->_pipeline != nullptr)
+        vkDestroyPipeline(this->_logicalDevice, this->_pipeline, nullptr);
+    if (this->_pipelineLayout != nullptr)
+        vkDestroyPipelineLayout(this->_logicalDevice, this->_pipelineLayout, nullptr);
+}
+
+/**
+ * @brief Add draw commands to the command buffer for drawing all glyphs in tracked text blocks
+ */
+void VulkanLoopBlinnTextRenderer::draw() {
+    // Check if there are characters to render
+    if (this->_vertices.size() == 0) {
+        return;
+    }
+
+    vkCmdBindPipeline(this->_commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, this->_pipeline);
+    vkCmdBindDescriptorSets(this->_commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, this->_pipelineLayout, 0, 1,
+                            &this->_uboDescriptorSet, 0, nullptr);
+
+    VkBuffer vertexBuffers[] = {this->_vertexBuffer};
+    VkDeviceSize offsets[] = {0};
+    vkCmdBindVertexBuffers(this->_commandBuffer, 0, 1, vertexBuffers, offsets);
+
+    vkCmdBindIndexBuffer(this->_commandBuffer, this->_indexBuffer, 0, VK_INDEX_TYPE_UINT32);
+    for (unsigned int i = 0; i < this->_textBlocks.size(); i++) {
+        for (const Character &character : this->_textBlocks[i]->getCharacters()) {
+            GlyphKey key = this->_getGlyphKey(character);
+            const GlyphInfo &info = this->_offsets.at(key);
+
+            // Inner and curve triangles are drawn at once
+            if (info.indicesCount > 0) {
+                vft::CharacterPushConstants pushConstants{character.getModelMatrix(), this->_textBlocks[i]->getColor()};
+                vkCmdPushConstants(this->_commandBuffer, this->_pipelineLayout, VK_SHADER_STAGE_VERTEX_BIT, 0,
+                                   sizeof(vft::CharacterPushConstants), &pushConstants);
+
+                vkCmdDrawIndexed(this->_commandBuffer, info.indicesCount, 1, info.indicesOffset, 0, 0);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Creates a new vertex and index buffer after a change in tracked text blocks
+ */
+void VulkanLoopBlinnTextRenderer::update() {
+    LoopBlinnTextRenderer::update();
+
+    // Check if there are characters to render
+    if (this->_vertices.size() == 0) {
+        return;
+    }
+
+    // Destroy vulkan buffers
+    this->_destroyBuffer(this->_indexBuffer, this->_indexBufferMemory);
+    this->_destroyBuffer(this->_vertexBuffer, this->_vertexBufferMemory);
+
+    // Create vulkan vertex buffer
+    VkDeviceSize vertexBufferSize = sizeof(this->_vertices.at(0)) * this->_vertices.size();
+    this->_stageAndCreateVulkanBuffer(this->_vertices.data(), vertexBufferSize, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
+                                      this->_vertexBuffer, this->_vertexBufferMemory);
+
+    // Create vulkan index buffer
+    VkDeviceSize indexBufferSize = sizeof(this->_indices.at(0)) * this->_indices.size();
+    this->_stageAndCreateVulkanBuffer(this->_indices.data(), indexBufferSize, VK_BUFFER_USAGE_INDEX_BUFFER_BIT,
+                                      this->_indexBuffer, this->_indexBufferMemory);
+}
+
+/**
+ * @brief Create vulkan pipeline for displaying glyph's inner and curve triangles
+ */
+void VulkanLoopBlinnTextRenderer::_createPipeline() {
+    std::vector<char> vertexShaderCode = this->_readFile("shaders/loop_blinn-vert.spv");
+    std::vector<char> fragmentShaderCode = this->_readFile("shaders/loop_blinn-frag.spv");
+
+    VkShaderModule vertexShaderModule = this->_createShaderModule(vertexShaderCode);
+    VkShaderModule fragmentShaderModule = this->_createShaderModule(fragmentShaderCode);
+
+    VkPipelineShaderStageCreateInfo vertexShaderStageCreateInfo{};
+    vertexShaderStageCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+    vertexShaderStageCreateInfo.stage = VK_SHADER_STAGE_VERTEX_BIT;
+    vertexShaderStageCreateInfo.module = vertexShaderModule;
+    vertexShaderStageCreateInfo.pName = "main";
+
+    VkPipelineShaderStageCreateInfo fragmentShaderStageCreateInfo{};
+    fragmentShaderStageCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+    fragmentShaderStageCreateInfo.stage = VK_SHADER_STAGE_FRAGMENT_BIT;
+    fragmentShaderStageCreateInfo.module = fragmentShaderModule;
+    fragmentShaderStageCreateInfo.pName = "main";
+
+    VkPipelineShaderStageCreateInfo shaderStages[] = {vertexShaderStageCreateInfo, fragmentShaderStageCreateInfo};
+
+    std::vector<VkDynamicState> dynamicStates = {VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR};
+
+    VkPipelineDynamicStateCreateInfo dynamicStateCreateInfo{};
+    dynamicStateCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
+    dynamicStateCreateInfo.dynamicStateCount = static_cast<uint32_t>(dynamicStates.size());
+    dynamicStateCreateInfo.pDynamicStates = dynamicStates.data();
+
+    std::array<VkVertexInputAttributeDescription, 3> vertexInputAttributeDescriptions{};
+
+    vertexInputAttributeDescriptions[0].binding = 0;
+    vertexInputAttributeDescriptions[0].location = 0;
+    vertexInputAttributeDescriptions[0].format = VK_FORMAT_R32G32_SFLOAT;
+    vertexInputAttributeDescriptions[0].offset = offsetof(LoopBlinnTextRenderer::Vertex, position);
+
+    vertexInputAttributeDescriptions[1].binding = 0;
+    vertexInputAttributeDescriptions[1].location = 1;
+    vertexInputAttributeDescriptions[1].format = VK_FORMAT_R32G32_SFLOAT;
+    vertexInputAttributeDescriptions[1].offset = offsetof(LoopBlinnTextRenderer::Vertex, uv);
+
+    vertexInputAttributeDescriptions[2].binding = 0;
+    vertexInputAttributeDescriptions[2].location = 2;
+    vertexInputAttributeDescriptions[2].format = VK_FORMAT_R32_SFLOAT;
+    vertexInputAttributeDescriptions[2].offset = offsetof(LoopBlinnTextRenderer::Vertex, orientation);
+
+    VkVertexInputBindingDescription vertexInputBindingDescription{};
+    vertexInputBindingDescription.binding = 0;
+    vertexInputBindingDescription.stride = sizeof(LoopBlinnTextRenderer::Vertex);
+    vertexInputBindingDescription.inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
+
+    VkPipelineVertexInputStateCreateInfo vertexInputStateCreateInfo{};
+    vertexInputStateCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
+    vertexInputStateCreateInfo.vertexBindingDescriptionCount = 1;
+    vertexInputStateCreateInfo.pVertexBindingDescriptions = &vertexInputBindingDescription;
+    vertexInputStateCreateInfo.vertexAttributeDescriptionCount = vertexInputAttributeDescriptions.size();
+    vertexInputStateCreateInfo.pVertexAttributeDescriptions = vertexInputAttributeDescriptions.data();
+
+    VkPipelineInputAssemblyStateCreateInfo inputAssemblyStateCreateInfo{};
+    inputAssemblyStateCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
+    inputAssemblyStateCreateInfo.topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+    inputAssemblyStateCreateInfo.primitiveRestartEnable = VK_FALSE;
+
+    VkPipelineViewportStateCreateInfo viewportStateCreateInfo{};
+    viewportStateCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
+    viewportStateCreateInfo.viewportCount = 1;
+    viewportStateCreateInfo.scissorCount = 1;
+
+    VkPipelineRasterizationStateCreateInfo rasterizationStateCreateInfo{};
+    rasterizationStateCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
+    rasterizationStateCreateInfo.depthClampEnable = VK_FALSE;
+    rasterizationStateCreateInfo.rasterizerDiscardEnable = VK_FALSE;
+    rasterizationStateCreateInfo.polygonMode = VK_POLYGON_MODE_FILL;
+    rasterizationStateCreateInfo.lineWidth = 1.0f;
+    rasterizationStateCreateInfo.cullMode = VK_CULL_MODE_NONE;
+    rasterizationStateCreateInfo.frontFace = VK_FRONT_FACE_CLOCKWISE;
+    rasterizationStateCreateInfo.depthBiasEnable = VK_FALSE;
+
+    VkPipelineMultisampleStateCreateInfo multisampleStateCreateInfo{};
+    multisampleStateCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO;
+    multisampleStateCreateInfo.sampleShadingEnable = VK_FALSE;
+    multisampleStateCreateInfo.rasterizationSamples = this->_msaaSampleCount;
+
+    VkPipelineColorBlendAttachmentState colorBlendAttachmentState{};
+    colorBlendAttachmentState.colorWriteMask =
+        VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
+    colorBlendAttachmentState.blendEnable = VK_TRUE;
+    colorBlendAttachmentState.srcColorBlendFactor = VK_BLEND_FACTOR_SRC_ALPHA;
+    colorBlendAttachmentState.dstColorBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
+    colorBlendAttachmentState.colorBlendOp = VK_BLEND_OP_ADD;
+    colorBlendAttachmentState.srcAlphaBlendFactor = VK_BLEND_FACTOR_ONE;
+    colorBlendAttachmentState.dstAlphaBlendFactor = VK_BLEND_FACTOR_ZERO;
+    colorBlendAttachmentState.alphaBlendOp = VK_BLEND_OP_ADD;
+
+    VkPipelineColorBlendStateCreateInfo colorBlendStateCreateInfo{};
+    colorBlendStateCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
+    colorBlendStateCreateInfo.logicOpEnable = VK_FALSE;
+    colorBlendStateCreateInfo.attachmentCount = 1;
+    colorBlendStateCreateInfo.pAttachments = &colorBlendAttachmentState;
+
+    VkPipelineDepthStencilStateCreateInfo depthStencilCreateInfo{};
+    depthStencilCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO;
+    depthStencilCreateInfo.depthTestEnable = VK_TRUE;
+    depthStencilCreateInfo.depthWriteEnable = VK_TRUE;
+    depthStencilCreateInfo.depthCompareOp = VK_COMPARE_OP_LESS;
+    depthStencilCreateInfo.depthBoundsTestEnable = VK_FALSE;
+    depthStencilCreateInfo.stencilTestEnable = VK_FALSE;
+
+    VkPushConstantRange pushConstantRange{};
+    pushConstantRange.size = sizeof(vft::CharacterPushConstants);
+    pushConstantRange.offset = 0;
+    pushConstantRange.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
+
+    VkPipelineLayoutCreateInfo pipelineLayoutCreateInfo{};
+    pipelineLayoutCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+    pipelineLayoutCreateInfo.setLayoutCount = 1;
+    pipelineLayoutCreateInfo.pSetLayouts = &this->_uboDescriptorSetLayout;
+    pipelineLayoutCreateInfo.pPushConstantRanges = &pushConstantRange;
+    pipelineLayoutCreateInfo.pushConstantRangeCount = 1;
+
+    if (vkCreatePipelineLayout(this->_logicalDevice, &pipelineLayoutCreateInfo, nullptr, &this->_pipelineLayout) !=
+        VK_SUCCESS) {
+        throw std::runtime_error(
+            "VulkanLoopBlinnTextRenderer::_createPipeline(): Error creating vulkan pipeline layout");
+    }
+
+    VkGraphicsPipelineCreateInfo graphicsPipelineCreateInfo{};
+    graphicsPipelineCreateInfo.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+    graphicsPipelineCreateInfo.stageCount = 2;
+    graphicsPipelineCreateInfo.pStages = shaderStages;
+    graphicsPipelineCreateInfo.pVertexInputState = &vertexInputStateCreateInfo;
+    graphicsPipelineCreateInfo.pInputAssemblyState = &inputAssemblyStateCreateInfo;
+    graphicsPipelineCreateInfo.pViewportState = &viewportStateCreateInfo;
+    graphicsPipelineCreateInfo.pRasterizationState = &rasterizationStateCreateInfo;
+    graphicsPipelineCreateInfo.pMultisampleState = &multisampleStateCreateInfo;
+    graphicsPipelineCreateInfo.pDepthStencilState = nullptr;
+    graphicsPipelineCreateInfo.pColorBlendState = &colorBlendStateCreateInfo;
+    graphicsPipelineCreateInfo.pDynamicState = &dynamicStateCreateInfo;
+    graphicsPipelineCreateInfo.pDepthStencilState = &depthStencilCreateInfo;
+    graphicsPipelineCreateInfo.layout = this->_pipelineLayout;
+    graphicsPipelineCreateInfo.renderPass = this->_renderPass;
+    graphicsPipelineCreateInfo.subpass = 0;
+
+    if (vkCreateGraphicsPipelines(this->_logicalDevice, nullptr, 1, &graphicsPipelineCreateInfo, nullptr,
+                                  &this->_pipeline) != VK_SUCCESS) {
+        throw std::runtime_error(
+            "VulkanLoopBlinnTextRenderer::_createPipeline(): Error creating vulkan graphics pipeline");
+    }
+
+    vkDestroyShaderModule(this->_logicalDevice, vertexShaderModule, nullptr);
+    vkDestroyShaderModule(this->_logicalDevice, fragmentShaderModule, nullptr);
+}
+
+}  // namespace vft
@@ -89,6 +89,8 @@ VulkanSdfTextRenderer::~VulkanSdfTextRenderer() {
     // Destroy pipeline
     if (this->_pipeline != nullptr)
         vkDestroyPipeline(this->_logicalDevice, this->_pipeline, nullptr);
+    if (this->_msdfPipeline != nullptr)
+        vkDestroyPipeline(this->_logicalDevice, this->_msdfPipeline, nullptr);
     if (this->_pipelineLayout != nullptr)
         vkDestroyPipelineLayout(this->_logicalDevice, this->_pipelineLayout, nullptr);
 }
@@ -103,6 +105,7 @@ void VulkanSdfTextRenderer::draw() {
     }
 
     vkCmdBindPipeline(this->_commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, this->_pipeline);
+    FontAtlas::Type lastType = FontAtlas::Type::SDF;
 
     VkBuffer vertexBuffers[] = {this->_vertexBuffer};
     VkDeviceSize offsets[] = {0};
@@ -114,14 +117,22 @@ void VulkanSdfTextRenderer::draw() {
     // Draw bounding boxes
     for (unsigned int i = 0; i < this->_textBlocks.size(); i++) {
         for (const Character &character : this->_textBlocks[i]->getCharacters()) {
-            GlyphKey key{character.getFont()->getFontFamily(), character.getGlyphId(), 0};
+            GlyphKey key = this->_getGlyphKey(character);
 
             if (this->_offsets.at(key).boundingBoxCount > 0) {
                 if (character.getFont()->getFontFamily() != lastFontFamily) {
+                    const FontTexture &texture = this->_fontTextures.at(character.getFont()->getFontFamily());
+
+                    // Bind pipeline if type of distance field should change, both pipelines share the layout
+                    if (texture.type != lastType) {
+                        VkPipeline pipeline =
+                            texture.type == FontAtlas::Type::MSDF ? this->_msdfPipeline : this->_pipeline;
+                        vkCmdBindPipeline(this->_commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
+                        lastType = texture.type;
+                    }
+
                     // Bind descriptor sets if font texture should change
-                    std::array<VkDescriptorSet, 2> sets = {
-                        this->_uboDescriptorSet,
-                        this->_fontTextures.at(character.getFont()->getFontFamily()).descriptorSet};
+                    std::array<VkDescriptorSet, 2> sets = {this->_uboDescriptorSet, texture.descriptorSet};
                     vkCmdBindDescriptorSets(this->_commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
                                             this->_pipelineLayout, 0, sets.size(), sets.data(), 0, nullptr);
 
@@ -148,6 +159,9 @@ void VulkanSdfTextRenderer::draw() {
 void VulkanSdfTextRenderer::update() {
     SdfTextRenderer::update();
 
+    // Upload glyphs added to font atlases during update
+    this->_updateFontTextures();
+
     // Destroy vulkan buffers
     this->_destroyBuffer(this->_boundingBoxIndexBuffer, this->_boundingBoxIndexBufferMemory);
     this->_destroyBuffer(this->_vertexBuffer, this->_vertexBufferMemory);
@@ -170,15 +184,42 @@ void VulkanSdfTextRenderer::update() {
 }
 
 /**
- * @brief Add font atlas and create the required vulkan objects used to render text using sdf textures
+ * @brief Add font atlas and create the required vulkan objects used to render text using sdf textures. Font texture
+ * of the replaced font atlas of the same font family is recreated from the new atlas
  *
  * @param atlas New font atlas
  */
 void VulkanSdfTextRenderer::addFontAtlas(const FontAtlas &atlas) {
     SdfTextRenderer::addFontAtlas(atlas);
 
+    this->_createFontTexture(this->_fontAtlases.at(atlas.getFontFamily()));
+}
+
+/**
+ * @brief Create font textures of font atlases created on demand and upload glyphs added to font atlases since the last
+ * update
+ */
+void VulkanSdfTextRenderer::_updateFontTextures() {
+    for (auto &[fontFamily, atlas] : this->_fontAtlases) {
+        if (!this->_fontTextures.contains(fontFamily)) {
+            this->_createFontTexture(atlas);
+        } else if (atlas.getSize() != this->_fontTextures.at(fontFamily).size || !atlas.getPendingUploads().empty()) {
+            this->_updateFontTexture(this->_fontTextures.at(fontFamily), atlas);
+        }
+    }
+}
+
+/**
+ * @brief Create vulkan objects of font atlas and upload its texture, the cpu copy of texture is released afterwards.
+ * Existing font texture of the same font family is destroyed and its descriptor set is pointed to the new texture
+ *
+ * @param atlas Font atlas whose texture is created
+ */
+void VulkanSdfTextRenderer::_createFontTexture(FontAtlas &atlas) {
+    VkFormat format = VulkanSdfTextRenderer::_getFontAtlasFormat(atlas.getType());
+
     // Create staging buffer
-    VkDeviceSize size = atlas.getSize().x * atlas.getSize().y;
+    VkDeviceSize size = atlas.getSize().x * atlas.getSize().y * atlas.getChannelCount();
     VkBuffer stagingBuffer;
     VkDeviceMemory stagingBufferMemory;
     this->_createBuffer(size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
@@ -192,24 +233,194 @@ void VulkanSdfTextRenderer::addFontAtlas(const FontAtlas &atlas) {
     vkUnmapMemory(this->_logicalDevice, stagingBufferMemory);
 
     // Create vulkan image of font atlas
+    VkImage image;
+    VkDeviceMemory imageMemory;
+    this->_createFontImage(atlas.getSize(), format, image, imageMemory);
+
+    this->_transitionImageLayout(image, format, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+    this->_copyBufferToImage(stagingBuffer, image, atlas.getSize().x, atlas.getSize().y);
+    this->_transitionImageLayout(image, format, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                                 VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+
+    // Create vulkan image view
+    VkImageView imageView = this->_createFontImageView(image, format);
+
+    // Create vulkan sampler
+    VkSamplerCreateInfo samplerCreateInfo{};
+    samplerCreateInfo.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+    samplerCreateInfo.magFilter = VK_FILTER_LINEAR;
+    samplerCreateInfo.minFilter = VK_FILTER_LINEAR;
+    samplerCreateInfo.addressModeU = VK_SAMPLER_ADDRESS_MODE_REPEAT;
+    samplerCreateInfo.addressModeV = VK_SAMPLER_ADDRESS_MODE_REPEAT;
+    samplerCreateInfo.addressModeW = VK_SAMPLER_ADDRESS_MODE_REPEAT;
+    samplerCreateInfo.anisotropyEnable = false;
+    samplerCreateInfo.borderColor = VK_BORDER_COLOR_INT_OPAQUE_BLACK;
+    samplerCreateInfo.unnormalizedCoordinates = false;
+    samplerCreateInfo.compareEnable = false;
+    samplerCreateInfo.mipmapMode = VK_SAMPLER_MIPMAP_MODE_LINEAR;
+
+    VkSampler sampler;
+    if (vkCreateSampler(this->_logicalDevice, &samplerCreateInfo, nullptr, &sampler) != VK_SUCCESS) {
+        throw std::runtime_error(
+            "VulkanSdfTextRenderer::_createFontTexture(): Could not create vulkan sampler for font atlas");
+    }
+
+    auto it = this->_fontTextures.find(atlas.getFontFamily());
+    if (it != this->_fontTextures.end()) {
+        // Old font texture may be used by command buffers in flight
+        vkDeviceWaitIdle(this->_logicalDevice);
+
+        FontTexture &texture = it->second;
+        vkDestroySampler(this->_logicalDevice, texture.sampler, nullptr);
+        vkDestroyImageView(this->_logicalDevice, texture.imageView, nullptr);
+        vkDestroyImage(this->_logicalDevice, texture.image, nullptr);
+        vkFreeMemory(this->_logicalDevice, texture.memory, nullptr);
+
+        // Descriptor sets are not freed to the descriptor pool, so the existing one is reused
+        this->_writeFontAtlasDescriptorSet(texture.descriptorSet, imageView, sampler);
+        texture.image = image;
+        texture.memory = imageMemory;
+        texture.imageView = imageView;
+        texture.sampler = sampler;
+        texture.type = atlas.getType();
+        texture.size = atlas.getSize();
+    } else {
+        // Create descriptor set used when rendering with given font atlas
+        VkDescriptorSet descriptorSet = this->_createFontAtlasDescriptorSet(imageView, sampler);
+
+        FontTexture texture{image, imageMemory, imageView, sampler, descriptorSet, atlas.getType(), atlas.getSize()};
+        this->_fontTextures.insert({atlas.getFontFamily(), texture});
+    }
+
+    // Destroy and deallocate memory from the staging buffer
+    vkDestroyBuffer(this->_logicalDevice, stagingBuffer, nullptr);
+    vkFreeMemory(this->_logicalDevice, stagingBufferMemory, nullptr);
+
+    // Texture is resident on the gpu, glyphs added later are uploaded as sub-regions
+    atlas.releaseTexture();
+    atlas.clearPendingUploads();
+}
+
+/**
+ * @brief Upload glyphs added to font atlas since the last update. If the atlas grew, a larger vulkan image is created
+ * and the contents of the old image are copied into it on the gpu, so the released texture is not needed
+ *
+ * @param texture Font texture of font atlas
+ * @param atlas Font atlas whose pending uploads are uploaded
+ */
+void VulkanSdfTextRenderer::_updateFontTexture(FontTexture &texture, FontAtlas &atlas) {
+    VkFormat format = VulkanSdfTextRenderer::_getFontAtlasFormat(atlas.getType());
+
+    // Font texture may be used by command buffers in flight
+    vkDeviceWaitIdle(this->_logicalDevice);
+
+    if (atlas.getSize() != texture.size) {
+        // Create larger vulkan image and copy old image to its top left corner, the rest is cleared
+        VkImage image;
+        VkDeviceMemory imageMemory;
+        this->_createFontImage(atlas.getSize(), format, image, imageMemory);
+
+        this->_transitionImageLayout(image, format, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+        this->_transitionImageLayout(texture.image, format, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                                     VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL);
+        this->_copyImage(texture.image, image, texture.size.x, texture.size.y);
+
+        // Destroy old image
+        vkDestroyImageView(this->_logicalDevice, texture.imageView, nullptr);
+        vkDestroyImage(this->_logicalDevice, texture.image, nullptr);
+        vkFreeMemory(this->_logicalDevice, texture.memory, nullptr);
+
+        texture.image = image;
+        texture.memory = imageMemory;
+        texture.imageView = this->_createFontImageView(image, format);
+        texture.size = atlas.getSize();
+
+        // Point the existing descriptor set to the new image view
+        this->_writeFontAtlasDescriptorSet(texture.descriptorSet, texture.imageView, texture.sampler);
+    } else {
+        this->_transitionImageLayout(texture.image, format, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                                     VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+    }
+
+    if (!atlas.getPendingUploads().empty()) {
+        // Pack bitmaps of all pending uploads into one staging buffer, one copy region per bitmap
+        VkDeviceSize size = 0;
+        std::vector<VkBufferImageCopy> regions{};
+        for (const FontAtlas::Upload &upload : atlas.getPendingUploads()) {
+            VkBufferImageCopy region{};
+            region.bufferOffset = size;
+            region.bufferRowLength = 0;
+            region.bufferImageHeight = 0;
+            region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+            region.imageSubresource.mipLevel = 0;
+            region.imageSubresource.baseArrayLayer = 0;
+            region.imageSubresource.layerCount = 1;
+            region.imageOffset = VkOffset3D{static_cast<int32_t>(upload.region.position.x),
+                                            static_cast<int32_t>(upload.region.position.y), 0};
+            region.imageExtent = VkExtent3D{upload.region.size.x, upload.region.size.y, 1};
+            regions.push_back(region);
+
+            // Buffer offsets of copies must be a multiple of 4
+            size += (upload.pixels.size() + 3) & ~VkDeviceSize{3};
+        }
+
+        VkBuffer stagingBuffer;
+        VkDeviceMemory stagingBufferMemory;
+        this->_createBuffer(size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+                            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, stagingBuffer,
+                            stagingBufferMemory);
+
+        void *buffer;
+        vkMapMemory(this->_logicalDevice, stagingBufferMemory, 0, size, 0, &buffer);
+        for (std::size_t i = 0; i < regions.size(); i++) {
+            const std::vector<uint8_t> &pixels = atlas.getPendingUploads()[i].pixels;
+            memcpy(static_cast<uint8_t *>(buffer) + regions[i].bufferOffset, pixels.data(), pixels.size());
+        }
+        vkUnmapMemory(this->_logicalDevice, stagingBufferMemory);
+
+        this->_copyBufferToImage(stagingBuffer, texture.image, regions);
+
+        vkDestroyBuffer(this->_logicalDevice, stagingBuffer, nullptr);
+        vkFreeMemory(this->_logicalDevice, stagingBufferMemory, nullptr);
+    }
+
+    this->_transitionImageLayout(texture.image, format, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                                 VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+
+    atlas.clearPendingUploads();
+}
+
+/**
+ * @brief Create vulkan image of font atlas that can be sampled and used as source and destination of copies
+ *
+ * @param size Size of font atlas
+ * @param format Format of font atlas
+ * @param image Created vulkan image
+ * @param imageMemory Allocated vulkan memory of image
+ */
+void VulkanSdfTextRenderer::_createFontImage(glm::uvec2 size,
+                                             VkFormat format,
+                                             VkImage &image,
+                                             VkDeviceMemory &imageMemory) {
     VkImageCreateInfo imageCreateInfo{};
     imageCreateInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
     imageCreateInfo.imageType = VK_IMAGE_TYPE_2D;
-    imageCreateInfo.extent.width = atlas.getSize().x;
-    imageCreateInfo.extent.height = atlas.getSize().y;
+    imageCreateInfo.extent.width = size.x;
+    imageCreateInfo.extent.height = size.y;
     imageCreateInfo.extent.depth = 1;
     imageCreateInfo.mipLevels = 1;
     imageCreateInfo.arrayLayers = 1;
-    imageCreateInfo.format = VK_FORMAT_R8_UNORM;
+    imageCreateInfo.format = format;
     imageCreateInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
     imageCreateInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-    imageCreateInfo.usage = VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+    imageCreateInfo.usage =
+        VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
     imageCreateInfo.samples = VK_SAMPLE_COUNT_1_BIT;
     imageCreateInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
 
-    VkImage image{};
     if (vkCreateImage(this->_logicalDevice, &imageCreateInfo, nullptr, &image) != VK_SUCCESS) {
-        throw std::runtime_error("VulkanSdfTextRenderer::addFontAtlas(): Could not create vulkan image for font atlas");
+        throw std::runtime_error(
+            "VulkanSdfTextRenderer::_createFontImage(): Could not create vulkan image for font atlas");
     }
 
     VkMemoryRequirements memoryRequirements{};
@@ -221,26 +432,28 @@ void VulkanSdfTextRenderer::addFontAtlas(const FontAtlas &atlas) {
     allocateInfo.memoryTypeIndex =
         this->_selectMemoryType(memoryRequirements.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
 
-    VkDeviceMemory imageMemory;
     if (vkAllocateMemory(this->_logicalDevice, &allocateInfo, nullptr, &imageMemory) != VK_SUCCESS) {
         throw std::runtime_error(
-            "VulkanSdfTextRenderer::addFontAtlas(): Could not allocate vulkan memory for font atlas");
+            "VulkanSdfTextRenderer::_createFontImage(): Could not allocate vulkan memory for font atlas");
     }
 
     vkBindImageMemory(this->_logicalDevice, image, imageMemory, 0);
+}
 
-    this->_transitionImageLayout(image, VK_FORMAT_R8_UNORM, VK_IMAGE_LAYOUT_UNDEFINED,
-                                 VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
-    this->_copyBufferToImage(stagingBuffer, image, atlas.getSize().x, atlas.getSize().y);
-    this->_transitionImageLayout(image, VK_FORMAT_R8_UNORM, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-                                 VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
-
-    // Create vulkan image view
+/**
+ * @brief Create vulkan image view of font atlas
+ *
+ * @param image Vulkan image of font atlas
+ * @param format Format of font atlas
+ *
+ * @return Created vulkan image view
+ */
+VkImageView VulkanSdfTextRenderer::_createFontImageView(VkImage image, VkFormat format) {
     VkImageViewCreateInfo imageViewCreateInfo{};
     imageViewCreateInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
     imageViewCreateInfo.image = image;
     imageViewCreateInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
-    imageViewCreateInfo.format = VK_FORMAT_R8_UNORM;
+    imageViewCreateInfo.format = format;
     imageViewCreateInfo.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
     imageViewCreateInfo.subresourceRange.baseMipLevel = 0;
     imageViewCreateInfo.subresourceRange.levelCount = 1;
@@ -250,38 +463,22 @@ void VulkanSdfTextRenderer::addFontAtlas(const FontAtlas &atlas) {
     VkImageView imageView;
     if (vkCreateImageView(this->_logicalDevice, &imageViewCreateInfo, nullptr, &imageView) != VK_SUCCESS) {
         throw std::runtime_error(
-            "VulkanSdfTextRenderer::addFontAtlas(): Could not create vulkan image view for font atlas");
+            "VulkanSdfTextRenderer::_createFontImageView(): Could not create vulkan image view for font atlas");
     }
 
-    // Create vulkan sampler
-    VkSamplerCreateInfo samplerCreateInfo{};
-    samplerCreateInfo.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
-    samplerCreateInfo.magFilter = VK_FILTER_LINEAR;
-    samplerCreateInfo.minFilter = VK_FILTER_LINEAR;
-    samplerCreateInfo.addressModeU = VK_SAMPLER_ADDRESS_MODE_REPEAT;
-    samplerCreateInfo.addressModeV = VK_SAMPLER_ADDRESS_MODE_REPEAT;
-    samplerCreateInfo.addressModeW = VK_SAMPLER_ADDRESS_MODE_REPEAT;
-    samplerCreateInfo.anisotropyEnable = false;
-    samplerCreateInfo.borderColor = VK_BORDER_COLOR_INT_OPAQUE_BLACK;
-    samplerCreateInfo.unnormalizedCoordinates = false;
-    samplerCreateInfo.compareEnable = false;
-    samplerCreateInfo.mipmapMode = VK_SAMPLER_MIPMAP_MODE_LINEAR;
-
-    VkSampler sampler;
-    if (vkCreateSampler(this->_logicalDevice, &samplerCreateInfo, nullptr, &sampler) != VK_SUCCESS) {
-        throw std::runtime_error(
-            "VulkanSdfTextRenderer::addFontAtlas(): Could not create vulkan sampler for font atlas");
-    }
-
-    // Create descriptor set used when rendering with given font atlas
-    VkDescriptorSet descriptorSet = this->_createFontAtlasDescriptorSet(imageView, sampler);
-
-    FontTexture texture{image, imageMemory, imageView, sampler, descriptorSet};
-    this->_fontTextures.insert({atlas.getFontFamily(), texture});
+    return imageView;
+}
 
-    // Destroy and deallocate memory from the staging buffer
-    vkDestroyBuffer(this->_logicalDevice, stagingBuffer, nullptr);
-    vkFreeMemory(this->_logicalDevice, stagingBufferMemory, nullptr);
+/**
+ * @brief Get vulkan format of font atlas texture
+ *
+ * @param type Type of distance field stored in font atlas
+ *
+ * @return Vulkan format of font atlas texture
+ */
+VkFormat VulkanSdfTextRenderer::_getFontAtlasFormat(FontAtlas::Type type) {
+    // Msdfs are stored in rgba textures, because three channel formats are rarely supported
+    return type == FontAtlas::Type::MSDF ? VK_FORMAT_R8G8B8A8_UNORM : VK_FORMAT_R8_UNORM;
 }
 
 /**
@@ -353,6 +550,21 @@ VkDescriptorSet VulkanSdfTextRenderer::_createFontAtlasDescriptorSet(VkImageView
             "VulkanSdfTextRenderer::_createFontAtlasDescriptorSet(): Error allocating vulkan descriptor sets");
     }
 
+    this->_writeFontAtlasDescriptorSet(descriptorSet, imageView, sampler);
+
+    return descriptorSet;
+}
+
+/**
+ * @brief Point vulkan descriptor set of font atlas to image view and sampler of font atlas
+ *
+ * @param descriptorSet Vulkan descriptor set of font atlas
+ * @param imageView Vulkan image view of font atlas
+ * @param sampler Vulkan sampler of font atlas
+ */
+void VulkanSdfTextRenderer::_writeFontAtlasDescriptorSet(VkDescriptorSet descriptorSet,
+                                                         VkImageView imageView,
+                                                         VkSampler sampler) {
     VkDescriptorImageInfo imageInfo{};
     imageInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
     imageInfo.imageView = imageView;
@@ -368,8 +580,6 @@ VkDescriptorSet VulkanSdfTextRenderer::_createFontAtlasDescriptorSet(VkImageView
     writeDescriptorSet.pImageInfo = &imageInfo;
 
     vkUpdateDescriptorSets(this->_logicalDevice, 1, &writeDescriptorSet, 0, nullptr);
-
-    return descriptorSet;
 }
 
 /**
@@ -415,6 +625,20 @@ void VulkanSdfTextRenderer::_transitionImageLayout(VkImage image,
 
         sourceStage = VK_PIPELINE_STAGE_TRANSFER_BIT;
         destinationStage = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+    } else if (oldLayout == VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL &&
+               newLayout == VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL) {
+        barrier.srcAccessMask = VK_ACCESS_SHADER_READ_BIT;
+        barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+
+        sourceStage = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+        destinationStage = VK_PIPELINE_STAGE_TRANSFER_BIT;
+    } else if (oldLayout == VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL &&
+               newLayout == VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL) {
+        barrier.srcAccessMask = VK_ACCESS_SHADER_READ_BIT;
+        barrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+
+        sourceStage = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+        destinationStage = VK_PIPELINE_STAGE_TRANSFER_BIT;
     } else {
         throw std::invalid_argument("VulkanSdfTextRenderer::_transitionImageLayout(): Invalid layout transition");
     }
@@ -452,14 +676,80 @@ void VulkanSdfTextRenderer::_copyBufferToImage(VkBuffer buffer, VkImage image, u
 }
 
 /**
- * @brief Create vulkan pipeline for displaying glyphs using sdfs
+ * @brief Copy rectangles from vulkan buffer to vulkan image in one command
+ *
+ * @param buffer Source vulkan buffer
+ * @param image Destination vulkan image
+ * @param regions Offsets in buffer and rectangles of image to copy
+ */
+void VulkanSdfTextRenderer::_copyBufferToImage(VkBuffer buffer,
+                                               VkImage image,
+                                               const std::vector<VkBufferImageCopy> &regions) {
+    VkCommandBuffer commandBuffer = this->_beginOneTimeCommands();
+
+    vkCmdCopyBufferToImage(commandBuffer, buffer, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, regions.size(),
+                           regions.data());
+
+    this->_endOneTimeCommands(commandBuffer);
+}
+
+/**
+ * @brief Clear destination vulkan image and copy source vulkan image to its top left corner
+ *
+ * @param source Source vulkan image in transfer source layout
+ * @param destination Destination vulkan image in transfer destination layout
+ * @param width Width of source vulkan image
+ * @param height Height of source vulkan image
+ */
+void VulkanSdfTextRenderer::_copyImage(VkImage source, VkImage destination, uint32_t width, uint32_t height) {
+    VkCommandBuffer commandBuffer = this->_beginOneTimeCommands();
+
+    VkImageSubresourceRange subresourceRange{};
+    subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    subresourceRange.baseMipLevel = 0;
+    subresourceRange.levelCount = 1;
+    subresourceRange.baseArrayLayer = 0;
+    subresourceRange.layerCount = 1;
+
+    VkClearColorValue clearColor{};
+    vkCmdClearColorImage(commandBuffer, destination, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, &clearColor, 1,
+                         &subresourceRange);
+
+    // Wait for clear before copying over it
+    VkMemoryBarrier barrier{};
+    barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 1,
+                         &barrier, 0, nullptr, 0, nullptr);
+
+    VkImageCopy region{};
+    region.srcSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    region.srcSubresource.mipLevel = 0;
+    region.srcSubresource.baseArrayLayer = 0;
+    region.srcSubresource.layerCount = 1;
+    region.srcOffset = VkOffset3D{0, 0, 0};
+    region.dstSubresource = region.srcSubresource;
+    region.dstOffset = VkOffset3D{0, 0, 0};
+    region.extent = VkExtent3D{width, height, 1};
+
+    vkCmdCopyImage(commandBuffer, source, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, destination,
+                   VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
+
+    this->_endOneTimeCommands(commandBuffer);
+}
+
+/**
+ * @brief Create vulkan pipelines for displaying glyphs using sdfs and msdfs, they differ only in the fragment shader
  */
 void VulkanSdfTextRenderer::_createPipeline() {
     std::vector<char> vertexShaderCode = this->_readFile("shaders/sdf-vert.spv");
     std::vector<char> fragmentShaderCode = this->_readFile("shaders/sdf-frag.spv");
+    std::vector<char> msdfFragmentShaderCode = this->_readFile("shaders/msdf-frag.spv");
 
     VkShaderModule vertexShaderModule = this->_createShaderModule(vertexShaderCode);
     VkShaderModule fragmentShaderModule = this->_createShaderModule(fragmentShaderCode);
+    VkShaderModule msdfFragmentShaderModule = this->_createShaderModule(msdfFragmentShaderCode);
 
     VkPipelineShaderStageCreateInfo vertexShaderStageCreateInfo{};
     vertexShaderStageCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
@@ -597,8 +887,17 @@ void VulkanSdfTextRenderer::_createPipeline() {
         throw std::runtime_error("VulkanSdfTextRenderer::_createPipeline(): Error creating vulkan graphics pipeline");
     }
 
+    // Create pipeline for msdfs
+    shaderStages[1].module = msdfFragmentShaderModule;
+    if (vkCreateGraphicsPipelines(this->_logicalDevice, nullptr, 1, &graphicsPipelineCreateInfo, nullptr,
+                                  &this->_msdfPipeline) != VK_SUCCESS) {
+        throw std::runtime_error(
+            "VulkanSdfTextRenderer::_createPipeline(): Error creating vulkan graphics pipeline for msdfs");
+    }
+
     vkDestroyShaderModule(this->_logicalDevice, vertexShaderModule, nullptr);
     vkDestroyShaderModule(this->_logicalDevice, fragmentShaderModule, nullptr);
+    vkDestroyShaderModule(this->_logicalDevice, msdfFragmentShaderModule, nullptr);
 }
 
 }  // namespace vft
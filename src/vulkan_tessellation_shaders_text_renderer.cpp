@@ -79,7 +79,7 @@ void VulkanTessellationShadersTextRenderer::draw() {
     vkCmdBindIndexBuffer(this->_commandBuffer, this->_lineSegmentsIndexBuffer, 0, VK_INDEX_TYPE_UINT32);
     for (unsigned int i = 0; i < this->_textBlocks.size(); i++) {
         for (const Character &character : this->_textBlocks[i]->getCharacters()) {
-            GlyphKey key{character.getFont()->getFontFamily(), character.getGlyphId(), 0};
+            GlyphKey key = this->_getGlyphKey(character);
 
             if (this->_offsets.at(key).lineSegmentsCount > 0) {
                 CharacterPushConstants pushConstants{character.getModelMatrix(), this->_textBlocks[i]->getColor(),
@@ -102,8 +102,7 @@ void VulkanTessellationShadersTextRenderer::draw() {
     vkCmdBindIndexBuffer(this->_commandBuffer, this->_curveSegmentsIndexBuffer, 0, VK_INDEX_TYPE_UINT32);
     for (unsigned int i = 0; i < this->_textBlocks.size(); i++) {
         for (const Character &character : this->_textBlocks[i]->getCharacters()) {
-            GlyphKey key{character.getFont()->getFontFamily(), character.getGlyphId(), 0};
-            const Glyph &glyph = this->_cache->getGlyph(key);
+            GlyphKey key = this->_getGlyphKey(character);
 
             if (this->_offsets.at(key).curveSegmentsCount > 0) {
                 CharacterPushConstants pushConstants{character.getModelMatrix(), this->_textBlocks[i]->getColor(),
@@ -65,6 +65,73 @@ void VulkanTextRendererDecorator::setCache(std::shared_ptr<GlyphCache> cache) {
     this->_renderer->setCache(cache);
 }
 
+/**
+ * @brief Delegate setStatsEnabled() to wrapped vulkan text renderer
+ */
+void VulkanTextRendererDecorator::setStatsEnabled(bool enabled) {
+    this->_renderer->setStatsEnabled(enabled);
+}
+
+/**
+ * @brief Delegate getCacheStats() to wrapped vulkan text renderer
+ */
+GlyphCache::Stats VulkanTextRendererDecorator::getCacheStats() const {
+    return this->_renderer->getCacheStats();
+}
+
+/**
+ * @brief Delegate getTessellatorStats() to wrapped vulkan text renderer
+ */
+Tessellator::Stats VulkanTextRendererDecorator::getTessellatorStats() const {
+    return this->_renderer->getTessellatorStats();
+}
+
+/**
+ * @brief Delegate resetStats() to wrapped vulkan text renderer
+ */
+void VulkanTextRendererDecorator::resetStats() {
+    this->_renderer->resetStats();
+}
+
+/**
+ * @brief Delegate setAsyncComposition() to wrapped vulkan text renderer
+ */
+void VulkanTextRendererDecorator::setAsyncComposition(bool enabled, unsigned int threadCount) {
+    this->_renderer->setAsyncComposition(enabled, threadCount);
+}
+
+/**
+ * @brief Delegate setSyncCompositionBudget() to wrapped vulkan text renderer
+ */
+void VulkanTextRendererDecorator::setSyncCompositionBudget(std::chrono::microseconds budget) {
+    this->_renderer->setSyncCompositionBudget(budget);
+}
+
+/**
+ * @brief Delegate setOnGlyphsComposed() to wrapped vulkan text renderer
+ */
+void VulkanTextRendererDecorator::setOnGlyphsComposed(std::function<void()> callback) {
+    this->_renderer->setOnGlyphsComposed(callback);
+}
+
+/**
+ * @brief Delegate updateComposedGlyphs() to wrapped vulkan text renderer
+ */
+bool VulkanTextRendererDecorator::updateComposedGlyphs() {
+    return this->_renderer->updateComposedGlyphs();
+}
+
+/**
+ * @brief Delegate prewarm() to wrapped vulkan text renderer
+ */
+unsigned int VulkanTextRendererDecorator::prewarm(std::shared_ptr<Font> font,
+                                                  std::vector<unsigned int> fontSizes,
+                                                  std::vector<uint32_t> glyphIds,
+                                                  unsigned int threadCount,
+                                                  std::function<void(unsigned int, unsigned int)> onProgress) {
+    return this->_renderer->prewarm(font, fontSizes, glyphIds, threadCount, onProgress);
+}
+
 /**
  * @brief Delegate setCommandBuffer() to wrapped vulkan text renderer
  */
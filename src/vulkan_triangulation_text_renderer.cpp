@@ -69,15 +69,17 @@ void VulkanTriangulationTextRenderer::draw() {
     vkCmdBindIndexBuffer(this->_commandBuffer, this->_indexBuffer, 0, VK_INDEX_TYPE_UINT32);
     for (int i = 0; i < this->_textBlocks.size(); i++) {
         for (const Character &character : this->_textBlocks[i]->getCharacters()) {
-            GlyphKey key{character.getFont()->getFontFamily(), character.getGlyphId(), character.getFontSize()};
+            GlyphKey key = this->_getGlyphKey(character);
+            const GlyphInfo &info = this->_offsets.at(key);
 
-            if (this->_offsets.at(key).indicesCount > 0) {
+            // Level of detail is selected every frame from the character's projected size
+            unsigned int level = this->_selectLevelOfDetail(character);
+            if (info.indicesCount[level] > 0) {
                 vft::CharacterPushConstants pushConstants{character.getModelMatrix(), this->_textBlocks[i]->getColor()};
                 vkCmdPushConstants(this->_commandBuffer, this->_pipelineLayout, VK_SHADER_STAGE_VERTEX_BIT, 0,
                                    sizeof(vft::CharacterPushConstants), &pushConstants);
 
-                vkCmdDrawIndexed(this->_commandBuffer, this->_offsets.at(key).indicesCount, 1,
-                                 this->_offsets.at(key).indicesOffset, 0, 0);
+                vkCmdDrawIndexed(this->_commandBuffer, info.indicesCount[level], 1, info.indicesOffset[level], 0, 0);
             }
         }
     }
@@ -43,6 +43,8 @@ VulkanWindingNumberTextRenderer::~VulkanWindingNumberTextRenderer() {
         this->_destroyBuffer(this->_boundingBoxIndexBuffer, this->_boundingBoxIndexBufferMemory);
     if (this->_segmentsBuffer != nullptr)
         this->_destroyBuffer(this->_segmentsBuffer, this->_segmentsBufferMemory);
+    if (this->_bandsBuffer != nullptr)
+        this->_destroyBuffer(this->_bandsBuffer, this->_bandsBufferMemory);
     if (this->_vertexBuffer != nullptr)
         this->_destroyBuffer(this->_vertexBuffer, this->_vertexBufferMemory);
 
@@ -80,15 +82,14 @@ void VulkanWindingNumberTextRenderer::draw() {
     vkCmdBindIndexBuffer(this->_commandBuffer, this->_boundingBoxIndexBuffer, 0, VK_INDEX_TYPE_UINT32);
     for (unsigned int i = 0; i < this->_textBlocks.size(); i++) {
         for (const Character &character : this->_textBlocks[i]->getCharacters()) {
-            GlyphKey key{character.getFont()->getFontFamily(), character.getGlyphId(), 0};
+            GlyphKey key = this->_getGlyphKey(character);
 
             if (this->_offsets.at(key).boundingBoxCount > 0) {
                 SegmentsInfo segmentsInfo = this->_segmentsInfo.at(this->_offsets.at(key).segmentsInfoOffset);
 
                 CharacterPushConstants pushConstants{
-                    character.getModelMatrix(),           this->_textBlocks.at(i)->getColor(),
-                    segmentsInfo.lineSegmentsStartIndex,  segmentsInfo.lineSegmentsCount,
-                    segmentsInfo.curveSegmentsStartIndex, segmentsInfo.curveSegmentsCount};
+                    character.getModelMatrix(), this->_textBlocks.at(i)->getColor(), segmentsInfo.bandsStartIndex,
+                    segmentsInfo.bandCount,     segmentsInfo.bandsBottom,            segmentsInfo.bandsTop};
                 vkCmdPushConstants(this->_commandBuffer, this->_segmentsPipelineLayout,
                                    VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, 0,
                                    sizeof(CharacterPushConstants), &pushConstants);
@@ -111,6 +112,7 @@ void VulkanWindingNumberTextRenderer::update() {
         return;
     }
 
+    this->_destroyBuffer(this->_bandsBuffer, this->_bandsBufferMemory);
     this->_destroyBuffer(this->_segmentsBuffer, this->_segmentsBufferMemory);
     this->_destroyBuffer(this->_boundingBoxIndexBuffer, this->_boundingBoxIndexBufferMemory);
     this->_destroyBuffer(this->_vertexBuffer, this->_vertexBufferMemory);
@@ -144,7 +146,7 @@ void VulkanWindingNumberTextRenderer::_createDescriptorPool() {
     poolSizes[0].descriptorCount = static_cast<uint32_t>(1);
 
     poolSizes[1].type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
-    poolSizes[1].descriptorCount = static_cast<uint32_t>(1);
+    poolSizes[1].descriptorCount = static_cast<uint32_t>(2);
 
     VkDescriptorPoolCreateInfo poolCreateInfo{};
     poolCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
@@ -163,13 +165,18 @@ void VulkanWindingNumberTextRenderer::_createDescriptorPool() {
  * @brief Create vulkan ssbo descriptor set layout
  */
 void VulkanWindingNumberTextRenderer::_createSegmentsDescriptorSetLayout() {
-    std::array<VkDescriptorSetLayoutBinding, 1> layoutBindings;
+    std::array<VkDescriptorSetLayoutBinding, 2> layoutBindings{};
 
     layoutBindings[0].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
     layoutBindings[0].binding = 0;
     layoutBindings[0].descriptorCount = 1;
     layoutBindings[0].stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
 
+    layoutBindings[1].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    layoutBindings[1].binding = 1;
+    layoutBindings[1].descriptorCount = 1;
+    layoutBindings[1].stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
+
     VkDescriptorSetLayoutCreateInfo layoutCreateInfo{};
     layoutCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
     layoutCreateInfo.bindingCount = layoutBindings.size();
@@ -200,7 +207,7 @@ void VulkanWindingNumberTextRenderer::_createSegmentsDescriptorSet() {
 }
 
 /**
- * @brief Create vulkan ssbo containing line and curve segments of all glyphs
+ * @brief Create vulkan ssbos containing line and curve segments of all glyphs and their horizontal bands
  */
 void VulkanWindingNumberTextRenderer::_createSsbo() {
     VkDeviceSize segmentsBufferSize = sizeof(this->_segments.at(0)) * this->_segments.size();
@@ -212,7 +219,16 @@ void VulkanWindingNumberTextRenderer::_createSsbo() {
     lineSegmentsBufferInfo.offset = 0;
     lineSegmentsBufferInfo.range = segmentsBufferSize;
 
-    std::array<VkWriteDescriptorSet, 1> writeDescriptorSets = {};
+    VkDeviceSize bandsBufferSize = sizeof(this->_bands.at(0)) * this->_bands.size();
+    this->_stageAndCreateVulkanBuffer(this->_bands.data(), bandsBufferSize, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+                                      this->_bandsBuffer, this->_bandsBufferMemory);
+
+    VkDescriptorBufferInfo bandsBufferInfo{};
+    bandsBufferInfo.buffer = this->_bandsBuffer;
+    bandsBufferInfo.offset = 0;
+    bandsBufferInfo.range = bandsBufferSize;
+
+    std::array<VkWriteDescriptorSet, 2> writeDescriptorSets = {};
 
     writeDescriptorSets[0].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
     writeDescriptorSets[0].dstSet = this->_segmentsDescriptorSet;
@@ -222,6 +238,14 @@ void VulkanWindingNumberTextRenderer::_createSsbo() {
     writeDescriptorSets[0].descriptorCount = 1;
     writeDescriptorSets[0].pBufferInfo = &lineSegmentsBufferInfo;
 
+    writeDescriptorSets[1].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    writeDescriptorSets[1].dstSet = this->_segmentsDescriptorSet;
+    writeDescriptorSets[1].dstBinding = 1;
+    writeDescriptorSets[1].dstArrayElement = 0;
+    writeDescriptorSets[1].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    writeDescriptorSets[1].descriptorCount = 1;
+    writeDescriptorSets[1].pBufferInfo = &bandsBufferInfo;
+
     vkUpdateDescriptorSets(this->_logicalDevice, writeDescriptorSets.size(), writeDescriptorSets.data(), 0, nullptr);
 }
 
@@ -19,13 +19,17 @@ WindingNumberTessellator::WindingNumberTessellator() {}
  * @param font Font of glyph
  * @param fontSize Font size of glyph
  */
-Glyph WindingNumberTessellator::composeGlyph(uint32_t glyphId, std::shared_ptr<vft::Font> font, unsigned int fontSize) {
+Glyph WindingNumberTessellator::composeGlyph(uint32_t glyphId,
+                                             std::shared_ptr<vft::Font> font,
+                                             unsigned int fontSize) const {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    Context context{};
+
     GlyphKey key{font->getFontFamily(), glyphId, 0};
-    Glyph glyph = this->_composeGlyph(glyphId, font);
+    Glyph glyph = this->_composeGlyph(glyphId, font, context);
 
-    std::vector<glm::vec2> vertices = glyph.mesh.getVertices();
-    std::vector<Edge> lineSegments = glyph.getLineSegmentsIndices();
-    std::vector<Curve> curveSegments = glyph.getCurveSegmentsIndices();
+    std::vector<glm::vec2> vertices = std::move(context.vertices);
 
     // Create bounding box indices that form two triangles
     uint32_t newVertexIndex = vertices.size();
@@ -41,23 +45,132 @@ Glyph WindingNumberTessellator::composeGlyph(uint32_t glyphId, std::shared_ptr<v
 
     // Create line segments index buffer
     std::vector<uint32_t> lineIndices;
-    for (Edge edge : lineSegments) {
+    for (Edge edge : context.lineSegments) {
         lineIndices.push_back(edge.first);
         lineIndices.push_back(edge.second);
     }
 
     // Create curve segments index buffer
     std::vector<uint32_t> curveIndices;
-    for (Curve curve : curveSegments) {
+    for (Curve curve : context.curveSegments) {
         curveIndices.push_back(curve.start);
         curveIndices.push_back(curve.control);
         curveIndices.push_back(curve.end);
     }
 
-    GlyphMesh mesh{vertices, {boundingBoxIndices, curveIndices, lineIndices}};
-    glyph.mesh = mesh;
+    // Group segments into horizontal bands, so fragments test only segments overlapping their band
+    std::vector<uint32_t> bandIndices = WindingNumberTessellator::createBands(
+        vertices, lineIndices, curveIndices, boundingBoxVertices[0].y, boundingBoxVertices[1].y);
+
+    glyph.mesh = GlyphMesh{vertices, {boundingBoxIndices, curveIndices, lineIndices, bandIndices}};
+
+    this->_recordStats(start, glyph, context.lineSegments.size() + context.curveSegments.size());
 
     return glyph;
 }
 
+/**
+ * @brief Get algorithm used by this tessellator
+ *
+ * @return Tessellation strategy
+ */
+TessellationStrategy WindingNumberTessellator::getStrategy() const {
+    return TessellationStrategy::WINDING_NUMBER;
+}
+
+/**
+ * @brief Create a new tessellator of the same type, which records statistics together with this tessellator
+ *
+ * @return New tessellator
+ */
+std::unique_ptr<Tessellator> WindingNumberTessellator::clone() const {
+    std::unique_ptr<Tessellator> tessellator = std::make_unique<WindingNumberTessellator>();
+    this->_shareStats(*tessellator);
+
+    return tessellator;
+}
+
+/**
+ * @brief Group line and curve segments into horizontal bands evenly dividing the glyph's bounding box. Every band lists
+ * segments whose vertical extent overlaps it, sorted by max x in descending order, so a ray cast in the direction of x
+ * axis can stop at the first segment that lies completely on its left
+ *
+ * @param vertices Vertices of glyph
+ * @param lineIndices Pairs of indices of line segment vertices
+ * @param curveIndices Triplets of indices of curve segment vertices
+ * @param bottom Bottom of glyph's bounding box
+ * @param top Top of glyph's bounding box
+ *
+ * @return Band buffer in the layout described by GLYPH_MESH_BAND_BUFFER_INDEX
+ */
+std::vector<uint32_t> WindingNumberTessellator::createBands(const std::vector<glm::vec2> &vertices,
+                                                            const std::vector<uint32_t> &lineIndices,
+                                                            const std::vector<uint32_t> &curveIndices,
+                                                            float bottom,
+                                                            float top) {
+    // Vertical extent and max x of every segment, line segments precede curve segments
+    std::vector<glm::vec3> extents;
+    extents.reserve(lineIndices.size() / 2 + curveIndices.size() / 3);
+    for (unsigned int i = 0; i + 1 < lineIndices.size(); i += 2) {
+        const glm::vec2 &start = vertices.at(lineIndices[i]);
+        const glm::vec2 &end = vertices.at(lineIndices[i + 1]);
+        extents.push_back(glm::vec3{std::min(start.y, end.y), std::max(start.y, end.y), std::max(start.x, end.x)});
+    }
+    for (unsigned int i = 0; i + 2 < curveIndices.size(); i += 3) {
+        // Curve lies in the convex hull of its control points
+        const glm::vec2 &start = vertices.at(curveIndices[i]);
+        const glm::vec2 &control = vertices.at(curveIndices[i + 1]);
+        const glm::vec2 &end = vertices.at(curveIndices[i + 2]);
+        extents.push_back(glm::vec3{std::min({start.y, control.y, end.y}), std::max({start.y, control.y, end.y}),
+                                    std::max({start.x, control.x, end.x})});
+    }
+
+    if (extents.empty()) {
+        return {};
+    }
+
+    unsigned int bandCount = std::min<std::size_t>(WindingNumberTessellator::MAX_BAND_COUNT, extents.size());
+    std::vector<std::vector<uint32_t>> bands(bandCount);
+    for (uint32_t i = 0; i < extents.size(); i++) {
+        // Extent is widened by one font unit to absorb rounding differences between the cpu and the shader
+        unsigned int first = WindingNumberTessellator::getBand(extents[i].x - 1, bottom, top, bandCount);
+        unsigned int last = WindingNumberTessellator::getBand(extents[i].y + 1, bottom, top, bandCount);
+        for (unsigned int band = first; band <= last; band++) {
+            bands[band].push_back(i);
+        }
+    }
+
+    std::vector<uint32_t> bandIndices;
+    bandIndices.push_back(bandCount);
+    for (std::vector<uint32_t> &band : bands) {
+        std::stable_sort(band.begin(), band.end(),
+                         [&extents](uint32_t first, uint32_t second) { return extents[first].z > extents[second].z; });
+
+        bandIndices.push_back(band.size());
+        bandIndices.insert(bandIndices.end(), band.begin(), band.end());
+    }
+
+    return bandIndices;
+}
+
+/**
+ * @brief Get horizontal band containing given y coordinate, coordinates outside of the bounding box belong to the
+ * nearest band. Must match the band selection in winding_number.frag
+ *
+ * @param y Y coordinate
+ * @param bottom Bottom of glyph's bounding box
+ * @param top Top of glyph's bounding box
+ * @param bandCount Number of bands
+ *
+ * @return Index of band
+ */
+unsigned int WindingNumberTessellator::getBand(float y, float bottom, float top, unsigned int bandCount) {
+    if (top <= bottom || bandCount == 0) {
+        return 0;
+    }
+
+    float band = std::floor((y - bottom) / (top - bottom) * bandCount);
+    return static_cast<unsigned int>(std::clamp(band, 0.f, static_cast<float>(bandCount - 1)));
+}
+
 }  // namespace vft
@@ -11,17 +11,20 @@ namespace vft {
  * @brief Initialize winding number text renderer
  */
 WindingNumberTextRenderer::WindingNumberTextRenderer() {
-    this->_tessellator = std::make_unique<WindingNumberTessellator>();
+    this->_tessellator = std::make_shared<WindingNumberTessellator>();
 }
 
 /**
  * @brief Recreates vertex, index and segment buffers for all characters in text block
  */
 void WindingNumberTextRenderer::update() {
+    this->_resetCompositionBudget();
+
     this->_vertices.clear();
     this->_boundingBoxIndices.clear();
     this->_segments.clear();
     this->_segmentsInfo.clear();
+    this->_bands.clear();
     this->_offsets.clear();
 
     uint32_t vertexCount = 0;
@@ -31,37 +34,29 @@ void WindingNumberTextRenderer::update() {
 
     for (unsigned int i = 0; i < this->_textBlocks.size(); i++) {
         for (const Character &character : this->_textBlocks[i]->getCharacters()) {
-            GlyphKey key{character.getFont()->getFontFamily(), character.getGlyphId(), 0};
+            GlyphKey key = this->_getGlyphKey(character);
 
             if (!this->_offsets.contains(key)) {
-                // Insert glyph into cache
-                if (!this->_cache->exists(key)) {
-                    this->_cache->setGlyph(key,
-                                           this->_tessellator->composeGlyph(character.getGlyphId(), character.getFont(),
-                                                                            character.getFontSize()));
-                }
+                // Get glyph from cache, compose it if it is missing
+                std::shared_ptr<const Glyph> glyph = this->_getGlyph(key, character);
 
                 // Compute buffer offsets
-                const Glyph &glyph = this->_cache->getGlyph(key);
                 this->_offsets.insert(
-                    {key,
-                     GlyphInfo{boundingBoxIndexCount,
-                               glyph.mesh.getIndexCount(WindingNumberTessellator::GLYPH_MESH_BOUNDING_BOX_BUFFER_INDEX),
-                               segmentsInfoCount}});
-
-                // Create vertex buffer
-                this->_vertices.insert(this->_vertices.end(), glyph.mesh.getVertices().begin(),
-                                       glyph.mesh.getVertices().end());
-                this->_boundingBoxIndices.insert(
-                    this->_boundingBoxIndices.end(),
-                    glyph.mesh.getIndices(WindingNumberTessellator::GLYPH_MESH_BOUNDING_BOX_BUFFER_INDEX).begin(),
-                    glyph.mesh.getIndices(WindingNumberTessellator::GLYPH_MESH_BOUNDING_BOX_BUFFER_INDEX).end());
+                    {key, GlyphInfo{boundingBoxIndexCount,
+                                    glyph->mesh.getIndexCount(
+                                        WindingNumberTessellator::GLYPH_MESH_BOUNDING_BOX_BUFFER_INDEX),
+                                    segmentsInfoCount}});
+
+                // Create vertex buffer, offset bounding box indices by vertices of previous glyphs
+                std::vector<glm::vec2> vertices = glyph->mesh.getVertices();
+                this->_vertices.insert(this->_vertices.end(), vertices.begin(), vertices.end());
+                glyph->mesh.appendIndices(WindingNumberTessellator::GLYPH_MESH_BOUNDING_BOX_BUFFER_INDEX,
+                                          this->_boundingBoxIndices, vertexCount);
 
                 // Create line and curve segments buffer
-                std::vector<glm::vec2> vertices = glyph.mesh.getVertices();
 
                 std::vector<uint32_t> lineSegments =
-                    glyph.mesh.getIndices(WindingNumberTessellator::GLYPH_MESH_LINE_BUFFER_INDEX);
+                    glyph->mesh.getIndices(WindingNumberTessellator::GLYPH_MESH_LINE_BUFFER_INDEX);
                 uint32_t lineCount = lineSegments.size() / 2;
                 for (int j = 0; j < lineSegments.size(); j += 2) {
                     this->_segments.push_back(vertices.at(lineSegments.at(j)));
@@ -69,7 +64,7 @@ void WindingNumberTextRenderer::update() {
                 }
 
                 std::vector<uint32_t> curveSegments =
-                    glyph.mesh.getIndices(WindingNumberTessellator::GLYPH_MESH_CURVE_BUFFER_INDEX);
+                    glyph->mesh.getIndices(WindingNumberTessellator::GLYPH_MESH_CURVE_BUFFER_INDEX);
                 uint32_t curveCount = curveSegments.size() / 3;
                 for (int j = 0; j < curveSegments.size(); j += 3) {
                     this->_segments.push_back(vertices.at(curveSegments.at(j)));
@@ -77,17 +72,25 @@ void WindingNumberTextRenderer::update() {
                     this->_segments.push_back(vertices.at(curveSegments.at(j + 2)));
                 }
 
-                this->_segmentsInfo.push_back(SegmentsInfo{
-                    segmentsCount, lineCount, segmentsCount + static_cast<uint32_t>(lineSegments.size()), curveCount});
-
-                // Add an offset to bounding box indices of current character
-                for (int j = boundingBoxIndexCount; j < this->_boundingBoxIndices.size(); j++) {
-                    this->_boundingBoxIndices.at(j) += vertexCount;
-                }
-
-                vertexCount += glyph.mesh.getVertexCount();
+                // Create band buffer, bands are missing in meshes stored by older versions of the tessellator
+                std::array<glm::vec2, 4> boundingBox = glyph->getBoundingBox();
+                std::vector<uint32_t> bands =
+                    glyph->mesh.getDrawCount() > WindingNumberTessellator::GLYPH_MESH_BAND_BUFFER_INDEX
+                        ? glyph->mesh.getIndices(WindingNumberTessellator::GLYPH_MESH_BAND_BUFFER_INDEX)
+                        : WindingNumberTessellator::createBands(vertices, lineSegments, curveSegments,
+                                                                boundingBox[0].y, boundingBox[1].y);
+                uint32_t bandsStartIndex = this->_bands.size();
+                uint32_t bandCount = bands.empty() ? 0 : bands.at(0);
+                this->_appendBands(bands, segmentsCount, lineCount);
+
+                this->_segmentsInfo.push_back(SegmentsInfo{segmentsCount, lineCount,
+                                                           segmentsCount + static_cast<uint32_t>(lineSegments.size()),
+                                                           curveCount, bandsStartIndex, bandCount, boundingBox[0].y,
+                                                           boundingBox[1].y});
+
+                vertexCount += glyph->mesh.getVertexCount();
                 boundingBoxIndexCount +=
-                    glyph.mesh.getIndexCount(WindingNumberTessellator::GLYPH_MESH_BOUNDING_BOX_BUFFER_INDEX);
+                    glyph->mesh.getIndexCount(WindingNumberTessellator::GLYPH_MESH_BOUNDING_BOX_BUFFER_INDEX);
                 segmentsCount += lineSegments.size() + curveSegments.size();
                 segmentsInfoCount++;
             }
@@ -95,4 +98,40 @@ void WindingNumberTextRenderer::update() {
     }
 }
 
+/**
+ * @brief Append glyph's bands to the band buffer, segment indices of the glyph are replaced by positions of segments in
+ * the segments buffer
+ *
+ * @param bands Glyph's bands in the layout described by WindingNumberTessellator::GLYPH_MESH_BAND_BUFFER_INDEX
+ * @param segmentsStartIndex Index into the segments buffer where glyph's line segments start
+ * @param lineCount Number of glyph's line segments, curve segments follow them
+ */
+void WindingNumberTextRenderer::_appendBands(const std::vector<uint32_t> &bands,
+                                             uint32_t segmentsStartIndex,
+                                             uint32_t lineCount) {
+    if (bands.empty()) {
+        return;
+    }
+
+    uint32_t bandCount = bands.at(0);
+    uint32_t headerStartIndex = this->_bands.size();
+    this->_bands.resize(this->_bands.size() + 2 * bandCount);
+
+    uint32_t i = 1;
+    for (uint32_t band = 0; band < bandCount; band++) {
+        uint32_t segmentCount = bands.at(i++);
+        this->_bands[headerStartIndex + 2 * band] = this->_bands.size();
+        this->_bands[headerStartIndex + 2 * band + 1] = segmentCount;
+
+        for (uint32_t j = 0; j < segmentCount; j++) {
+            uint32_t segment = bands.at(i++);
+            if (segment < lineCount) {
+                this->_bands.push_back((segmentsStartIndex + 2 * segment) << 1);
+            } else {
+                this->_bands.push_back(((segmentsStartIndex + 2 * lineCount + 3 * (segment - lineCount)) << 1) | 1);
+            }
+        }
+    }
+}
+
 }  // namespace vft
@@ -0,0 +1,289 @@
+/**
+ * @file main.cpp
+ * @author Christian Saloň
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <VFONT/font.h>
+#include <VFONT/font_size_bucketing.h>
+#include <VFONT/glyph_pack.h>
+#include <VFONT/loop_blinn_tessellator.h>
+#include <VFONT/sdf_tessellator.h>
+#include <VFONT/shaper.h>
+#include <VFONT/tessellation_shaders_tessellator.h>
+#include <VFONT/tessellator.h>
+#include <VFONT/triangulation_tessellator.h>
+#include <VFONT/unicode.h>
+#include <VFONT/winding_number_tessellator.h>
+
+/**
+ * @brief Create tessellator implementing selected algorithm
+ *
+ * @param strategy Tessellation algorithm
+ *
+ * @return Tessellator
+ */
+std::unique_ptr<vft::Tessellator> createTessellator(vft::TessellationStrategy strategy) {
+    switch (strategy) {
+        case vft::TessellationStrategy::TRIANGULATION:
+            return std::make_unique<vft::TriangulationTessellator>();
+        case vft::TessellationStrategy::TESSELLATION_SHADERS:
+            return std::make_unique<vft::TessellationShadersTessellator>();
+        case vft::TessellationStrategy::WINDING_NUMBER:
+            return std::make_unique<vft::WindingNumberTessellator>();
+        case vft::TessellationStrategy::LOOP_BLINN:
+            return std::make_unique<vft::LoopBlinnTessellator>();
+        case vft::TessellationStrategy::SDF:
+            return std::make_unique<vft::SdfTessellator>();
+    }
+
+    throw std::runtime_error("createTessellator(): Unsupported tessellation algorithm");
+}
+
+/**
+ * @brief Parse comma separated list of numbers, ranges are written as start-end (e.g. "32-126,160-255")
+ *
+ * @param input List of numbers and ranges
+ *
+ * @return Pairs of first and last number of each range
+ */
+std::vector<std::pair<uint32_t, uint32_t>> parseRanges(const std::string &input) {
+    std::vector<std::pair<uint32_t, uint32_t>> ranges;
+    std::stringstream stream{input};
+    std::string item;
+
+    while (std::getline(stream, item, ',')) {
+        std::size_t separator = item.find('-');
+        uint32_t start = std::stoul(item.substr(0, separator), nullptr, 0);
+        uint32_t end = separator == std::string::npos ? start : std::stoul(item.substr(separator + 1), nullptr, 0);
+
+        if (end < start) {
+            throw std::runtime_error("Invalid range " + item);
+        }
+
+        ranges.push_back({start, end});
+    }
+
+    return ranges;
+}
+
+int main(int argc, char **argv) {
+    try {
+        std::string fontFile;
+        std::string outputFile;
+        std::string corpusFile;
+        std::string ranges;
+        std::string fontSizes;
+        double bucketRatio = 1;
+        bool useLevelsOfDetail = false;
+        vft::TessellationStrategy tessellationAlgorithm = vft::TessellationStrategy::TRIANGULATION;
+        unsigned int threadCount = std::max(std::thread::hardware_concurrency(), 1u);
+
+        for (int i = 1; i < argc; i++) {
+            if (strcmp(argv[i], "-h") == 0) {
+                // Show help message
+                std::cout << "./vfont-bake [-h] -f <font file> -o <pack file> [-a <cdt/ts/wn/lb/sdf>] "
+                             "[-s <font sizes>] [-b <bucket ratio>] [-l] [-r <ranges>] [-c <corpus file>] "
+                             "[-j <threads>]"
+                          << std::endl;
+                std::cout << "-h: Show help message" << std::endl;
+                std::cout << "-f: Font file to bake" << std::endl;
+                std::cout << "-o: Output glyph pack file" << std::endl;
+                std::cout << "-a: Select the rendering algorithm, glyphs are composed for this algorithm" << std::endl;
+                std::cout << "  cdt - Constrained delaunay triangulation on the cpu" << std::endl;
+                std::cout << "  ts - Outer triangles processed by tessellation shaders, inner triangulated on the cpu"
+                          << std::endl;
+                std::cout << "  wn - Winding number calculated in fragment shader" << std::endl;
+                std::cout << "  lb - Curve triangles filled in fragment shader, inner triangulated on the cpu"
+                          << std::endl;
+                std::cout << "  sdf - Signed distance field" << std::endl;
+                std::cout << "-s: Comma separated font sizes, required by cdt (e.g. 12,16,24-32)" << std::endl;
+                std::cout << "-b: Ratio of font size buckets of cdt renderer, must match its font size bucketing "
+                             "(e.g. 1.4142135623730951), default 1 disables bucketing"
+                          << std::endl;
+                std::cout << "-l: Compose cdt glyphs with levels of detail, for renderers with levels of detail enabled"
+                          << std::endl;
+                std::cout << "-r: Comma separated unicode code point ranges (e.g. 0x20-0x7e,0xa0-0xff)" << std::endl;
+                std::cout << "-c: Utf-8 encoded text file, all glyphs used by the text are baked" << std::endl;
+                std::cout << "-j: Number of threads used to compose glyphs" << std::endl;
+                std::cout << "All glyphs of font are baked if neither -r nor -c is given" << std::endl;
+                return EXIT_SUCCESS;
+            } else if (strcmp(argv[i], "-l") == 0) {
+                useLevelsOfDetail = true;
+            } else if (i + 1 >= argc) {
+                std::cerr << "Missing value of argument at position " << i << std::endl;
+                return EXIT_FAILURE;
+            } else if (strcmp(argv[i], "-f") == 0) {
+                fontFile = argv[++i];
+            } else if (strcmp(argv[i], "-o") == 0) {
+                outputFile = argv[++i];
+            } else if (strcmp(argv[i], "-a") == 0) {
+                // Set tessellation algorithm
+                std::string type = argv[++i];
+
+                if (type == "cdt") {
+                    tessellationAlgorithm = vft::TessellationStrategy::TRIANGULATION;
+                } else if (type == "wn") {
+                    tessellationAlgorithm = vft::TessellationStrategy::WINDING_NUMBER;
+                } else if (type == "lb") {
+                    tessellationAlgorithm = vft::TessellationStrategy::LOOP_BLINN;
+                } else if (type == "ts") {
+                    tessellationAlgorithm = vft::TessellationStrategy::TESSELLATION_SHADERS;
+                } else if (type == "sdf") {
+                    tessellationAlgorithm = vft::TessellationStrategy::SDF;
+                } else {
+                    std::cerr << "Tessellation algorithm must be cdt, ts, wn, lb or sdf" << std::endl;
+                    return EXIT_FAILURE;
+                }
+            } else if (strcmp(argv[i], "-s") == 0) {
+                fontSizes = argv[++i];
+            } else if (strcmp(argv[i], "-b") == 0) {
+                bucketRatio = std::stod(argv[++i]);
+            } else if (strcmp(argv[i], "-r") == 0) {
+                ranges = argv[++i];
+            } else if (strcmp(argv[i], "-c") == 0) {
+                corpusFile = argv[++i];
+            } else if (strcmp(argv[i], "-j") == 0) {
+                threadCount = std::max(static_cast<unsigned int>(std::stoul(argv[++i])), 1u);
+            } else {
+                std::cerr << "Invalid argument at position " << i << std::endl;
+                return EXIT_FAILURE;
+            }
+        }
+
+        if (fontFile.empty() || outputFile.empty()) {
+            std::cerr << "Font file and output file must be specified, use -h for help" << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        if (useLevelsOfDetail && tessellationAlgorithm != vft::TessellationStrategy::TRIANGULATION) {
+            std::cerr << "Levels of detail are only composed by cdt, use -h for help" << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        // Only triangulated glyphs depend on font size, other algorithms store glyphs with font size 0
+        std::set<unsigned int> sizes{0};
+        if (tessellationAlgorithm == vft::TessellationStrategy::TRIANGULATION) {
+            if (fontSizes.empty()) {
+                std::cerr << "Font sizes must be specified for cdt, use -h for help" << std::endl;
+                return EXIT_FAILURE;
+            }
+
+            // Renderer looks glyphs up by the upper bound of the font size's bucket, sizes in one bucket share a glyph
+            vft::FontSizeBucketing bucketing{bucketRatio};
+
+            sizes.clear();
+            for (auto [start, end] : parseRanges(fontSizes)) {
+                for (uint32_t size = start; size <= end; size++) {
+                    sizes.insert(bucketing.getBucketFontSize(size));
+                }
+            }
+        }
+
+        std::shared_ptr<vft::Font> font = std::make_shared<vft::Font>(fontFile);
+        FT_Face face = font->getThreadFace();
+
+        // Collect glyph ids to bake
+        std::set<uint32_t> glyphIds;
+        if (ranges.empty() && corpusFile.empty()) {
+            for (uint32_t glyphId = 0; glyphId < static_cast<uint32_t>(face->num_glyphs); glyphId++) {
+                glyphIds.insert(glyphId);
+            }
+        }
+
+        if (!ranges.empty()) {
+            for (auto [start, end] : parseRanges(ranges)) {
+                for (uint32_t codePoint = start; codePoint <= end; codePoint++) {
+                    uint32_t glyphId = FT_Get_Char_Index(face, codePoint);
+                    if (glyphId != 0) {
+                        glyphIds.insert(glyphId);
+                    }
+                }
+            }
+        }
+
+        if (!corpusFile.empty()) {
+            std::ifstream file{corpusFile, std::ios::binary};
+            if (!file.is_open()) {
+                std::cerr << "Error opening corpus file " << corpusFile << std::endl;
+                return EXIT_FAILURE;
+            }
+
+            std::string content{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+            std::u32string text = vft::Unicode::utf8ToUtf32(std::u8string{content.begin(), content.end()});
+
+            // Shaping finds glyphs that are not mapped to a single code point (e.g. ligatures)
+            for (const std::vector<vft::ShapedCharacter> &line : vft::Shaper::shape(text, font, 64)) {
+                for (const vft::ShapedCharacter &character : line) {
+                    glyphIds.insert(character.glyphId);
+                }
+            }
+        }
+
+        // Compose glyphs in parallel, tessellator is reentrant so all threads share it
+        struct Job {
+            uint32_t glyphId;
+            unsigned int fontSize;
+        };
+
+        std::vector<Job> jobs;
+        for (unsigned int size : sizes) {
+            for (uint32_t glyphId : glyphIds) {
+                jobs.push_back(Job{glyphId, size});
+            }
+        }
+
+        std::unique_ptr<vft::Tessellator> tessellator = createTessellator(tessellationAlgorithm);
+        if (useLevelsOfDetail) {
+            static_cast<vft::TriangulationTessellator &>(*tessellator).setLevelsOfDetailEnabled(true);
+        }
+
+        // Pack stores the variant, so it is rejected by renderers composing glyphs with other settings
+        vft::GlyphPack pack{font->getContentHash(), tessellationAlgorithm, tessellator->getVariant()};
+        std::atomic<std::size_t> nextJob{0};
+        std::atomic<std::size_t> failedJobs{0};
+
+        std::vector<std::thread> threads;
+        for (unsigned int i = 0; i < std::min<std::size_t>(threadCount, jobs.size()); i++) {
+            threads.emplace_back([&]() {
+                for (std::size_t j = nextJob++; j < jobs.size(); j = nextJob++) {
+                    try {
+                        vft::Glyph glyph = tessellator->composeGlyph(jobs[j].glyphId, font, jobs[j].fontSize);
+                        pack.addGlyph(jobs[j].glyphId, jobs[j].fontSize, glyph);
+                    } catch (const std::exception &e) {
+                        failedJobs++;
+                    }
+                }
+            });
+        }
+
+        for (std::thread &thread : threads) {
+            thread.join();
+        }
+
+        pack.save(outputFile);
+
+        std::cout << "Baked " << pack.getGlyphCount() << " glyphs into " << outputFile << std::endl;
+        if (failedJobs > 0) {
+            std::cerr << failedJobs << " glyphs could not be composed" << std::endl;
+        }
+    } catch (const std::exception &e) {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}